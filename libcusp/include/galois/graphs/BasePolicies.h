@@ -27,6 +27,8 @@
 #ifndef _GALOIS_CUSP_PSCAFFOLD_H_
 #define _GALOIS_CUSP_PSCAFFOLD_H_
 
+#include "galois/runtime/Serialize.h"
+
 namespace galois {
 namespace graphs {
 
@@ -65,6 +67,18 @@ public:
   void saveGIDToHost(std::vector<std::pair<uint64_t, uint64_t>>& gid2host) {
     _gid2host = gid2host;
   }
+
+  /**
+   * Serializes the state needed to answer master queries after partitioning,
+   * apart from gid2host; used to save a partition to disk. The base
+   * scaffold has none.
+   */
+  void serializeState(galois::runtime::SerializeBuffer&) const {}
+
+  /**
+   * Restores state saved by serializeState.
+   */
+  void deserializeState(galois::runtime::DeSerializeBuffer&) {}
 };
 
 /**
@@ -270,6 +284,28 @@ public:
   //! Shifts master assignment phase to stage 2.
   void enterStage2() { _status = 2; }
 
+  /**
+   * Serializes the master assignment of nodes read by this host and of the
+   * other nodes this host knows about.
+   */
+  void serializeState(galois::runtime::SerializeBuffer& b) const {
+    std::vector<std::pair<uint64_t, uint32_t>> gid2masters(
+        _gid2masters.begin(), _gid2masters.end());
+    galois::runtime::gSerialize(b, _status, _nodeOffset, _localNodeToMaster,
+                                gid2masters);
+  }
+
+  /**
+   * Restores the master assignment saved by serializeState.
+   */
+  void deserializeState(galois::runtime::DeSerializeBuffer& b) {
+    std::vector<std::pair<uint64_t, uint32_t>> gid2masters;
+    galois::runtime::gDeserialize(b, _status, _nodeOffset, _localNodeToMaster,
+                                  gid2masters);
+    _gid2masters.clear();
+    _gid2masters.insert(gid2masters.begin(), gid2masters.end());
+  }
+
   /**
    * CuSP's "getMaster" function.
    * This function should be defined by user in child class to assign a node to
@@ -33,6 +33,7 @@
 #include "galois/graphs/LC_CSR_Graph.h"
 #include "galois/graphs/BufferedGraph.h"
 #include "galois/runtime/DistStats.h"
+#include "galois/runtime/Serialize.h"
 #include "galois/graphs/OfflineGraph.h"
 #include "galois/DynamicBitset.h"
 
@@ -252,7 +253,7 @@ private:
       if (h == id) {
         continue;
       }
-      galois::runtime::SendBuffer b;
+      galois::runtime::SerializeBuffer b;
       for (unsigned d = 0; d < DecomposeFactor; ++d) {
         galois::runtime::gSerialize(b, gid2host[id + d * numHosts]);
       }
@@ -324,7 +325,7 @@ private:
     for (unsigned h = 0; h < numHosts; ++h) {
       if (h == id)
         continue;
-      galois::runtime::SendBuffer b;
+      galois::runtime::SerializeBuffer b;
       galois::runtime::gSerialize(b, gid2host[id]);
       net.sendTagged(h, galois::runtime::evilPhase, b);
     }
@@ -441,7 +442,7 @@ protected:
     for (unsigned h = 0; h < numHosts; ++h) {
       if (h == id)
         continue;
-      galois::runtime::SendBuffer b;
+      galois::runtime::SerializeBuffer b;
       galois::runtime::gSerialize(b, gid2host[id]);
       net.sendTagged(h, galois::runtime::evilPhase, b);
     }
@@ -845,21 +846,243 @@ protected:
    */
   void edgesEqualMasters() { specificRanges[2] = specificRanges[1]; }
 
+private:
+  //! Identifies local graph files; bump the version when the layout changes
+  constexpr static uint64_t LOCAL_GRAPH_MAGIC   = 0x4847434f4c534c47;
+  constexpr static uint64_t LOCAL_GRAPH_VERSION = 1;
+  //! Size of the edge data saved with the local graph (0 for void)
+  constexpr static size_t EdgeDataSize =
+      std::is_void<EdgeTy>::value
+          ? 0
+          : sizeof(std::conditional_t<std::is_void<EdgeTy>::value, char,
+                                      EdgeTy>);
+  //! Elements moved through the staging buffer at a time
+  constexpr static size_t LOCAL_GRAPH_CHUNK = size_t{1} << 20;
+
+  //! Fixed-size header of a local graph file
+  struct LocalGraphHeader {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t host;
+    uint64_t numHosts;
+    uint64_t numGlobalNodes;
+    uint64_t numGlobalEdges;
+    uint64_t numNodes;
+    uint64_t numEdges;
+    uint64_t numOwned;
+    uint64_t beginMaster;
+    uint64_t numNodesWithEdges;
+    uint64_t transposed;
+    uint64_t edgeDataSize;
+    //! size of the serialized metadata that follows the header
+    uint64_t metadataSize;
+  };
+
+  std::string localGraphFile(const std::string& prefix) const {
+    return prefix + "_" + std::to_string(id) + "_of_" +
+           std::to_string(numHosts);
+  }
+
+  /**
+   * Calls fn(begin, end, buffer) for consecutive chunks of [0, count), with
+   * buffer holding space for a chunk of T.
+   */
+  template <typename T, typename Fn>
+  static void forEachChunk(uint64_t count, Fn fn) {
+    std::vector<T> buffer(std::min<uint64_t>(count, LOCAL_GRAPH_CHUNK));
+    for (uint64_t b = 0; b < count; b += LOCAL_GRAPH_CHUNK) {
+      fn(b, std::min<uint64_t>(count, b + LOCAL_GRAPH_CHUNK), buffer.data());
+    }
+  }
+
+protected:
+  /**
+   * Serializes partitioner state that a partition read back from disk needs
+   * (e.g., to answer getHostID). Called while saving the local graph.
+   */
+  virtual void
+  serializePartitionerState(galois::runtime::SerializeBuffer&) const {}
+
+  /**
+   * Restores the state saved by serializePartitionerState. Called once the
+   * metadata of the graph (sizes, gid2host, mirrors) has been read.
+   */
+  virtual void
+  deserializePartitionerState(galois::runtime::DeSerializeBuffer&) {}
+
 public:
   /**
-   * Write the local LC_CSR graph to the file on a disk.
+   * Write the local LC_CSR graph to a file on disk so that a later run with
+   * the same number of hosts can skip partitioning. Each host writes
+   * <prefix>_<host>_of_<numHosts>: a header, the serialized metadata
+   * (gid2host, mirrors, partitioner state), then the local-to-global map,
+   * edge offsets, edge destinations and edge data as flat arrays.
    *
-   * @todo revive this
+   * @param prefix Prefix of the file name
    */
-  void save_local_graph_to_file(std::string) { GALOIS_DIE("not implemented"); }
+  void save_local_graph_to_file(std::string prefix) {
+    galois::StatTimer timer("SaveLocalGraph", GRNAME);
+    timer.start();
+
+    galois::runtime::SerializeBuffer metadata;
+    galois::runtime::gSerialize(metadata, gid2host, mirrorNodes);
+    serializePartitionerState(metadata);
+
+    LocalGraphHeader header{LOCAL_GRAPH_MAGIC,
+                            LOCAL_GRAPH_VERSION,
+                            id,
+                            numHosts,
+                            numGlobalNodes,
+                            numGlobalEdges,
+                            numNodes,
+                            numEdges,
+                            numOwned,
+                            beginMaster,
+                            numNodesWithEdges,
+                            transposed,
+                            EdgeDataSize,
+                            metadata.size()};
+
+    std::string fileName = localGraphFile(prefix);
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out.is_open()) {
+      GALOIS_DIE("failed to open ", fileName, " to save local graph");
+    }
+    galois::gPrint("[", id, "] Saving local graph to ", fileName, "\n");
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(metadata.linearData()),
+              metadata.size());
+    out.write(reinterpret_cast<const char*>(localToGlobalVector.data()),
+              numNodes * sizeof(uint64_t));
+
+    forEachChunk<uint64_t>(numNodes, [&](uint64_t b, uint64_t e, auto* buf) {
+      galois::do_all(
+          galois::iterate(b, e),
+          [&](uint64_t n) { buf[n - b] = *graph.edge_end(n); },
+          galois::no_stats());
+      out.write(reinterpret_cast<const char*>(buf), (e - b) * sizeof(*buf));
+    });
+    forEachChunk<uint32_t>(numEdges, [&](uint64_t b, uint64_t e, auto* buf) {
+      galois::do_all(
+          galois::iterate(b, e),
+          [&](uint64_t i) { buf[i - b] = graph.getEdgeDst(i); },
+          galois::no_stats());
+      out.write(reinterpret_cast<const char*>(buf), (e - b) * sizeof(*buf));
+    });
+    if constexpr (EdgeDataSize != 0) {
+      forEachChunk<EdgeTy>(numEdges, [&](uint64_t b, uint64_t e, auto* buf) {
+        galois::do_all(
+            galois::iterate(b, e),
+            [&](uint64_t i) { buf[i - b] = graph.getEdgeData(i); },
+            galois::no_stats());
+        out.write(reinterpret_cast<const char*>(buf), (e - b) * sizeof(*buf));
+      });
+    }
+
+    if (!out) {
+      GALOIS_DIE("failed to write local graph to ", fileName);
+    }
+    galois::runtime::reportStat_Single(GRNAME, "LocalGraphBytes",
+                                       static_cast<uint64_t>(out.tellp()));
+    timer.stop();
+  }
 
   /**
-   * Read the local LC_CSR graph from the file on a disk.
+   * Read the local LC_CSR graph written by save_local_graph_to_file and
+   * rebuild the maps and thread ranges derived from it.
    *
-   * @todo revive this
+   * @param prefix Prefix of the file name
    */
-  void read_local_graph_from_file(std::string) {
-    GALOIS_DIE("not implemented");
+  void read_local_graph_from_file(std::string prefix) {
+    galois::StatTimer timer("ReadLocalGraph", GRNAME);
+    timer.start();
+
+    std::string fileName = localGraphFile(prefix);
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.is_open()) {
+      GALOIS_DIE("failed to open ", fileName, " to read local graph");
+    }
+    galois::gPrint("[", id, "] Reading local graph from ", fileName, "\n");
+
+    LocalGraphHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != LOCAL_GRAPH_MAGIC ||
+        header.version != LOCAL_GRAPH_VERSION) {
+      GALOIS_DIE(fileName, " is not a local graph file of this version");
+    }
+    if (header.host != id || header.numHosts != numHosts) {
+      GALOIS_DIE(fileName, " was saved by host ", header.host, " of ",
+                 header.numHosts, "; this is host ", id, " of ", numHosts);
+    }
+    if (header.edgeDataSize != EdgeDataSize) {
+      GALOIS_DIE(fileName, " has edge data of ", header.edgeDataSize,
+                 " bytes; expected ", EdgeDataSize);
+    }
+
+    numGlobalNodes    = header.numGlobalNodes;
+    numGlobalEdges    = header.numGlobalEdges;
+    numNodes          = header.numNodes;
+    numEdges          = header.numEdges;
+    numOwned          = header.numOwned;
+    beginMaster       = header.beginMaster;
+    numNodesWithEdges = header.numNodesWithEdges;
+    transposed        = header.transposed;
+
+    galois::runtime::DeSerializeBuffer metadata(header.metadataSize);
+    in.read(reinterpret_cast<char*>(metadata.linearData()),
+            header.metadataSize);
+    gid2host.clear();
+    mirrorNodes.clear();
+    galois::runtime::gDeserialize(metadata, gid2host, mirrorNodes);
+    deserializePartitionerState(metadata);
+
+    localToGlobalVector.resize(numNodes);
+    in.read(reinterpret_cast<char*>(localToGlobalVector.data()),
+            numNodes * sizeof(uint64_t));
+    globalToLocalMap.clear();
+    globalToLocalMap.reserve(numNodes);
+    for (uint32_t n = 0; n < numNodes; ++n) {
+      globalToLocalMap[localToGlobalVector[n]] = n;
+    }
+
+    graph.allocateFrom(numNodes, numEdges);
+    graph.constructNodes();
+
+    forEachChunk<uint64_t>(numNodes, [&](uint64_t b, uint64_t e, auto* buf) {
+      in.read(reinterpret_cast<char*>(buf), (e - b) * sizeof(*buf));
+      galois::do_all(
+          galois::iterate(b, e),
+          [&](uint64_t n) { graph.fixEndEdge(n, buf[n - b]); },
+          galois::no_stats());
+    });
+    forEachChunk<uint32_t>(numEdges, [&](uint64_t b, uint64_t e, auto* buf) {
+      in.read(reinterpret_cast<char*>(buf), (e - b) * sizeof(*buf));
+      galois::do_all(
+          galois::iterate(b, e),
+          [&](uint64_t i) { graph.constructEdge(i, buf[i - b]); },
+          galois::no_stats());
+    });
+    if constexpr (EdgeDataSize != 0) {
+      forEachChunk<EdgeTy>(numEdges, [&](uint64_t b, uint64_t e, auto* buf) {
+        in.read(reinterpret_cast<char*>(buf), (e - b) * sizeof(*buf));
+        galois::do_all(
+            galois::iterate(b, e),
+            [&](uint64_t i) { graph.getEdgeData(i) = buf[i - b]; },
+            galois::no_stats());
+      });
+    }
+
+    if (!in) {
+      GALOIS_DIE("failed to read local graph from ", fileName);
+    }
+
+    determineThreadRanges();
+    determineThreadRangesMaster();
+    determineThreadRangesWithEdges();
+    initializeSpecificRanges();
+
+    timer.stop();
   }
 
   /**
@@ -107,6 +107,23 @@ private:
     return graphPartitioner->cartesianGrid();
   }
 
+protected:
+  virtual void
+  serializePartitionerState(galois::runtime::SerializeBuffer& b) const {
+    graphPartitioner->serializeState(b);
+  }
+
+  //! Recreates the partitioner for a graph read from disk; expects the
+  //! sizes and gid2host of the base graph to be restored already
+  virtual void
+  deserializePartitionerState(galois::runtime::DeSerializeBuffer& b) {
+    graphPartitioner = std::make_unique<Partitioner>(
+        base_DistGraph::id, base_DistGraph::numHosts,
+        base_DistGraph::numGlobalNodes, base_DistGraph::numGlobalEdges);
+    graphPartitioner->saveGIDToHost(base_DistGraph::gid2host);
+    graphPartitioner->deserializeState(b);
+  }
+
 public:
   /**
    * Reset load balance on host reducibles.
@@ -170,9 +187,6 @@ public:
     Tgraph_construct.start();
 
     if (readFromFile) {
-      galois::gPrint("[", base_DistGraph::id,
-                     "] Reading local graph from file ", localGraphFileName,
-                     "\n");
       base_DistGraph::read_local_graph_from_file(localGraphFileName);
       Tgraph_construct.stop();
       return;
@@ -227,9 +241,11 @@ public:
     bufGraph.resetReadCounters();
     galois::StatTimer graphReadTimer("GraphReading", GRNAME);
     graphReadTimer.start();
-    bufGraph.loadPartialGraph(filename, nodeBegin, nodeEnd, *edgeBegin,
-                              *edgeEnd, base_DistGraph::numGlobalNodes,
-                              base_DistGraph::numGlobalEdges);
+    // edges are streamed in the background so that master assignment and
+    // edge inspection overlap with disk reads
+    bufGraph.loadPartialGraphAsync(filename, nodeBegin, nodeEnd, *edgeBegin,
+                                   *edgeEnd, base_DistGraph::numGlobalNodes,
+                                   base_DistGraph::numGlobalEdges);
     graphReadTimer.stop();
     galois::gPrint("[", base_DistGraph::id, "] Reading graph complete.\n");
 
@@ -286,6 +302,16 @@ public:
     freeVector(numOutgoingEdges); // should no longer use this variable
     freeVector(hasIncomingEdge);  // should no longer use this variable
 
+    bufGraph.waitForLoad();
+    uint64_t readTime = bufGraph.getAsyncReadTime();
+    galois::runtime::reportStat_Single(GRNAME, "GraphReadBytes",
+                                       bufGraph.getAsyncBytesRead());
+    galois::runtime::reportStat_Single(
+        GRNAME, "GraphReadBytesPerSec",
+        readTime ? bufGraph.getAsyncBytesRead() * 1000000 / readTime : 0);
+    galois::runtime::reportStat_Single(GRNAME, "GraphReadStallTimeMs",
+                                       bufGraph.getStallTime() / 1000);
+
     // Graph construction related calls
 
     base_DistGraph::beginMaster = 0;
@@ -0,0 +1,167 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file BatchPolicy.h
+ *
+ * When the buffered network interface flushes the messages queued for a host.
+ * Time is passed in as microseconds so that the policy can be tested without
+ * a network.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/substrate/EnvCheck.h"
+
+namespace galois {
+namespace runtime {
+
+/**
+ * Estimate of the rate at which bytes are queued for one host, sampled over
+ * windows of at least WINDOW microseconds and smoothed over about 8 windows.
+ * Traffic that stops for maxIdle microseconds or longer has paused; the rate
+ * is unknown until the traffic after the pause has been sampled.
+ */
+class SendRate {
+  double rate = 0.0; //!< bytes per microsecond; 0 if unknown
+  int64_t lastAdd     = 0;
+  int64_t windowStart = 0;
+  size_t windowBytes  = 0;
+
+public:
+  //! microseconds over which the send rate is sampled
+  constexpr static int64_t WINDOW = 10;
+
+  //! Records bytes queued at time now
+  void add(int64_t now, size_t bytes, int64_t maxIdle) {
+    // a window that spans a pause would average the pause into the rate, so
+    // the traffic after it starts a new window
+    if (now - lastAdd >= maxIdle) {
+      rate        = 0.0;
+      windowStart = now;
+      windowBytes = 0;
+    }
+    lastAdd = now;
+
+    windowBytes += bytes;
+    if (now - windowStart >= WINDOW) {
+      double sample = double(windowBytes) / (now - windowStart);
+      rate          = (rate == 0.0) ? sample : (7 * rate + sample) / 8;
+      windowStart   = now;
+      windowBytes   = 0;
+    }
+  }
+
+  //! @returns the rate at time now, or 0 if it is not known
+  double get(int64_t now, int64_t maxIdle) const {
+    return (now - lastAdd < maxIdle) ? rate : 0.0;
+  }
+};
+
+/**
+ * When a send buffer is flushed. All fields can be set through environment
+ * variables named in the comments.
+ *
+ * The adaptive policy sizes a batch to the bytes expected to be queued for
+ * a host within one delay period at the observed rate, bounded by
+ * minBytes and maxBytes. It flushes a batch right away when, at that rate,
+ * it would not reach minBytes before the delay runs out, so sparse
+ * traffic (e.g., asynchronous algorithms) is not held back. While the rate
+ * is not known, e.g., at the start of a burst, a batch waits for up to the
+ * delay. While more than congestedBytes are in flight, batches are doubled
+ * and never flushed early so that the network drains with fewer, larger
+ * messages.
+ */
+struct BatchPolicy {
+  //! bytes (slightly smaller than an ethernet packet)
+  constexpr static size_t COMM_MIN = 1400;
+  //! bytes
+  constexpr static size_t COMM_MAX = 1 << 20;
+  //! microseconds
+  constexpr static int64_t COMM_DELAY = 100;
+  constexpr static int COMM_CONGESTED_MB = 64;
+
+  //! Whether to flush: not yet, because the batch is full, because its
+  //! oldest message waited for the delay, or because it will not fill in time
+  enum Decision { WAIT, FULL, TIMEOUT, EARLY };
+
+  //! GALOIS_NET_ADAPTIVE; 0 flushes at minBytes or after delay only
+  bool adaptive = true;
+  //! GALOIS_NET_BATCH_MIN, in bytes
+  size_t minBytes = COMM_MIN;
+  //! GALOIS_NET_BATCH_MAX, in bytes
+  size_t maxBytes = COMM_MAX;
+  //! GALOIS_NET_DELAY_US, the longest a message waits in microseconds
+  int64_t delay = COMM_DELAY;
+  //! GALOIS_NET_CONGESTED_MB
+  int64_t congestedBytes = int64_t{COMM_CONGESTED_MB} << 20;
+
+  void readEnv() {
+    using galois::substrate::EnvCheck;
+    int v;
+    if (EnvCheck("GALOIS_NET_ADAPTIVE", v))
+      adaptive = v;
+    if (EnvCheck("GALOIS_NET_BATCH_MIN", v) && v > 0)
+      minBytes = v;
+    if (EnvCheck("GALOIS_NET_BATCH_MAX", v) && v > 0)
+      maxBytes = v;
+    if (EnvCheck("GALOIS_NET_DELAY_US", v) && v >= 0)
+      delay = v;
+    if (EnvCheck("GALOIS_NET_CONGESTED_MB", v) && v >= 0)
+      congestedBytes = int64_t{v} << 20;
+    maxBytes = std::max(minBytes, maxBytes);
+  }
+
+  /**
+   * @param bytes bytes buffered for the host; must be non-zero
+   * @param elapsed microseconds the oldest buffered message has waited
+   * @param rate send rate to the host from SendRate::get; 0 if unknown
+   * @param inflight bytes currently in flight in the network layer
+   * @returns whether to flush the buffer now, and why
+   */
+  Decision decide(size_t bytes, int64_t elapsed, double rate,
+                  int64_t inflight) const {
+    bool congested = inflight > congestedBytes;
+    size_t target  = minBytes;
+    if (adaptive) {
+      double expected = rate * delay;
+      target          = std::max<double>(minBytes,
+                                         std::min<double>(maxBytes, expected));
+      if (congested)
+        target = std::min(2 * target, maxBytes);
+    }
+    if (bytes > target)
+      return FULL;
+    if (elapsed > delay)
+      return TIMEOUT;
+    // at the observed rate the batch will not reach minBytes before the delay
+    // runs out, so waiting only adds latency
+    if (adaptive && !congested && rate > 0.0 && bytes < minBytes &&
+        elapsed + (minBytes - bytes) / rate > delay)
+      return EARLY;
+    return WAIT;
+  }
+};
+
+} // namespace runtime
+} // namespace galois
@@ -242,6 +242,26 @@ class DistStatManager : public galois::runtime::StatManager {
     }
   }
 }
+
+    void write(StatWriter& w) const {
+  for (auto i = Base::cbegin(), end_i = Base::cend(); i != end_i; ++i) {
+    const HostStat<T>& hs = Base::stat(i);
+    const char* kind      = StatManager::statKind<T>();
+
+    // values of the total record are the per-host totals
+    w.write(internal::makeStatRecord(kind, Base::region(i), Base::category(i),
+                                     htotalName(hs.totalTy()), hs));
+
+    for (const auto& p : hs.perHostThrdStats) {
+      StatRecord r = internal::makeStatRecord(
+          kind, Base::region(i), Base::category(i),
+          StatTotal::str(p.second.totalTy()), p.second);
+      r.scope = "host";
+      r.host  = p.first;
+      w.write(r);
+    }
+  }
+}
 }; // namespace runtime
 
 DistStatCombiner<int64_t> intDistStats;
@@ -264,6 +284,9 @@ void mergeStats(void);
  */
 void printHeader(std::ostream& out) const;
 
+//! Run info with the number of hosts filled in
+StatRunInfo runInfo(void) const override;
+
 /**
  * Merge all stats. Host 0 will then print out all collected stats.
  */
@@ -38,7 +38,8 @@ namespace runtime {
 class MemUsageTracker {
   std::atomic<int64_t>
       currentMemUsage; //!< mem usage of send and receive buffers
-  int64_t maxMemUsage; //!< max mem usage of send and receive buffers
+  std::atomic<int64_t>
+      maxMemUsage; //!< max mem usage of send and receive buffers
 
 public:
   //! Default constructor initializes everything to 0.
@@ -50,9 +51,11 @@ public:
    * @param size amount to increment mem usage by
    */
   inline void incrementMemUsage(uint64_t size) {
-    currentMemUsage += size;
-    if (currentMemUsage > maxMemUsage)
-      maxMemUsage = currentMemUsage;
+    int64_t current = currentMemUsage += size;
+    // several network threads may update the max at once
+    int64_t max = maxMemUsage.load(std::memory_order_relaxed);
+    while (current > max && !maxMemUsage.compare_exchange_weak(max, current))
+      ;
   }
 
   /**
@@ -76,6 +79,13 @@ public:
    * @returns maximum memory usage tracked so far
    */
   inline int64_t getMaxMemUsage() const { return maxMemUsage; }
+
+  /**
+   * Get current mem usage.
+   *
+   * @returns memory usage of the buffers currently in flight
+   */
+  inline int64_t getMemUsage() const { return currentMemUsage; }
 };
 
 } // namespace runtime
@@ -109,6 +109,9 @@ public:
   //! tag (tag) and some data (buf)
   //! on the receiver, buf will be returned on a receiveTagged(tag)
   //! buf is invalidated by this operation
+  //! Sends from the threads of the thread pool, the master thread included,
+  //! take no lock; threads outside the pool may send as well but are
+  //! serialized on a shared lane per destination
   virtual void sendTagged(uint32_t dest, uint32_t tag, SendBuffer& buf,
                           int type = 0) = 0;
 
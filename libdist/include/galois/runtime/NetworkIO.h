@@ -48,6 +48,11 @@ namespace runtime {
 /**
  * Class for the network IO layer which is responsible for doing sends/receives
  * of data. Used by the network interface to do the actual communication.
+ *
+ * Hosts are split into shards so that several progress threads can drive one
+ * IO layer: shard s holds the hosts h with h % numShards == s. Only the
+ * thread that owns a shard may send to its hosts or call progress/dequeue
+ * for it, so calls for different shards may run concurrently.
  */
 class NetworkIO {
 protected:
@@ -106,24 +111,45 @@ public:
   //! Default destructor does nothing.
   virtual ~NetworkIO();
   //! Queues a message for sending out. Takes ownership of data buffer.
+  //! Must be called by the owner of the shard of the destination.
   virtual void enqueue(message m) = 0;
-  //! Checks to see if a message is here for this host to receive. If so, take
-  //! and return it
+  //! Checks to see if a message from a host in the given shard is here for
+  //! this host to receive. If so, take and return it
   //! @returns an empty message if no message
-  virtual message dequeue() = 0;
-  //! Make progress. Other functions don't have to make progress.
-  virtual void progress() = 0;
+  virtual message dequeue(unsigned shard) = 0;
+  //! Make progress on the sends and receives of a shard. Other functions
+  //! don't have to make progress.
+  virtual void progress(unsigned shard) = 0;
 };
 
 /**
  * Creates/returns a network IO layer that uses MPI to do communication.
  *
+ * @param numShards number of shards the hosts are split into
  * @returns tuple with pointer to the MPI IO layer, this host's ID, and the
  * total number of hosts in the system
  */
 std::tuple<std::unique_ptr<NetworkIO>, uint32_t, uint32_t>
 makeNetworkIOMPI(galois::runtime::MemUsageTracker& tracker,
-                 std::atomic<size_t>& sends, std::atomic<size_t>& recvs);
+                 std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
+                 unsigned numShards = 1);
+
+/**
+ * Creates/returns a network IO layer that passes messages to hosts on the
+ * same machine through shared memory and uses MPI for the other hosts. Falls
+ * back to the MPI layer alone if no hosts share this machine, if the shared
+ * memory cannot be set up, or if the GALOIS_SHM_NETWORK environment variable
+ * is 0. GALOIS_SHM_RING_KB sets the size of each ring (default 8 MB).
+ * Collective over all hosts.
+ *
+ * @param numShards number of shards the hosts are split into
+ * @returns tuple with pointer to the IO layer, this host's ID, and the
+ * total number of hosts in the system
+ */
+std::tuple<std::unique_ptr<NetworkIO>, uint32_t, uint32_t>
+makeNetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+                 std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
+                 unsigned numShards = 1);
 // #ifdef GALOIS_USE_LCI
 // /**
 //  * Creates/returns a network IO layer that uses LWCI to do communication.
@@ -25,16 +25,23 @@
 
 #include "galois/DistGalois.h"
 #include "galois/runtime/Network.h"
+#include "galois/substrate/EnvCheck.h"
 
 //! DistMemSys constructor which calls the shared memory runtime constructor
 //! with the distributed stats manager
 galois::DistMemSys::DistMemSys()
     : galois::runtime::SharedMem<galois::runtime::DistStatManager>() {}
 
-//! DistMemSys destructor which reports memory usage from the network
+//! DistMemSys destructor which reports memory usage from the network, and
+//! its extra statistics (e.g., batching histograms) if GALOIS_NET_STATS is set
 galois::DistMemSys::~DistMemSys() {
+  auto& net = galois::runtime::getSystemNetworkInterface();
   if (MORE_DIST_STATS) {
-    auto& net = galois::runtime::getSystemNetworkInterface();
     net.reportMemUsage();
   }
+  if (MORE_DIST_STATS || galois::substrate::EnvCheck("GALOIS_NET_STATS")) {
+    for (auto& stat : net.reportExtraNamed()) {
+      galois::runtime::reportStat_Tsum("Network", stat.first, stat.second);
+    }
+  }
 }
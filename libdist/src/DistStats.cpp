@@ -392,16 +392,31 @@ void DistStatManager::printHeader(std::ostream& out) const {
   out << std::endl;
 }
 
+StatRunInfo DistStatManager::runInfo(void) const {
+  StatRunInfo info = Base::runInfo();
+  info.hosts       = NetworkInterface::Num;
+  return info;
+}
+
 void DistStatManager::printStats(std::ostream& out) {
   mergeStats();
 
   galois::DGTerminator<unsigned int> td;
   if (getHostID() == 0) {
-    printHeader(out);
+    StatFormat format = statFormat();
+    if (format != StatFormat::TEXT) {
+      StatWriter w(out, format, runInfo());
+      intDistStats.write(w);
+      fpDistStats.write(w);
+      strDistStats.write(w);
 
-    intDistStats.print(out);
-    fpDistStats.print(out);
-    strDistStats.print(out);
+    } else {
+      printHeader(out);
+
+      intDistStats.print(out);
+      fpDistStats.print(out);
+      strDistStats.print(out);
+    }
   }
   // all hosts must wait for host 0 to finish printing stats
   while (td.reduce()) {
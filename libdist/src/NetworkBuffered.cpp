@@ -26,9 +26,14 @@
  * @todo document this file more
  */
 
+#include "galois/runtime/BatchPolicy.h"
 #include "galois/runtime/Network.h"
 #include "galois/runtime/NetworkIO.h"
 #include "galois/runtime/Tracer.h"
+#include "galois/substrate/Trace.h"
+#include "galois/substrate/EnvCheck.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
 
 #ifdef GALOIS_USE_LCI
 #define NO_AGG
@@ -38,6 +43,8 @@
 #include <mutex>
 #include <iostream>
 #include <limits>
+#include <array>
+#include <cmath>
 
 using namespace galois::runtime;
 using namespace galois::substrate;
@@ -48,20 +55,34 @@ namespace {
  * @class NetworkInterfaceBuffered
  *
  * Buffered network interface: messages are buffered before they are sent out.
- * A single worker thread is initialized to send/receive messages from/to
- * buffers.
+ * Progress threads (GALOIS_NET_THREADS, default 1) send/receive messages
+ * from/to buffers, with the destinations split among them. Compute threads
+ * queue messages on per-thread lanes that the progress threads drain, so
+ * sending never takes a lock.
  */
 class NetworkInterfaceBuffered : public NetworkInterface {
-  static const int COMM_MIN =
-      1400; //! bytes (sligtly smaller than an ethernet packet)
-  static const int COMM_DELAY = 100; //! microseconds delay
+  //! log2 bins of the message size and queueing delay histograms
+  constexpr static unsigned HIST_BINS = 32;
+
+  BatchPolicy policy;
+
+  //! microseconds since an arbitrary epoch
+  static int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  //! log2 histogram bin of a value
+  static unsigned histBin(uint64_t v) {
+    unsigned b = v ? 63 - __builtin_clzll(v) : 0;
+    return std::min(b, HIST_BINS - 1);
+  }
 
   unsigned long statSendNum;
   unsigned long statSendBytes;
-  unsigned long statSendEnqueued;
   unsigned long statRecvNum;
   unsigned long statRecvBytes;
-  unsigned long statRecvDequeued;
   bool anyReceivedMessages;
 
   // using vTy = std::vector<uint8_t>;
@@ -239,7 +260,60 @@ class NetworkInterfaceBuffered : public NetworkInterface {
   std::vector<SimpleLock> recvLock;
 
   /**
-   * Send buffers for the buffered network interface
+   * Unbounded queue of messages from one compute thread to the progress
+   * thread of one destination. It has a single producer and a single
+   * consumer, so neither side takes a lock: the producer links a node after
+   * the last one and the consumer frees the nodes before the first one it has
+   * not read.
+   */
+  class SendLane {
+    struct Node {
+      std::atomic<Node*> next{nullptr};
+      uint32_t tag = 0;
+      vTy data;
+    };
+
+    //! consumer side; the last node read
+    alignas(64) Node* head;
+    //! producer side; the last node written
+    alignas(64) Node* tail;
+
+  public:
+    SendLane() { head = tail = new Node; }
+
+    ~SendLane() {
+      while (head) {
+        Node* n = head->next.load(std::memory_order_relaxed);
+        delete head;
+        head = n;
+      }
+    }
+
+    void push(uint32_t tag, vTy& b) {
+      Node* n = new Node;
+      n->tag  = tag;
+      n->data = std::move(b);
+      tail->next.store(n, std::memory_order_release);
+      tail = n;
+    }
+
+    //! Calls f(tag, data) on every message pushed so far, in push order
+    template <typename F>
+    void drain(F&& f) {
+      Node* n = head->next.load(std::memory_order_acquire);
+      while (n) {
+        f(n->tag, n->data);
+        delete head;
+        head = n;
+        n    = head->next.load(std::memory_order_acquire);
+      }
+    }
+  };
+
+  /**
+   * Send buffers for the buffered network interface. Compute threads only
+   * touch their own lane and the flush flag; everything else is used by the
+   * progress thread that owns the destination alone.
    */
   class sendBuffer {
     struct msg {
@@ -248,50 +322,118 @@ class NetworkInterfaceBuffered : public NetworkInterface {
       msg(uint32_t t, vTy& _data) : tag(t), data(std::move(_data)) {}
     };
 
+    std::unique_ptr<SendLane[]> lanes;
+    unsigned numLanes;
+    //! serializes the threads outside the pool on the last lane, which like
+    //! the others has a single producer at a time
+    SimpleLock sharedLaneLock;
+    //! set by flush; makes the progress thread mark the buffer urgent
+    std::atomic<bool> flushRequested;
+
     std::deque<msg> messages;
-    std::atomic<size_t> numBytes;
-    std::atomic<unsigned> urgent;
-    //! @todo FIXME track time since some epoch in an atomic.
-    std::chrono::high_resolution_clock::time_point time;
-    SimpleLock lock, timelock;
+    size_t numBytes;
+    unsigned urgent;
+    //! microseconds at which the oldest buffered message was added
+    int64_t time;
+
+    SendRate rate;
+
+    void markUrgent() { urgent = messages.size(); }
+
+    void add(uint32_t tag, vTy& b, const BatchPolicy& policy) {
+      int64_t now = nowMicros();
+      if (messages.empty()) {
+        time = now;
+      }
+      size_t oldNumBytes = numBytes;
+      numBytes += b.size();
+
+      rate.add(now, b.size(), policy.delay);
+      galois::runtime::trace("BufferedAdd", oldNumBytes, numBytes, tag,
+                             galois::runtime::printVec(b));
+      messages.emplace_back(tag, b);
+    }
 
   public:
     unsigned long statSendTimeout;
     unsigned long statSendOverflow;
     unsigned long statSendUrgent;
+    unsigned long statSendEarly;
+    //! messages sent by log2 of their size in bytes
+    std::array<unsigned long, HIST_BINS> sizeHist;
+    //! messages sent by log2 of the microseconds their oldest part waited
+    std::array<unsigned long, HIST_BINS> delayHist;
+
+    //! One lane for each of n pool threads and one shared by all other
+    //! threads
+    void setLanes(unsigned n) {
+      lanes.reset(new SendLane[n + 1]);
+      numLanes = n + 1;
+    }
 
     size_t size() { return messages.size(); }
 
-    void markUrgent() {
-      if (numBytes) {
-        std::lock_guard<SimpleLock> lg(lock);
-        urgent = messages.size();
+    // Compute thread interface
+
+    //! Queues a message on the lane of compute thread tid
+    void push(unsigned tid, uint32_t tag, vTy& b) {
+      assert(tid < numLanes - 1);
+      lanes[tid].push(tag, b);
+    }
+
+    //! Queues a message from a thread outside the pool
+    void pushShared(uint32_t tag, vTy& b) {
+      std::lock_guard<SimpleLock> lg(sharedLaneLock);
+      lanes[numLanes - 1].push(tag, b);
+    }
+
+    void requestFlush() { flushRequested.store(true); }
+
+    // Progress thread interface
+
+    //! Moves the messages of all lanes into the buffer
+    void drain(const BatchPolicy& policy) {
+      // the flag is read first so that every message queued before the
+      // flush is drained before the buffer is marked urgent
+      bool flush = flushRequested.load(std::memory_order_relaxed) &&
+                   flushRequested.exchange(false);
+      for (unsigned t = 0; t < numLanes; ++t) {
+        lanes[t].drain([&](uint32_t tag, vTy& b) { add(tag, b, policy); });
+      }
+      if (flush && numBytes) {
+        markUrgent();
       }
     }
 
-    bool ready() {
+    /**
+     * @param policy when to flush
+     * @param inflight bytes currently in flight in the network layer
+     * @returns true if the buffer should be sent now
+     */
+    bool ready(const BatchPolicy& policy, int64_t inflight) {
 #ifndef NO_AGG
-      if (numBytes == 0)
+      size_t bytes = numBytes;
+      if (bytes == 0)
         return false;
       if (urgent) {
         ++statSendUrgent;
         return true;
       }
-      if (numBytes > COMM_MIN) {
+
+      int64_t now = nowMicros();
+      switch (policy.decide(bytes, now - time, rate.get(now, policy.delay),
+                            inflight)) {
+      case BatchPolicy::FULL:
         ++statSendOverflow;
         return true;
-      }
-      auto n = std::chrono::high_resolution_clock::now();
-      decltype(n) mytime;
-      {
-        std::lock_guard<SimpleLock> lg(timelock);
-        mytime = time;
-      }
-      auto elapsed =
-          std::chrono::duration_cast<std::chrono::microseconds>(n - mytime);
-      if (elapsed.count() > COMM_DELAY) {
+      case BatchPolicy::TIMEOUT:
         ++statSendTimeout;
         return true;
+      case BatchPolicy::EARLY:
+        ++statSendEarly;
+        return true;
+      case BatchPolicy::WAIT:
+        break;
       }
       return false;
 #else
@@ -301,7 +443,6 @@ class NetworkInterfaceBuffered : public NetworkInterface {
 
     std::pair<uint32_t, vTy>
     assemble(std::atomic<size_t>& GALOIS_UNUSED(inflightSends)) {
-      std::unique_lock<SimpleLock> lg(lock);
       if (messages.empty())
         return std::make_pair(~0, vTy());
 #ifndef NO_AGG
@@ -323,15 +464,11 @@ class NetworkInterfaceBuffered : public NetworkInterface {
           num += sizeof(uint32_t);
         }
       }
-      lg.unlock();
       // construct message
       vTy vec;
       vec.reserve(len + num);
-      // go out of our way to avoid locking out senders when making messages
-      lg.lock();
       do {
         auto& m = messages.front();
-        lg.unlock();
         union {
           uint32_t a;
           uint8_t b[sizeof(uint32_t)];
@@ -341,12 +478,14 @@ class NetworkInterfaceBuffered : public NetworkInterface {
         vec.insert(vec.end(), m.data.begin(), m.data.end());
         if (urgent)
           --urgent;
-        lg.lock();
         messages.pop_front();
         --inflightSends;
       } while (vec.size() < len + num);
       ++inflightSends;
       numBytes -= len;
+
+      ++sizeHist[histBin(vec.size())];
+      ++delayHist[histBin(nowMicros() - time)];
 #else
       uint32_t tag = messages.front().tag;
       vTy vec(std::move(messages.front().data));
@@ -354,79 +493,117 @@ class NetworkInterfaceBuffered : public NetworkInterface {
 #endif
       return std::make_pair(tag, std::move(vec));
     }
-
-    void add(uint32_t tag, vTy& b) {
-      std::lock_guard<SimpleLock> lg(lock);
-      if (messages.empty()) {
-        std::lock_guard<SimpleLock> lg(timelock);
-        time = std::chrono::high_resolution_clock::now();
-      }
-      unsigned oldNumBytes = numBytes;
-      numBytes += b.size();
-      galois::runtime::trace("BufferedAdd", oldNumBytes, numBytes, tag,
-                             galois::runtime::printVec(b));
-      messages.emplace_back(tag, b);
-    }
   }; // end send buffer class
 
   std::vector<sendBuffer> sendData;
 
-  void workerThread() {
-    initializeMPI();
-    int rank;
-    int hostSize;
+  //! Counters of a progress thread; on their own cache line as each thread
+  //! updates its own
+  struct alignas(64) WorkerStats {
+    unsigned long sendEnqueued = 0;
+    unsigned long recvDequeued = 0;
+    //! microseconds spent in passes that sent or received a message
+    int64_t busy = 0;
+    //! microseconds spent in all passes
+    int64_t total = 0;
+  };
+
+  //! number of progress threads; GALOIS_NET_THREADS
+  unsigned numWorkers;
+  std::unique_ptr<WorkerStats[]> workerStats;
+  std::atomic<unsigned> stoppedWorkers;
 
-    int rankSuccess = MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if (rankSuccess != MPI_SUCCESS) {
-      MPI_Abort(MPI_COMM_WORLD, rankSuccess);
-    }
+  /**
+   * Progress thread w: owns the destinations h with h % numWorkers == w and
+   * the matching shard of the network IO layer. Thread 0 also initializes
+   * and finalizes MPI.
+   */
+  void workerThread(unsigned w) {
+    galois::substrate::traceThreadName("network");
+    if (w == 0) {
+      initializeMPI();
+      int rank;
+      int hostSize;
+
+      int rankSuccess = MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      if (rankSuccess != MPI_SUCCESS) {
+        MPI_Abort(MPI_COMM_WORLD, rankSuccess);
+      }
 
-    int sizeSuccess = MPI_Comm_size(MPI_COMM_WORLD, &hostSize);
-    if (sizeSuccess != MPI_SUCCESS) {
-      MPI_Abort(MPI_COMM_WORLD, sizeSuccess);
-    }
+      int sizeSuccess = MPI_Comm_size(MPI_COMM_WORLD, &hostSize);
+      if (sizeSuccess != MPI_SUCCESS) {
+        MPI_Abort(MPI_COMM_WORLD, sizeSuccess);
+      }
 
-    galois::gDebug("[", NetworkInterface::ID, "] MPI initialized");
-    std::tie(netio, ID, Num) =
-        makeNetworkIOMPI(memUsageTracker, inflightSends, inflightRecvs);
+      galois::gDebug("[", NetworkInterface::ID, "] MPI initialized");
+      // a thread without destinations would have nothing to do
+      numWorkers = std::min<unsigned>(numWorkers, hostSize);
+      std::tie(netio, ID, Num) = makeNetworkIOShm(
+          memUsageTracker, inflightSends, inflightRecvs, numWorkers);
 
-    assert(ID == (unsigned)rank);
-    assert(Num == (unsigned)hostSize);
+      assert(ID == (unsigned)rank);
+      assert(Num == (unsigned)hostSize);
+      galois::substrate::traceProcess(ID);
 
-    ready = 1;
+      ready = 1;
+    }
     while (ready < 2) { /*fprintf(stderr, "[WaitOnReady-2]");*/
     };
+    auto& stats  = workerStats[w];
+    int64_t last = nowMicros();
     while (ready != 3) {
-      for (unsigned i = 0; i < sendData.size(); ++i) {
-        netio->progress();
+      bool worked = false;
+      for (unsigned i = w; i < sendData.size(); i += numWorkers) {
+        netio->progress(w);
         // handle send queue i
         auto& sd = sendData[i];
-        if (sd.ready()) {
+        sd.drain(policy);
+        if (sd.ready(policy, memUsageTracker.getMemUsage())) {
           NetworkIO::message msg;
           msg.host                    = i;
           std::tie(msg.tag, msg.data) = sd.assemble(inflightSends);
           galois::runtime::trace("BufferedSending", msg.host, msg.tag,
                                  galois::runtime::printVec(msg.data));
-          ++statSendEnqueued;
+          ++stats.sendEnqueued;
+          galois::substrate::traceInstant(
+              galois::substrate::TraceCategory::NETWORK, "send",
+              msg.data.size());
           netio->enqueue(std::move(msg));
+          worked = true;
         }
         // handle receive
-        NetworkIO::message rdata = netio->dequeue();
+        NetworkIO::message rdata = netio->dequeue(w);
         if (rdata.data.size()) {
-          ++statRecvDequeued;
+          ++stats.recvDequeued;
           assert(rdata.data.size() !=
                  (unsigned int)std::count(rdata.data.begin(), rdata.data.end(),
                                           0));
           galois::runtime::trace("BufferedRecieving", rdata.host, rdata.tag,
                                  galois::runtime::printVec(rdata.data));
+          galois::substrate::traceInstant(
+              galois::substrate::TraceCategory::NETWORK, "recv",
+              rdata.data.size());
           recvData[rdata.host].add(std::move(rdata));
+          worked = true;
         }
       }
+      int64_t now = nowMicros();
+      if (worked)
+        stats.busy += now - last;
+      stats.total += now - last;
+      last = now;
+    }
+    if (w == 0) {
+      // the other threads may still be inside MPI
+      while (stoppedWorkers != numWorkers - 1) {
+      };
+      finalizeMPI();
+    } else {
+      ++stoppedWorkers;
     }
-    finalizeMPI();
   }
 
-  std::thread worker;
+  std::vector<std::thread> workers;
   std::atomic<int> ready;
 
 public:
@@ -437,19 +614,33 @@ public:
     inflightSends       = 0;
     inflightRecvs       = 0;
     ready               = 0;
+    stoppedWorkers      = 0;
     anyReceivedMessages = false;
-    worker = std::thread(&NetworkInterfaceBuffered::workerThread, this);
+    policy.readEnv();
+    int threads = 1;
+    EnvCheck("GALOIS_NET_THREADS", threads);
+    numWorkers  = std::max(threads, 1);
+    workerStats.reset(new WorkerStats[numWorkers]);
+    workers.emplace_back(&NetworkInterfaceBuffered::workerThread, this, 0);
     while (ready != 1) {
     };
     recvData = decltype(recvData)(Num);
     recvLock.resize(Num);
     sendData = decltype(sendData)(Num);
-    ready    = 2;
+    // sends come from the threads of the pool, the main thread included, and
+    // rarely from other threads
+    unsigned lanes = galois::substrate::getThreadPool().getMaxThreads();
+    for (auto& sd : sendData)
+      sd.setLanes(lanes);
+    for (unsigned w = 1; w < numWorkers; ++w)
+      workers.emplace_back(&NetworkInterfaceBuffered::workerThread, this, w);
+    ready = 2;
   }
 
   virtual ~NetworkInterfaceBuffered() {
     ready = 3;
-    worker.join();
+    for (auto& w : workers)
+      w.join();
   }
 
   std::unique_ptr<galois::runtime::NetworkIO> netio;
@@ -462,8 +653,12 @@ public:
     statSendBytes += buf.size();
     galois::runtime::trace("sendTagged", dest, tag,
                            galois::runtime::printVec(buf.getVec()));
-    auto& sd = sendData[dest];
-    sd.add(tag, buf.getVec());
+    // threads outside the pool also report tid 0 and must not share the
+    // lock-free lane of the master thread
+    if (galois::substrate::getThreadPool().isPoolThread())
+      sendData[dest].push(ThreadPool::getTID(), tag, buf.getVec());
+    else
+      sendData[dest].pushShared(tag, buf.getVec());
   }
 
   virtual std::optional<std::pair<uint32_t, RecvBuffer>>
@@ -501,7 +696,7 @@ public:
 
   virtual void flush() {
     for (auto& sd : sendData)
-      sd.markUrgent();
+      sd.requestFlush();
   }
 
   virtual bool anyPendingSends() { return (inflightSends > 0); }
@@ -524,32 +719,73 @@ public:
   virtual unsigned long reportRecvMsgs() const { return statRecvNum; }
 
   virtual std::vector<unsigned long> reportExtra() const {
-    std::vector<unsigned long> retval(5);
-    for (auto& sd : sendData) {
-      retval[0] += sd.statSendTimeout;
-      retval[1] += sd.statSendOverflow;
-      retval[2] += sd.statSendUrgent;
+    std::vector<unsigned long> retval;
+    for (auto& named : reportExtraNamed()) {
+      retval.push_back(named.second);
     }
-    retval[3] = statSendEnqueued;
-    retval[4] = statRecvDequeued;
     return retval;
   }
 
+  /**
+   * The first five values keep their original positions (SendTimeout,
+   * SendOverflow, SendUrgent, SendEnqueued, RecvDequeued); newer counters
+   * are appended after them, starting with SendEarly.
+   *
+   * Besides the flush counters, reports for every destination h and
+   * non-empty bin k the number of messages of [2^k, 2^(k+1)) bytes
+   * (SendSizeHist_h_k) and of messages whose oldest part waited
+   * [2^k, 2^(k+1)) microseconds before being sent (SendDelayHist_h_k).
+   * For every progress thread w it reports the microseconds it ran
+   * (CommThreadTotalUs_w), the part of them spent in passes that sent or
+   * received a message (CommThreadBusyUs_w), and their ratio in percent
+   * (CommThreadUtilPct_w).
+   */
   virtual std::vector<std::pair<std::string, unsigned long>>
   reportExtraNamed() const {
-    std::vector<std::pair<std::string, unsigned long>> retval(5);
+    std::vector<std::pair<std::string, unsigned long>> retval(6);
     retval[0].first = "SendTimeout";
     retval[1].first = "SendOverflow";
     retval[2].first = "SendUrgent";
     retval[3].first = "SendEnqueued";
     retval[4].first = "RecvDequeued";
+    retval[5].first = "SendEarly";
     for (auto& sd : sendData) {
       retval[0].second += sd.statSendTimeout;
       retval[1].second += sd.statSendOverflow;
       retval[2].second += sd.statSendUrgent;
+      retval[5].second += sd.statSendEarly;
+    }
+    for (unsigned w = 0; w < numWorkers; ++w) {
+      retval[3].second += workerStats[w].sendEnqueued;
+      retval[4].second += workerStats[w].recvDequeued;
+    }
+
+    for (unsigned w = 0; w < numWorkers; ++w) {
+      auto& stats       = workerStats[w];
+      std::string index = std::to_string(w);
+      retval.emplace_back("CommThreadBusyUs_" + index, stats.busy);
+      retval.emplace_back("CommThreadTotalUs_" + index, stats.total);
+      retval.emplace_back("CommThreadUtilPct_" + index,
+                          stats.total ? 100 * stats.busy / stats.total : 0);
+    }
+
+    for (unsigned h = 0; h < sendData.size(); ++h) {
+      auto& sd = sendData[h];
+      for (unsigned k = 0; k < HIST_BINS; ++k) {
+        if (sd.sizeHist[k]) {
+          retval.emplace_back("SendSizeHist_" + std::to_string(h) + "_" +
+                                  std::to_string(k),
+                              sd.sizeHist[k]);
+        }
+      }
+      for (unsigned k = 0; k < HIST_BINS; ++k) {
+        if (sd.delayHist[k]) {
+          retval.emplace_back("SendDelayHist_" + std::to_string(h) + "_" +
+                                  std::to_string(k),
+                              sd.delayHist[k]);
+        }
+      }
     }
-    retval[3].second = statSendEnqueued;
-    retval[4].second = statRecvDequeued;
     return retval;
   }
 };
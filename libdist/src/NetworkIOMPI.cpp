@@ -130,6 +130,10 @@ private:
   struct recvQueueTy {
     std::deque<message> done;
     std::deque<mpiMessage> inflight;
+    //! hosts this queue receives from; empty for any host
+    std::vector<int> sources;
+    //! source to probe next
+    size_t nextSource = 0;
 
     galois::runtime::MemUsageTracker& memUsageTracker;
 
@@ -143,9 +147,15 @@ private:
     void probe() {
       int flag = 0;
       MPI_Status status;
-      // check for new messages
-      int rv = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag,
-                          &status);
+      // check for new messages; a queue restricted to some hosts probes one
+      // of them per call so that it never matches messages of other queues
+      int source = MPI_ANY_SOURCE;
+      if (!sources.empty()) {
+        source     = sources[nextSource];
+        nextSource = (nextSource + 1) % sources.size();
+      }
+      int rv =
+          MPI_Iprobe(source, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
       handleError(rv);
       if (flag) {
 #ifdef GALOIS_USE_BARE_MPI
@@ -183,8 +193,10 @@ private:
     }
   };
 
-  sendQueueTy sendQueue;
-  recvQueueTy recvQueue;
+  //! queues of each shard; deques as the queues cannot be moved
+  std::deque<sendQueueTy> sendQueues;
+  std::deque<recvQueueTy> recvQueues;
+  unsigned numShards;
 
 public:
   /**
@@ -193,17 +205,26 @@ public:
    * @param tracker memory usage tracker
    * @param sends
    * @param recvs
+   * @param shards number of shards the hosts are split into
    * @param [out] ID this machine's host id
    * @param [out] NUM total number of hosts in the system
    */
   NetworkIOMPI(galois::runtime::MemUsageTracker& tracker,
                std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
-               uint32_t& ID, uint32_t& NUM)
-      : NetworkIO(tracker, sends, recvs), sendQueue(tracker, inflightSends),
-        recvQueue(tracker, inflightRecvs) {
+               unsigned shards, uint32_t& ID, uint32_t& NUM)
+      : NetworkIO(tracker, sends, recvs), numShards(shards) {
     auto p = getIDAndHostNum();
     ID     = p.first;
     NUM    = p.second;
+    for (unsigned s = 0; s < numShards; ++s) {
+      sendQueues.emplace_back(tracker, inflightSends);
+      recvQueues.emplace_back(tracker, inflightRecvs);
+    }
+    if (numShards > 1) {
+      for (uint32_t h = 0; h < NUM; ++h) {
+        recvQueues[h % numShards].sources.push_back(h);
+      }
+    }
   }
 
   /**
@@ -211,13 +232,14 @@ public:
    */
   virtual void enqueue(message m) {
     memUsageTracker.incrementMemUsage(m.data.size());
-    sendQueue.send(std::move(m));
+    sendQueues[m.host % numShards].send(std::move(m));
   }
 
   /**
-   * Attempts to get a message from the recv queue.
+   * Attempts to get a message from the recv queue of a shard.
    */
-  virtual message dequeue() {
+  virtual message dequeue(unsigned shard) {
+    auto& recvQueue = recvQueues[shard];
     if (!recvQueue.done.empty()) {
       auto msg = std::move(recvQueue.done.front());
       recvQueue.done.pop_front();
@@ -227,20 +249,21 @@ public:
   }
 
   /**
-   * Push progress forward in the system.
+   * Push progress forward on the queues of a shard.
    */
-  virtual void progress() {
-    sendQueue.complete();
-    recvQueue.probe();
+  virtual void progress(unsigned shard) {
+    sendQueues[shard].complete();
+    recvQueues[shard].probe();
   }
 }; // end NetworkIOMPI class
 
 std::tuple<std::unique_ptr<galois::runtime::NetworkIO>, uint32_t, uint32_t>
 galois::runtime::makeNetworkIOMPI(galois::runtime::MemUsageTracker& tracker,
                                   std::atomic<size_t>& sends,
-                                  std::atomic<size_t>& recvs) {
+                                  std::atomic<size_t>& recvs,
+                                  unsigned numShards) {
   uint32_t ID, NUM;
   std::unique_ptr<galois::runtime::NetworkIO> n{
-      new NetworkIOMPI(tracker, sends, recvs, ID, NUM)};
+      new NetworkIOMPI(tracker, sends, recvs, numShards, ID, NUM)};
   return std::make_tuple(std::move(n), ID, NUM);
 }
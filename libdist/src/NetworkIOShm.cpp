@@ -0,0 +1,441 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file NetworkIOShm.cpp
+ *
+ * Contains an implementation of network IO that passes messages between hosts
+ * on the same machine through shared memory and uses MPI for the rest.
+ */
+
+#include "galois/runtime/NetworkIO.h"
+#include "galois/runtime/Tracer.h"
+#include "galois/substrate/EnvCheck.h"
+#include "galois/gIO.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * Control block of a single-producer single-consumer byte ring in shared
+ * memory; the ring's bytes follow it. Both counters only grow, so
+ * head - tail is the number of bytes in the ring.
+ */
+struct RingHeader {
+  //! bytes written by the producer
+  alignas(64) std::atomic<uint64_t> head;
+  //! bytes consumed by the consumer
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+//! Header of each fragment of a message in a ring
+struct FragmentHeader {
+  uint32_t tag;
+  uint32_t length;   //!< bytes of the message in this fragment
+  uint64_t totalLen; //!< bytes of the whole message
+};
+
+/**
+ * Network IO for hosts that share a machine with other hosts. Every host maps
+ * a segment holding one receive ring per co-located host; a sender copies a
+ * message straight into the receiver's ring and the receiver copies it into a
+ * buffer of the final size, so each message is copied once on each side and
+ * never goes through MPI matching. Messages larger than a ring are split into
+ * fragments. Messages to hosts on other machines go through NetworkIOMPI.
+ *
+ * A ring has a single producer and consumer, the network threads that own
+ * the shards of the two hosts, so the two counters are the only
+ * synchronization.
+ */
+class NetworkIOShm : public galois::runtime::NetworkIO {
+  //! bytes reserved for a ring's control block
+  constexpr static size_t RING_HEADER_SIZE = 128;
+  //! do not start a fragment unless this much of it fits (or all of the rest)
+  constexpr static size_t MIN_FRAGMENT = 4096;
+
+  static_assert(sizeof(RingHeader) <= RING_HEADER_SIZE,
+                "ring control block does not fit");
+
+  //! IO layer for hosts on other machines
+  std::unique_ptr<galois::runtime::NetworkIO> remote;
+
+  //! local index of each host; -1 for hosts on other machines
+  std::vector<int> localIndex;
+  //! host ID of each local index
+  std::vector<uint32_t> localHosts;
+  unsigned myLocalIndex;
+
+  size_t ringSize;
+  size_t segmentSize;
+  //! segment of each local host, mapped into this process
+  std::vector<uint8_t*> segments;
+
+  //! Messages queued for a co-located host
+  struct sendQueueTy {
+    std::deque<message> pending;
+    //! bytes of the front message already in the ring
+    size_t offset = 0;
+  };
+  std::vector<sendQueueTy> sendQueues;
+
+  //! Message being assembled from the ring of a co-located host
+  struct recvStateTy {
+    uint32_t tag = 0;
+    vTy data;
+    size_t received = 0;
+    bool active     = false;
+  };
+  std::vector<recvStateTy> recvStates;
+
+  //! Received messages of a shard
+  struct shardTy {
+    std::deque<message> done;
+    //! local indices of the co-located hosts in this shard
+    std::vector<unsigned> peers;
+    //! alternates dequeue between local and remote messages
+    bool preferRemote = false;
+  };
+  std::vector<shardTy> shards;
+
+  RingHeader* ringHeader(unsigned owner, unsigned writer) const {
+    return reinterpret_cast<RingHeader*>(
+        segments[owner] + writer * (RING_HEADER_SIZE + ringSize));
+  }
+
+  uint8_t* ringData(unsigned owner, unsigned writer) const {
+    return segments[owner] + writer * (RING_HEADER_SIZE + ringSize) +
+           RING_HEADER_SIZE;
+  }
+
+  //! Copies n bytes into a ring starting at logical position pos
+  void ringWrite(uint8_t* ring, uint64_t pos, const void* src, size_t n) {
+    size_t start = pos % ringSize;
+    size_t first = std::min(n, ringSize - start);
+    std::memcpy(ring + start, src, first);
+    std::memcpy(ring, static_cast<const uint8_t*>(src) + first, n - first);
+  }
+
+  //! Copies n bytes out of a ring starting at logical position pos
+  void ringRead(const uint8_t* ring, uint64_t pos, void* dst, size_t n) {
+    size_t start = pos % ringSize;
+    size_t first = std::min(n, ringSize - start);
+    std::memcpy(dst, ring + start, first);
+    std::memcpy(static_cast<uint8_t*>(dst) + first, ring, n - first);
+  }
+
+  static std::string segmentName(int token, uint32_t host) {
+    return "/galois-" + std::to_string(token) + "-" + std::to_string(host);
+  }
+
+  /**
+   * Writes as much of the queued messages to co-located host l as fits in
+   * its ring.
+   */
+  void pushLocal(unsigned l) {
+    auto& q = sendQueues[l];
+    if (q.pending.empty()) {
+      return;
+    }
+    RingHeader* rh = ringHeader(l, myLocalIndex);
+    uint8_t* ring  = ringData(l, myLocalIndex);
+    uint64_t head  = rh->head.load(std::memory_order_relaxed);
+
+    while (!q.pending.empty()) {
+      auto& m     = q.pending.front();
+      size_t left = m.data.size() - q.offset;
+      uint64_t space =
+          ringSize - (head - rh->tail.load(std::memory_order_acquire));
+      if (space <= sizeof(FragmentHeader)) {
+        break;
+      }
+      size_t length = std::min<size_t>(left, space - sizeof(FragmentHeader));
+      if (length < left && length < MIN_FRAGMENT) {
+        break;
+      }
+
+      FragmentHeader fh{m.tag, static_cast<uint32_t>(length), m.data.size()};
+      ringWrite(ring, head, &fh, sizeof(fh));
+      ringWrite(ring, head + sizeof(fh), m.data.data() + q.offset, length);
+      head += sizeof(fh) + length;
+      rh->head.store(head, std::memory_order_release);
+
+      q.offset += length;
+      if (q.offset == m.data.size()) {
+        galois::runtime::trace("SHM SEND", m.host, m.tag, m.data.size());
+        memUsageTracker.decrementMemUsage(m.data.size());
+        --inflightSends;
+        q.pending.pop_front();
+        q.offset = 0;
+      }
+    }
+  }
+
+  //! Reads the fragments co-located host l has written to this host's ring
+  void pullLocal(unsigned l) {
+    RingHeader* rh = ringHeader(myLocalIndex, l);
+    uint8_t* ring  = ringData(myLocalIndex, l);
+    uint64_t tail  = rh->tail.load(std::memory_order_relaxed);
+    uint64_t head  = rh->head.load(std::memory_order_acquire);
+    auto& r        = recvStates[l];
+
+    while (tail != head) {
+      FragmentHeader fh;
+      ringRead(ring, tail, &fh, sizeof(fh));
+      if (!r.active) {
+        r.active   = true;
+        r.tag      = fh.tag;
+        r.received = 0;
+        r.data.resize(fh.totalLen);
+        ++inflightRecvs;
+        memUsageTracker.incrementMemUsage(fh.totalLen);
+      }
+      assert(r.tag == fh.tag && r.received + fh.length <= r.data.size());
+      ringRead(ring, tail + sizeof(fh), r.data.data() + r.received, fh.length);
+      r.received += fh.length;
+      tail += sizeof(fh) + fh.length;
+      rh->tail.store(tail, std::memory_order_release);
+
+      if (r.received == r.data.size()) {
+        galois::runtime::trace("SHM RECV", localHosts[l], r.tag,
+                               r.data.size());
+        auto& s = shards[localHosts[l] % shards.size()];
+        s.done.emplace_back(localHosts[l], r.tag, std::move(r.data));
+        r.data   = vTy();
+        r.active = false;
+      }
+    }
+  }
+
+public:
+  /**
+   * Constructor. Collective over all hosts on this machine, which must share
+   * the communicator given.
+   *
+   * @param tracker memory usage tracker
+   * @param sends
+   * @param recvs
+   * @param mpi IO layer to use for hosts on other machines
+   * @param ID this machine's host id
+   * @param NUM total number of hosts in the system
+   * @param nodeComm communicator of the hosts on this machine
+   * @param ringBytes capacity of each ring
+   * @param numShards number of shards the hosts are split into
+   * @param [out] ok false if the shared memory could not be set up on some
+   * host of this machine; the object must not be used then
+   */
+  NetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+               std::atomic<size_t>& sends, std::atomic<size_t>& recvs,
+               std::unique_ptr<galois::runtime::NetworkIO> mpi, uint32_t ID,
+               uint32_t NUM, MPI_Comm nodeComm, size_t ringBytes,
+               unsigned numShards, bool& ok)
+      : NetworkIO(tracker, sends, recvs), remote(std::move(mpi)),
+        localIndex(NUM, -1), ringSize(std::max(ringBytes, 2 * MIN_FRAGMENT)),
+        shards(numShards) {
+    int localRank, localNum;
+    handleError(MPI_Comm_rank(nodeComm, &localRank));
+    handleError(MPI_Comm_size(nodeComm, &localNum));
+    myLocalIndex = localRank;
+
+    localHosts.resize(localNum);
+    handleError(MPI_Allgather(&ID, 1, MPI_UINT32_T, localHosts.data(), 1,
+                              MPI_UINT32_T, nodeComm));
+    for (int l = 0; l < localNum; ++l) {
+      localIndex[localHosts[l]] = l;
+      if (l != localRank) {
+        shards[localHosts[l] % numShards].peers.push_back(l);
+      }
+    }
+
+    // segment names are unique to this run: the pid of the first local host
+    int token = getpid();
+    handleError(MPI_Bcast(&token, 1, MPI_INT, 0, nodeComm));
+
+    segmentSize = localNum * (RING_HEADER_SIZE + ringSize);
+    segments.assign(localNum, nullptr);
+
+    // create this host's segment and initialize the rings in it
+    std::string myName = segmentName(token, ID);
+    int created        = 0;
+    int fd = shm_open(myName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd != -1) {
+      if (ftruncate(fd, segmentSize) == 0) {
+        void* p = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) {
+          segments[localRank] = static_cast<uint8_t*>(p);
+          for (int l = 0; l < localNum; ++l) {
+            new (ringHeader(localRank, l)) RingHeader{{0}, {0}};
+          }
+          created = 1;
+        }
+      }
+      close(fd);
+    }
+    if (!created) {
+      galois::gWarn("[", ID, "] failed to create shared memory segment ",
+                    myName, " of ", segmentSize, " bytes");
+    }
+
+    int allCreated;
+    handleError(MPI_Allreduce(&created, &allCreated, 1, MPI_INT, MPI_MIN,
+                              nodeComm));
+
+    // map the segments of the other hosts on this machine
+    int mapped = allCreated;
+    for (int l = 0; mapped && l < localNum; ++l) {
+      if (l == localRank) {
+        continue;
+      }
+      int peer = shm_open(segmentName(token, localHosts[l]).c_str(), O_RDWR,
+                          0600);
+      if (peer == -1) {
+        mapped = 0;
+        break;
+      }
+      void* p = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, peer, 0);
+      close(peer);
+      if (p == MAP_FAILED) {
+        mapped = 0;
+        break;
+      }
+      segments[l] = static_cast<uint8_t*>(p);
+    }
+
+    handleError(MPI_Allreduce(&mapped, &allCreated, 1, MPI_INT, MPI_MIN,
+                              nodeComm));
+    // everyone has mapped the segments (or given up); the names are no
+    // longer needed and removing them now means nothing leaks on a crash
+    if (created) {
+      shm_unlink(myName.c_str());
+    }
+    ok = allCreated;
+
+    // built in place: the queues are not nothrow movable
+    sendQueues = std::vector<sendQueueTy>(localNum);
+    recvStates = std::vector<recvStateTy>(localNum);
+  }
+
+  virtual ~NetworkIOShm() {
+    for (auto s : segments) {
+      if (s) {
+        munmap(s, segmentSize);
+      }
+    }
+  }
+
+  /**
+   * Adds a message to the send queue of its destination.
+   */
+  virtual void enqueue(message m) {
+    int l = localIndex[m.host];
+    if (l == -1) {
+      remote->enqueue(std::move(m));
+      return;
+    }
+    memUsageTracker.incrementMemUsage(m.data.size());
+    sendQueues[l].pending.emplace_back(std::move(m));
+  }
+
+  /**
+   * Returns a received message of a shard, alternating between messages from
+   * hosts on this machine and from other machines when both are waiting.
+   */
+  virtual message dequeue(unsigned shard) {
+    auto& s        = shards[shard];
+    s.preferRemote = !s.preferRemote;
+    if (s.preferRemote) {
+      message m = remote->dequeue(shard);
+      if (m.valid() || s.done.empty()) {
+        return m;
+      }
+    }
+    if (!s.done.empty()) {
+      message m = std::move(s.done.front());
+      s.done.pop_front();
+      return m;
+    }
+    return remote->dequeue(shard);
+  }
+
+  /**
+   * Push progress forward on both the rings and MPI for a shard.
+   */
+  virtual void progress(unsigned shard) {
+    remote->progress(shard);
+    for (unsigned l : shards[shard].peers) {
+      pushLocal(l);
+      pullLocal(l);
+    }
+  }
+}; // end NetworkIOShm class
+
+} // namespace
+
+std::tuple<std::unique_ptr<galois::runtime::NetworkIO>, uint32_t, uint32_t>
+galois::runtime::makeNetworkIOShm(galois::runtime::MemUsageTracker& tracker,
+                                  std::atomic<size_t>& sends,
+                                  std::atomic<size_t>& recvs,
+                                  unsigned numShards) {
+  auto mpi     = makeNetworkIOMPI(tracker, sends, recvs, numShards);
+  uint32_t ID  = std::get<1>(mpi);
+  uint32_t NUM = std::get<2>(mpi);
+
+  // every host must make the same choice since the setup is collective
+  int enabled = 1;
+  galois::substrate::EnvCheck("GALOIS_SHM_NETWORK", enabled);
+  int ringKB = 8192;
+  galois::substrate::EnvCheck("GALOIS_SHM_RING_KB", ringKB);
+  if (!enabled || ringKB <= 0) {
+    return mpi;
+  }
+
+  MPI_Comm nodeComm;
+  int rc = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, ID,
+                               MPI_INFO_NULL, &nodeComm);
+  if (rc != MPI_SUCCESS) {
+    MPI_Abort(MPI_COMM_WORLD, rc);
+  }
+  int localNum;
+  MPI_Comm_size(nodeComm, &localNum);
+  if (localNum == 1) {
+    MPI_Comm_free(&nodeComm);
+    return mpi;
+  }
+
+  bool ok;
+  std::unique_ptr<galois::runtime::NetworkIO> n{new NetworkIOShm(
+      tracker, sends, recvs, std::move(std::get<0>(mpi)), ID, NUM, nodeComm,
+      size_t(ringKB) << 10, numShards, ok)};
+  MPI_Comm_free(&nodeComm);
+  if (!ok) {
+    galois::gWarn("[", ID, "] shared memory transport unavailable; ",
+                  "using MPI for all hosts");
+    // the MPI layer moved into the failed object; make a new one
+    n.reset();
+    return makeNetworkIOMPI(tracker, sends, recvs, numShards);
+  }
+  galois::gDebug("[", ID, "] sharing memory with ", localNum - 1,
+                 " hosts on this machine");
+  return std::make_tuple(std::move(n), ID, NUM);
+}
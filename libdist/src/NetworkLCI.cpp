@@ -30,6 +30,7 @@
 #include "galois/runtime/Network.h"
 #include "galois/runtime/NetworkIO.h"
 #include "galois/runtime/Tracer.h"
+#include "galois/substrate/Trace.h"
 #include "galois/runtime/LWCI.h"
 
 using vTy = galois::PODResizeableArray<uint8_t>;
@@ -112,6 +113,8 @@ class NetworkInterfaceLCI : public NetworkInterface {
 
 public:
   void workerThread() {
+    galois::substrate::traceThreadName("network");
+    galois::substrate::traceProcess(ID);
     // Initialize LWCI
     // makeNetworkIOLWCI(memUsageTracker, inflightSends, inflightRecvs);
     if (ID == 0)
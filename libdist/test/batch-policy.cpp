@@ -0,0 +1,135 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/gIO.h"
+#include "galois/runtime/BatchPolicy.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace galois::runtime;
+
+/**
+ * A send buffer driven by a simulated clock in microseconds
+ */
+struct Buffer {
+  BatchPolicy policy;
+  SendRate rate;
+  int64_t now    = 1000000;
+  size_t bytes   = 0;
+  int64_t oldest = 0;
+  //! messages in each flushed batch
+  std::vector<unsigned> batches;
+  std::vector<BatchPolicy::Decision> reasons;
+  unsigned pending = 0;
+
+  //! Queues count messages of msgBytes, one every gap microseconds
+  void fill(unsigned count, size_t msgBytes, int64_t gap) {
+    for (unsigned i = 0; i < count; ++i, now += gap) {
+      if (!bytes)
+        oldest = now;
+      bytes += msgBytes;
+      ++pending;
+      rate.add(now, msgBytes, policy.delay);
+      auto d =
+          policy.decide(bytes, now - oldest, rate.get(now, policy.delay), 0);
+      if (d != BatchPolicy::WAIT) {
+        batches.push_back(pending);
+        reasons.push_back(d);
+        bytes   = 0;
+        pending = 0;
+      }
+    }
+  }
+
+  //! Flushes what is left, e.g., when it times out during a pause
+  void clear() {
+    batches.clear();
+    reasons.clear();
+    bytes   = 0;
+    pending = 0;
+  }
+};
+
+int main() {
+  // steady traffic is batched up to the bytes expected within the delay
+  Buffer buf;
+  buf.fill(1000, 100, 1);
+  GALOIS_ASSERT(buf.batches.size() > 2);
+  for (size_t i = 0; i < buf.batches.size(); ++i) {
+    GALOIS_ASSERT(buf.reasons[i] != BatchPolicy::EARLY, "batch ", i,
+                  " of steady traffic flushed early");
+    GALOIS_ASSERT(buf.batches[i] > buf.policy.minBytes / 100, "batch ", i,
+                  " of steady traffic has ", buf.batches[i], " messages");
+  }
+
+  // a burst after an idle gap: the first messages of the burst are batched
+  // rather than flushed one at a time
+  buf.clear();
+  buf.now += 10 * buf.policy.delay;
+  buf.fill(200, 100, 1);
+  GALOIS_ASSERT(!buf.batches.empty());
+  GALOIS_ASSERT(buf.reasons[0] != BatchPolicy::EARLY,
+                "burst flushed early after ", buf.batches[0], " messages");
+  GALOIS_ASSERT(buf.batches[0] > buf.policy.minBytes / 100,
+                "burst flushed after ", buf.batches[0], " messages");
+
+  // the first message ever has no rate and waits for up to the delay
+  {
+    Buffer fresh;
+    fresh.fill(1, 100, 1);
+    GALOIS_ASSERT(fresh.batches.empty());
+    GALOIS_ASSERT(fresh.policy.decide(100, fresh.policy.delay + 1, 0.0, 0) ==
+                  BatchPolicy::TIMEOUT);
+  }
+
+  // sparse traffic with a known rate is not held back
+  {
+    Buffer sparse;
+    sparse.fill(10, 10, 20);
+    GALOIS_ASSERT(!sparse.batches.empty());
+    GALOIS_ASSERT(sparse.reasons.back() == BatchPolicy::EARLY &&
+                      sparse.batches.back() == 1,
+                  "sparse traffic flushed ", sparse.batches.back(),
+                  " messages with ", sparse.reasons.back());
+  }
+
+  // congestion disables early flushes and doubles the batch
+  {
+    BatchPolicy policy;
+    GALOIS_ASSERT(policy.decide(10, 0, 0.1, 0) == BatchPolicy::EARLY);
+    GALOIS_ASSERT(policy.decide(10, 0, 0.1, policy.congestedBytes + 1) ==
+                  BatchPolicy::WAIT);
+    GALOIS_ASSERT(policy.decide(policy.minBytes + 1, 0, 0.1,
+                                policy.congestedBytes + 1) ==
+                  BatchPolicy::WAIT);
+  }
+
+  // the adaptive policy waits for the bytes expected within the delay
+  {
+    BatchPolicy policy;
+    double rate = 100.0;
+    GALOIS_ASSERT(policy.decide(policy.minBytes + 1, 0, rate, 0) ==
+                  BatchPolicy::WAIT);
+    GALOIS_ASSERT(policy.decide(size_t(rate * policy.delay) + 1, 0, rate, 0) ==
+                  BatchPolicy::FULL);
+  }
+
+  return 0;
+}
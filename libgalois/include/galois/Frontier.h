@@ -0,0 +1,305 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file galois/Frontier.h
+ *
+ * Contains the Frontier class, a set of active nodes for level-synchronous
+ * algorithms, and the edgeMap/vertexMap operators over it.
+ */
+
+#ifndef GALOIS_FRONTIER_H
+#define GALOIS_FRONTIER_H
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "galois/config.h"
+#include "galois/Bag.h"
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+
+namespace galois {
+
+/**
+ * Set of active nodes of a graph that is stored either sparsely, as an
+ * InsertBag of node ids, or densely, as a DynamicBitSet over all nodes.
+ * Sparse storage is cheap for small frontiers and is what push-style
+ * traversal iterates over; dense storage gives pull-style traversal O(1)
+ * membership tests. The frontier converts between the two in parallel.
+ *
+ * add may be called concurrently; everything else must be called outside of
+ * parallel regions.
+ */
+class Frontier {
+public:
+  using NodeID = uint32_t;
+
+private:
+  InsertBag<NodeID> sparse;
+  DynamicBitSet dense;
+  GAccumulator<size_t> numActive;
+  size_t numNodes;
+  bool isDense_;
+
+public:
+  /**
+   * Creates an empty sparse frontier.
+   *
+   * @param n number of nodes in the graph
+   */
+  explicit Frontier(size_t n) : numNodes(n), isDense_(false) {}
+
+  //! Adds a node to the frontier; a node should be added at most once while
+  //! sparse, and is deduplicated while dense
+  void add(NodeID n) {
+    if (isDense_) {
+      if (!dense.set(n)) {
+        numActive += 1;
+      }
+    } else {
+      sparse.push(n);
+      numActive += 1;
+    }
+  }
+
+  //! Returns the number of active nodes
+  size_t size() { return numActive.reduce(); }
+
+  //! Returns true if no node is active
+  bool empty() { return size() == 0; }
+
+  //! Returns the number of nodes in the graph
+  size_t universe() const { return numNodes; }
+
+  //! Returns true if the frontier is stored as a bitset
+  bool isDense() const { return isDense_; }
+
+  //! Returns true if n is active; the frontier must be dense
+  bool contains(NodeID n) const {
+    assert(isDense_);
+    return dense.test(n);
+  }
+
+  //! The active nodes; the frontier must be sparse
+  InsertBag<NodeID>& getSparse() {
+    assert(!isDense_);
+    return sparse;
+  }
+
+  //! The active nodes; the frontier must be dense
+  DynamicBitSet& getDense() {
+    assert(isDense_);
+    return dense;
+  }
+
+  //! Removes all nodes, keeping the current representation
+  void clear() {
+    if (isDense_) {
+      dense.reset();
+    } else {
+      sparse.clear();
+    }
+    numActive.reset();
+  }
+
+  //! Switches to the bitset representation
+  void toDense() {
+    if (isDense_) {
+      return;
+    }
+    if (dense.size() != numNodes) {
+      dense.resize(numNodes);
+    } else {
+      dense.reset();
+    }
+    galois::do_all(
+        galois::iterate(sparse), [&](NodeID n) { dense.set(n); },
+        galois::steal(), galois::no_stats());
+    sparse.clear();
+    isDense_ = true;
+  }
+
+  //! Switches to the node id representation
+  void toSparse() {
+    if (!isDense_) {
+      return;
+    }
+    sparse.clear();
+    galois::do_all(
+        galois::iterate(size_t{0}, numNodes),
+        [&](size_t n) {
+          if (dense.test(n)) {
+            sparse.push(n);
+          }
+        },
+        galois::steal(), galois::no_stats());
+    isDense_ = false;
+  }
+
+  void swap(Frontier& other) {
+    size_t mySize    = size();
+    size_t otherSize = other.size();
+    numActive.reset();
+    other.numActive.reset();
+    numActive += otherSize;
+    other.numActive += mySize;
+
+    sparse.swap(other.sparse);
+    std::swap(dense, other.dense);
+    std::swap(numNodes, other.numNodes);
+    std::swap(isDense_, other.isDense_);
+  }
+};
+
+//! Traversal direction used by edgeMap
+enum class FrontierDirection {
+  AUTO, //!< choose per call from the size of the frontier
+  PUSH, //!< frontier nodes update their out-neighbors
+  PULL  //!< inactive nodes look for frontier nodes among their in-neighbors
+};
+
+namespace internal {
+
+template <typename Graph, typename = void>
+struct has_in_edges : std::false_type {};
+
+template <typename Graph>
+struct has_in_edges<Graph, std::void_t<decltype(std::declval<Graph&>().in_edges(
+                               typename Graph::GraphNode()))>>
+    : std::true_type {};
+
+} // namespace internal
+
+/**
+ * Applies f to every node of the frontier in parallel.
+ */
+template <typename F>
+void vertexMap(Frontier& frontier, const F& f) {
+  if (frontier.isDense()) {
+    DynamicBitSet& dense = frontier.getDense();
+    galois::do_all(
+        galois::iterate(size_t{0}, frontier.universe()),
+        [&](size_t n) {
+          if (dense.test(n)) {
+            f(Frontier::NodeID(n));
+          }
+        },
+        galois::steal(), galois::loopname("VertexMap"));
+  } else {
+    galois::do_all(galois::iterate(frontier.getSparse()), f, galois::steal(),
+                   galois::loopname("VertexMap"));
+  }
+}
+
+/**
+ * Computes the frontier reached from in over the edges of graph.
+ *
+ * For every edge (src, dst) with src in the frontier and cond(dst) true,
+ * update(src, dst) is called; dst joins out if it returns true. update may
+ * run concurrently for the same dst and must be atomic; it should return
+ * true at most once per dst (e.g., the winner of a compare-and-swap).
+ *
+ * The direction follows Beamer's heuristic as simplified by Ligra: if the
+ * frontier and its out-degrees together exceed |E| / denseThreshold, the
+ * step pulls over in-edges with a dense frontier, otherwise it pushes over
+ * out-edges with a sparse one. Pulling needs a graph with in-edges such as
+ * LC_CSR_CSC_Graph; other graphs always push.
+ *
+ * @param graph graph to traverse
+ * @param in current frontier; may be converted to the representation the
+ * chosen direction needs
+ * @param out next frontier; cleared before use
+ * @param update called on edges leading out of the frontier
+ * @param cond returns true if a node still wants updates
+ * @param dir direction to use, or AUTO
+ * @param denseThreshold controls the switch to pulling (Ligra uses 20)
+ * @returns the direction that was used
+ */
+template <typename Graph, typename UpdateFn, typename CondFn>
+FrontierDirection edgeMap(Graph& graph, Frontier& in, Frontier& out,
+                          const UpdateFn& update, const CondFn& cond,
+                          FrontierDirection dir   = FrontierDirection::AUTO,
+                          uint64_t denseThreshold = 20) {
+  using GNode = typename Graph::GraphNode;
+  constexpr galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
+  constexpr bool canPull            = internal::has_in_edges<Graph>::value;
+
+  if (!canPull) {
+    dir = FrontierDirection::PUSH;
+  } else if (dir == FrontierDirection::AUTO) {
+    GAccumulator<uint64_t> outDegrees;
+    vertexMap(in, [&](Frontier::NodeID n) {
+      outDegrees += std::distance(graph.edge_begin(n, flag),
+                                  graph.edge_end(n, flag));
+    });
+    dir = in.size() + outDegrees.reduce() > graph.sizeEdges() / denseThreshold
+              ? FrontierDirection::PULL
+              : FrontierDirection::PUSH;
+  }
+
+  if constexpr (canPull) {
+    if (dir == FrontierDirection::PULL) {
+      in.toDense();
+      out.toDense();
+      out.clear();
+      galois::do_all(
+          galois::iterate(graph),
+          [&](GNode dst) {
+            if (!cond(dst)) {
+              return;
+            }
+            for (auto e : graph.in_edges(dst, flag)) {
+              GNode src = graph.getInEdgeDst(e);
+              if (in.contains(src) && update(src, dst)) {
+                out.add(dst);
+              }
+              if (!cond(dst)) {
+                break;
+              }
+            }
+          },
+          galois::steal(), galois::loopname("EdgeMapPull"));
+      return dir;
+    }
+  }
+
+  in.toSparse();
+  out.toSparse();
+  out.clear();
+  galois::do_all(
+      galois::iterate(in.getSparse()),
+      [&](GNode src) {
+        for (auto e : graph.edges(src, flag)) {
+          GNode dst = graph.getEdgeDst(e);
+          if (cond(dst) && update(src, dst)) {
+            out.add(dst);
+          }
+        }
+      },
+      galois::steal(), galois::loopname("EdgeMapPush"));
+  return dir;
+}
+
+} // namespace galois
+
+#endif
@@ -23,6 +23,7 @@
 #include "galois/config.h"
 #include "galois/Loops.h"
 #include "galois/SharedMemSys.h"
+#include "galois/TaskGroup.h"
 #include "galois/runtime/Mem.h"
 
 #endif
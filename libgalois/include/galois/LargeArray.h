@@ -75,27 +75,27 @@ public:
 
 protected:
   enum AllocType { Blocked, Local, Interleaved, Floating };
-  void allocate(size_type n, AllocType t) {
+  void allocate(size_type n, AllocType t, substrate::PagePolicy p) {
     assert(!m_data);
     m_size = n;
     switch (t) {
     case Blocked:
       galois::gDebug("Block-alloc'd");
-      m_realdata =
-          substrate::largeMallocBlocked(n * sizeof(T), runtime::activeThreads);
+      m_realdata = substrate::largeMallocBlocked(n * sizeof(T),
+                                                 runtime::activeThreads, p);
       break;
     case Interleaved:
       galois::gDebug("Interleave-alloc'd");
-      m_realdata = substrate::largeMallocInterleaved(n * sizeof(T),
-                                                     runtime::activeThreads);
+      m_realdata = substrate::largeMallocInterleaved(
+          n * sizeof(T), runtime::activeThreads, p);
       break;
     case Local:
       galois::gDebug("Local-allocd");
-      m_realdata = substrate::largeMallocLocal(n * sizeof(T));
+      m_realdata = substrate::largeMallocLocal(n * sizeof(T), p);
       break;
     case Floating:
       galois::gDebug("Floating-alloc'd");
-      m_realdata = substrate::largeMallocFloating(n * sizeof(T));
+      m_realdata = substrate::largeMallocFloating(n * sizeof(T), p);
       break;
     };
     m_data = reinterpret_cast<T*>(m_realdata.get());
@@ -203,28 +203,43 @@ public:
 
   //! [allocatefunctions]
   //! Allocates interleaved across NUMA (memory) nodes.
-  void allocateInterleaved(size_type n) { allocate(n, Interleaved); }
+  void allocateInterleaved(
+      size_type n, substrate::PagePolicy p = substrate::PagePolicy::DEFAULT) {
+    allocate(n, Interleaved, p);
+  }
 
   /**
    * Allocates using blocked memory policy
    *
    * @param  n         number of elements to allocate
+   * @param  p         pages to back the allocation with
    */
-  void allocateBlocked(size_type n) { allocate(n, Blocked); }
+  void allocateBlocked(
+      size_type n, substrate::PagePolicy p = substrate::PagePolicy::DEFAULT) {
+    allocate(n, Blocked, p);
+  }
 
   /**
    * Allocates using Thread Local memory policy
    *
    * @param  n         number of elements to allocate
+   * @param  p         pages to back the allocation with
    */
-  void allocateLocal(size_type n) { allocate(n, Local); }
+  void allocateLocal(
+      size_type n, substrate::PagePolicy p = substrate::PagePolicy::DEFAULT) {
+    allocate(n, Local, p);
+  }
 
   /**
    * Allocates using no memory policy (no pre alloc)
    *
    * @param  n         number of elements to allocate
+   * @param  p         pages to back the allocation with
    */
-  void allocateFloating(size_type n) { allocate(n, Floating); }
+  void allocateFloating(
+      size_type n, substrate::PagePolicy p = substrate::PagePolicy::DEFAULT) {
+    allocate(n, Floating, p);
+  }
 
   /**
    * Allocate memory to threads based on a provided array specifying which
@@ -235,15 +250,17 @@ public:
    * @param numberOfElements Number of elements to allocate space for
    * @param threadRanges An array specifying how elements should be split
    * among threads
+   * @param p Pages to back the allocation with
    */
   template <typename RangeArrayTy>
-  void allocateSpecified(size_type numberOfElements,
-                         RangeArrayTy& threadRanges) {
+  void
+  allocateSpecified(size_type numberOfElements, RangeArrayTy& threadRanges,
+                    substrate::PagePolicy p = substrate::PagePolicy::DEFAULT) {
     assert(!m_data);
 
     m_realdata = substrate::largeMallocSpecified(numberOfElements * sizeof(T),
                                                  runtime::activeThreads,
-                                                 threadRanges, sizeof(T));
+                                                 threadRanges, sizeof(T), p);
 
     m_size = numberOfElements;
     m_data = reinterpret_cast<T*>(m_realdata.get());
@@ -341,12 +358,13 @@ public:
   iterator end() { return 0; }
   const_iterator end() const { return 0; }
 
-  void allocateInterleaved(size_type) {}
-  void allocateBlocked(size_type) {}
-  void allocateLocal(size_type, bool = true) {}
-  void allocateFloating(size_type) {}
+  void allocateInterleaved(size_type, substrate::PagePolicy = {}) {}
+  void allocateBlocked(size_type, substrate::PagePolicy = {}) {}
+  void allocateLocal(size_type, substrate::PagePolicy = {}) {}
+  void allocateFloating(size_type, substrate::PagePolicy = {}) {}
   template <typename RangeArrayTy>
-  void allocateSpecified(size_type, RangeArrayTy) {}
+  void allocateSpecified(size_type, RangeArrayTy,
+                         substrate::PagePolicy = {}) {}
 
   template <typename... Args>
   void construct(Args&&...) {}
@@ -30,6 +30,13 @@
 #include "galois/Threads.h"
 #include "galois/worklists/Chunk.h"
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace galois {
 //! Parallel versions of STL library algorithms.
 // TODO: rename to gstl?
@@ -264,6 +271,257 @@ void sort(RandomAccessIterator first, RandomAccessIterator last) {
           typename std::iterator_traits<RandomAccessIterator>::value_type>());
 }
 
+namespace internal {
+
+//! Scratch space for the out-of-place sorts; elements are constructed lazily
+//! by the first pass that writes them
+template <typename T>
+class SortBuffer {
+  std::allocator<T> alloc;
+  T* buf;
+  size_t num;
+  bool constructed = false;
+
+public:
+  explicit SortBuffer(size_t n) : buf(alloc.allocate(n)), num(n) {}
+
+  SortBuffer(const SortBuffer&) = delete;
+  SortBuffer& operator=(const SortBuffer&) = delete;
+
+  ~SortBuffer() {
+    if (constructed && !std::is_trivially_destructible<T>::value)
+      galois::do_all(galois::iterate(size_t{0}, num),
+                     [&](size_t i) { buf[i].~T(); });
+    alloc.deallocate(buf, num);
+  }
+
+  template <typename V>
+  void put(size_t i, V&& v) {
+    if (constructed)
+      buf[i] = std::forward<V>(v);
+    else
+      new (buf + i) T(std::forward<V>(v));
+  }
+
+  //! Call after every element has been put at least once
+  void setConstructed() { constructed = true; }
+
+  T& operator[](size_t i) { return buf[i]; }
+  T* begin() { return buf; }
+};
+
+//! [begin, end) of block i when n elements are split into numBlocks blocks
+inline std::pair<size_t, size_t> sortBlock(size_t n, size_t numBlocks,
+                                           size_t i) {
+  size_t blockSize = (n + numBlocks - 1) / numBlocks;
+  return std::make_pair(std::min(i * blockSize, n),
+                        std::min((i + 1) * blockSize, n));
+}
+
+} // namespace internal
+
+/**
+ * Parallel samplesort. Splitters are picked from a sorted random sample, every
+ * thread distributes a block of the input into buckets between splitters and
+ * the buckets are then sorted independently. Needs O(n) extra space but,
+ * unlike {@link sort}, no level of the recursion is sequential.
+ *
+ * Works with proxy iterators such as the edge sort iterators of the CSR
+ * graphs as long as their value_type is copy constructible.
+ */
+template <class RandomAccessIterator, class Compare>
+void sample_sort(RandomAccessIterator first, RandomAccessIterator last,
+                 Compare comp) {
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  const size_t size       = std::distance(first, last);
+  const size_t numThreads = galois::getActiveThreads();
+  if (size <= (1 << 16) || numThreads == 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  // oversampling keeps buckets within a small factor of size / numBuckets
+  const size_t numBuckets = numThreads * 8;
+  const size_t oversample = 32;
+  std::vector<T> samples;
+  samples.reserve(numBuckets * oversample);
+  std::mt19937_64 gen(size);
+  for (size_t i = 0; i < numBuckets * oversample; ++i)
+    samples.push_back(*(first + gen() % size));
+  std::sort(samples.begin(), samples.end(), comp);
+  std::vector<T> splitters;
+  splitters.reserve(numBuckets - 1);
+  for (size_t i = 1; i < numBuckets; ++i)
+    splitters.push_back(samples[i * oversample]);
+  samples.clear();
+
+  const size_t numBlocks = numThreads;
+  std::vector<uint32_t> bucketOf(size);
+  std::vector<size_t> counts(numBlocks * numBuckets);
+  galois::do_all(
+      galois::iterate(size_t{0}, numBlocks),
+      [&](size_t block) {
+        auto range   = internal::sortBlock(size, numBlocks, block);
+        size_t* mine = &counts[block * numBuckets];
+        for (size_t i = range.first; i < range.second; ++i) {
+          T value     = *(first + i);
+          bucketOf[i] = std::upper_bound(splitters.begin(), splitters.end(),
+                                         value, comp) -
+                        splitters.begin();
+          ++mine[bucketOf[i]];
+        }
+      },
+      galois::no_stats());
+
+  // bucket-major offsets: bucket b of block k follows bucket b of block k - 1
+  std::vector<size_t> bucketStarts(numBuckets + 1);
+  size_t offset = 0;
+  for (size_t b = 0; b < numBuckets; ++b) {
+    bucketStarts[b] = offset;
+    for (size_t block = 0; block < numBlocks; ++block) {
+      size_t count                   = counts[block * numBuckets + b];
+      counts[block * numBuckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucketStarts[numBuckets] = offset;
+
+  internal::SortBuffer<T> buffer(size);
+  galois::do_all(
+      galois::iterate(size_t{0}, numBlocks),
+      [&](size_t block) {
+        auto range   = internal::sortBlock(size, numBlocks, block);
+        size_t* next = &counts[block * numBuckets];
+        for (size_t i = range.first; i < range.second; ++i)
+          buffer.put(next[bucketOf[i]]++, T(*(first + i)));
+      },
+      galois::no_stats());
+  buffer.setConstructed();
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numBuckets),
+      [&](size_t b) {
+        std::sort(buffer.begin() + bucketStarts[b],
+                  buffer.begin() + bucketStarts[b + 1], comp);
+      },
+      galois::steal(), galois::chunk_size<1>(), galois::no_stats());
+
+  galois::do_all(
+      galois::iterate(size_t{0}, size),
+      [&](size_t i) { *(first + i) = std::move(buffer[i]); },
+      galois::no_stats());
+}
+
+template <class RandomAccessIterator>
+void sample_sort(RandomAccessIterator first, RandomAccessIterator last) {
+  galois::ParallelSTL::sample_sort(
+      first, last,
+      std::less<
+          typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+/**
+ * Parallel stable LSD radix sort by an unsigned integer key, one byte per
+ * pass. Passes over bytes that are zero in every key are skipped, so sorting
+ * edges by a 32-bit destination in a graph with fewer than 2^24 nodes takes
+ * three passes. Each pass builds per-thread histograms and scatters blocks of
+ * the input in order, which keeps the sort stable.
+ *
+ * @param key functor from value_type to an unsigned integer type
+ */
+template <class RandomAccessIterator, class KeyFn>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                KeyFn key) {
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  using K = std::decay_t<decltype(key(std::declval<const T&>()))>;
+  static_assert(std::is_unsigned<K>::value,
+                "radix_sort requires unsigned integer keys");
+
+  const size_t size = std::distance(first, last);
+  if (size <= (1 << 12)) {
+    // copy out since std::stable_sort does not accept proxy iterators
+    std::vector<T> values(first, last);
+    std::stable_sort(values.begin(), values.end(),
+                     [&](const T& a, const T& b) { return key(a) < key(b); });
+    std::copy(values.begin(), values.end(), first);
+    return;
+  }
+
+  constexpr unsigned digitBits = 8;
+  constexpr size_t radix       = size_t{1} << digitBits;
+  const size_t numBlocks       = galois::getActiveThreads();
+
+  internal::SortBuffer<T> bufferA(size);
+  internal::SortBuffer<T> bufferB(size);
+  galois::GReduceMax<K> maxKey;
+  galois::do_all(
+      galois::iterate(size_t{0}, size),
+      [&](size_t i) {
+        bufferA.put(i, T(*(first + i)));
+        maxKey.update(key(bufferA[i]));
+      },
+      galois::no_stats());
+  bufferA.setConstructed();
+
+  unsigned numPasses = 0;
+  while (numPasses * digitBits < sizeof(K) * 8 &&
+         (maxKey.reduce() >> (numPasses * digitBits)) != 0)
+    ++numPasses;
+
+  internal::SortBuffer<T>* src = &bufferA;
+  internal::SortBuffer<T>* dst = &bufferB;
+  std::vector<size_t> counts(numBlocks * radix);
+  for (unsigned pass = 0; pass < numPasses; ++pass) {
+    const unsigned shift = pass * digitBits;
+    auto digit = [&](const T& v) { return (key(v) >> shift) & (radix - 1); };
+
+    std::fill(counts.begin(), counts.end(), 0);
+    galois::do_all(
+        galois::iterate(size_t{0}, numBlocks),
+        [&](size_t block) {
+          auto range   = internal::sortBlock(size, numBlocks, block);
+          size_t* mine = &counts[block * radix];
+          for (size_t i = range.first; i < range.second; ++i)
+            ++mine[digit((*src)[i])];
+        },
+        galois::no_stats());
+
+    size_t offset = 0;
+    for (size_t d = 0; d < radix; ++d) {
+      for (size_t block = 0; block < numBlocks; ++block) {
+        size_t count              = counts[block * radix + d];
+        counts[block * radix + d] = offset;
+        offset += count;
+      }
+    }
+
+    galois::do_all(
+        galois::iterate(size_t{0}, numBlocks),
+        [&](size_t block) {
+          auto range   = internal::sortBlock(size, numBlocks, block);
+          size_t* next = &counts[block * radix];
+          for (size_t i = range.first; i < range.second; ++i)
+            dst->put(next[digit((*src)[i])]++, std::move((*src)[i]));
+        },
+        galois::no_stats());
+    dst->setConstructed();
+    std::swap(src, dst);
+  }
+
+  galois::do_all(
+      galois::iterate(size_t{0}, size),
+      [&](size_t i) { *(first + i) = std::move((*src)[i]); },
+      galois::no_stats());
+}
+
+//! radix_sort of unsigned integers by value
+template <class RandomAccessIterator>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  galois::ParallelSTL::radix_sort(first, last, [](const T& v) { return v; });
+}
+
 template <class InputIterator, class T, typename BinaryOperation>
 T accumulate(InputIterator first, InputIterator last, const T& identity,
              const BinaryOperation& binary_op) {
@@ -297,14 +555,15 @@ T map_reduce(InputIterator first, InputIterator last, MapFn map_fn,
 }
 
 template <typename I>
-std::enable_if_t<!std::is_scalar<internal::Val_ty<I>>::value> destroy(I first,
-                                                                      I last) {
-  using T = internal::Val_ty<I>;
+std::enable_if_t<!std::is_scalar<galois::internal::Val_ty<I>>::value>
+destroy(I first, I last) {
+  using T = galois::internal::Val_ty<I>;
   do_all(iterate(first, last), [=](T& i) { (&i)->~T(); });
 }
 
 template <class I>
-std::enable_if_t<std::is_scalar<internal::Val_ty<I>>::value> destroy(I, I) {}
+std::enable_if_t<std::is_scalar<galois::internal::Val_ty<I>>::value>
+destroy(I, I) {}
 
 /**
  * Does a partial sum from first -> last and writes the results to the d_first
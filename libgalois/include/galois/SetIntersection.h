@@ -0,0 +1,83 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file galois/SetIntersection.h
+ *
+ * Intersection of sorted neighbor lists, the inner loop of triangle counting,
+ * k-truss and subgraph mining. The kernels compare blocks of both lists with
+ * AVX2 or AVX-512 when the CPU supports them and switch to galloping search
+ * when one list is much shorter than the other.
+ */
+
+#ifndef GALOIS_SET_INTERSECTION_H
+#define GALOIS_SET_INTERSECTION_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+
+//! Implementation used by the intersection routines
+enum class IntersectKernel { SCALAR, AVX2, AVX512 };
+
+//! Name of a kernel for statistics and logging
+const char* intersectKernelName(IntersectKernel kernel);
+
+//! True if the kernel was compiled in and this CPU can execute it
+bool intersectKernelSupported(IntersectKernel kernel);
+
+/**
+ * Kernel used by intersectCount and intersect. It is the widest supported
+ * one unless the environment variable GALOIS_INTERSECT_KERNEL names another
+ * supported kernel (scalar, avx2 or avx512).
+ */
+IntersectKernel intersectKernel();
+
+/**
+ * Number of elements common to a[0, na) and b[0, nb).
+ *
+ * Both inputs must be sorted in increasing order and must not contain
+ * duplicates; for multisets the vectorized kernels may count an element more
+ * than once.
+ */
+size_t intersectCount(const uint32_t* a, size_t na, const uint32_t* b,
+                      size_t nb);
+
+/**
+ * Writes the elements common to a[0, na) and b[0, nb) to out in increasing
+ * order and returns their number. out must have room for min(na, nb)
+ * elements. Same preconditions as intersectCount.
+ */
+size_t intersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                 uint32_t* out);
+
+//! intersectCount with an explicit kernel; it must be supported
+size_t intersectCount(IntersectKernel kernel, const uint32_t* a, size_t na,
+                      const uint32_t* b, size_t nb);
+
+//! intersect with an explicit kernel; it must be supported
+size_t intersect(IntersectKernel kernel, const uint32_t* a, size_t na,
+                 const uint32_t* b, size_t nb, uint32_t* out);
+
+} // namespace galois
+
+#endif
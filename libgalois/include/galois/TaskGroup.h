@@ -0,0 +1,190 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file TaskGroup.h
+ *
+ * Task graphs with dependencies, run on the Galois thread pool.
+ */
+
+#ifndef GALOIS_TASKGROUP_H
+#define GALOIS_TASKGROUP_H
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Threads.h"
+#include "galois/runtime/TaskScheduler.h"
+
+namespace galois {
+
+class TaskGroup;
+
+/**
+ * Handle to a task spawned in a TaskGroup. It names the task as a
+ * dependency of later tasks and, for tasks that return a value, gives
+ * access to the value once the task has finished: after TaskGroup::wait,
+ * or from a task that depends on it.
+ */
+template <typename T>
+class TaskHandle {
+  friend class TaskGroup;
+  template <typename>
+  friend class TaskHandle;
+
+  struct Result {
+    std::optional<T> value;
+  };
+
+  std::shared_ptr<runtime::Task> task;
+  std::shared_ptr<Result> result;
+
+public:
+  TaskHandle() = default;
+
+  bool isDone() const { return task && task->isDone(); }
+
+  T& get() const {
+    assert(isDone());
+    return *result->value;
+  }
+};
+
+template <>
+class TaskHandle<void> {
+  friend class TaskGroup;
+
+  std::shared_ptr<runtime::Task> task;
+
+public:
+  TaskHandle() = default;
+
+  template <typename T>
+  TaskHandle(const TaskHandle<T>& h) : task(h.task) {}
+
+  bool isDone() const { return task && task->isDone(); }
+};
+
+/**
+ * A TaskGroup runs a graph of tasks: independent tasks run in parallel and a
+ * task spawned with dependencies starts only after all of them finish. This
+ * lets independent phases of an algorithm, e.g., building two graph
+ * transforms or reading input while computing, overlap instead of being
+ * separated by the barrier at the end of each loop.
+ *
+ *   galois::TaskGroup tg;
+ *   auto a = tg.spawn([&] { return buildTranspose(g); });
+ *   auto b = tg.spawn([&] { galois::do_all(..., fn); });
+ *   tg.spawn([&] { merge(a.get()); }, a, b);
+ *   tg.wait();
+ *
+ * Tasks run on the active threads of the thread pool, which all execute one
+ * run for the duration of wait(). Inside a task, galois::do_all is split
+ * into tasks of the same group that idle threads pick up, and on_each runs
+ * on the calling thread only, so nesting loops in tasks never starts more
+ * threads than are active. Other executors (for_each, etc.) cannot be
+ * nested in a task.
+ *
+ * Tasks may spawn more tasks. A TaskGroup created inside a task schedules
+ * on the threads of the enclosing one, and its wait() runs other tasks
+ * while its own are pending.
+ */
+class TaskGroup {
+  std::unique_ptr<runtime::TaskScheduler> owned;
+  runtime::TaskScheduler* sched;
+  std::atomic<size_t> outstanding{0};
+
+  template <typename F, typename R>
+  struct FnTask : public runtime::Task {
+    F fn;
+    std::shared_ptr<typename TaskHandle<R>::Result> result;
+
+    FnTask(F&& f, std::shared_ptr<typename TaskHandle<R>::Result> r)
+        : fn(std::move(f)), result(std::move(r)) {}
+
+    void execute() override { result->value.emplace(fn()); }
+  };
+
+  template <typename F>
+  struct FnTask<F, void> : public runtime::Task {
+    F fn;
+
+    explicit FnTask(F&& f) : fn(std::move(f)) {}
+
+    void execute() override { fn(); }
+  };
+
+public:
+  TaskGroup() : sched(runtime::TaskScheduler::current()) {
+    if (!sched) {
+      owned = std::make_unique<runtime::TaskScheduler>(getActiveThreads());
+      sched = owned.get();
+    }
+  }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  ~TaskGroup() { wait(); }
+
+  /**
+   * Adds a task running fn() once the tasks in deps have finished. Outside a
+   * task, nothing runs before wait() is called.
+   */
+  template <typename F, typename... Deps>
+  auto spawn(F&& fn, const TaskHandle<Deps>&... deps) {
+    using R  = std::invoke_result_t<std::decay_t<F>&>;
+    using Fn = std::decay_t<F>;
+
+    TaskHandle<R> h;
+    if constexpr (std::is_void_v<R>) {
+      h.task = std::make_shared<FnTask<Fn, void>>(Fn(std::forward<F>(fn)));
+    } else {
+      h.result = std::make_shared<typename TaskHandle<R>::Result>();
+      h.task =
+          std::make_shared<FnTask<Fn, R>>(Fn(std::forward<F>(fn)), h.result);
+    }
+    sched->submit(h.task, outstanding, {deps.task...});
+    return h;
+  }
+
+  /**
+   * Runs tasks until every task of this group has finished.
+   */
+  void wait() {
+    if (outstanding.load() == 0) {
+      return;
+    }
+    if (owned) {
+      owned->run(outstanding);
+    } else {
+      sched->helpUntil(outstanding);
+    }
+  }
+};
+
+} // namespace galois
+
+#endif
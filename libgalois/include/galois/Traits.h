@@ -366,6 +366,20 @@ public:
   chunk_size(unsigned cs = SZ) : trait_has_value(clamp(cs)) {}
 };
 
+/**
+ * Let the loop executor grow and shrink the chunk size of each thread at
+ * runtime. The size starts at the {@link chunk_size} of the loop, doubles
+ * while chunks finish quickly and halves when chunks run long or a thread has
+ * to steal work. The sizes picked are reported in the loop statistics.
+ *
+ * Implies {@link steal} for {@link do_all()} loops. For {@link for_each()}
+ * loops, the chunked worklists in galois/worklists/Chunk.h adapt the number
+ * of items they put in a chunk, up to their compile-time chunk size; other
+ * worklists ignore this trait.
+ */
+struct adaptive_chunk_tag {};
+struct adaptive_chunk : public trait_has_type<bool>, adaptive_chunk_tag {};
+
 typedef worklists::PerSocketChunkFIFO<chunk_size<>::value> defaultWL;
 
 namespace internal {
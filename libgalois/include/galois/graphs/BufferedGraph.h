@@ -26,7 +26,14 @@
 #ifndef GALOIS_GRAPHS_BUFGRAPH_H
 #define GALOIS_GRAPHS_BUFGRAPH_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -41,6 +48,11 @@ namespace graphs {
  * Class that loads a portion of a Galois graph from disk directly into
  * memory buffers for access.
  *
+ * Edge destinations and edge data can also be loaded asynchronously (see
+ * loadPartialGraphAsync): a reader thread streams them in fixed-size windows
+ * while callers already use the edges that have arrived, waiting only when
+ * they get ahead of the reader.
+ *
  * @tparam EdgeDataType type of the edge data
  * @todo version 2 Galois binary graph support; currently only suppports
  * version 1
@@ -75,6 +87,17 @@ private:
   //! specifies whether or not the graph is loaded
   bool graphLoaded = false;
 
+  //! number of local edges whose destination and data are in memory
+  std::atomic<uint64_t> edgesReady{0};
+  //! streams edges for asynchronous loads
+  std::thread readerThread;
+  //! bytes of edge destinations and edge data read by the reader thread
+  uint64_t asyncBytesRead = 0;
+  //! microseconds the reader thread spent reading
+  uint64_t asyncReadTime = 0;
+  //! nanoseconds callers spent waiting for the reader thread
+  galois::GAccumulator<uint64_t> stallTime;
+
   // accumulators for tracking bytes read
   //! number of bytes read related to the out index buffer
   galois::GAccumulator<uint64_t> numBytesReadOutIndex;
@@ -237,11 +260,87 @@ private:
     // do nothing (edge data is void, i.e. no edge data)
   }
 
+  //! Byte offset of the destination of a global edge in a version 1 file
+  static uint64_t edgeDestPosition(uint64_t edge, uint64_t numGlobalNodes) {
+    return (4 + numGlobalNodes) * sizeof(uint64_t) + sizeof(uint32_t) * edge;
+  }
+
+  //! Byte offset of the data of a global edge in a version 1 file
+  template <typename EdgeType>
+  static uint64_t edgeDataPosition(uint64_t edge, uint64_t numGlobalNodes,
+                                   uint64_t numGlobalEdges) {
+    // version 1 padding TODO make version agnostic
+    return edgeDestPosition(numGlobalEdges + numGlobalEdges % 2,
+                            numGlobalNodes) +
+           sizeof(EdgeType) * edge;
+  }
+
+  //! pread exactly len bytes at offset into buf
+  static void preadFully(int fd, void* buf, uint64_t len, uint64_t offset) {
+    char* ptr = static_cast<char*>(buf);
+    while (len > 0) {
+      ssize_t numRead = pread(fd, ptr, len, offset);
+      if (numRead <= 0) {
+        GALOIS_SYS_DIE("failed reading graph file");
+      }
+      ptr += numRead;
+      offset += numRead;
+      len -= numRead;
+    }
+  }
+
+  /**
+   * Body of the reader thread for asynchronous loads: reads edge destinations
+   * and edge data window by window and publishes each window by advancing
+   * edgesReady.
+   */
+  void streamEdges(int fd, uint64_t numGlobalNodes, uint64_t numGlobalEdges,
+                   uint64_t windowEdges) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t e = 0; e < numLocalEdges; e += windowEdges) {
+      uint64_t count = std::min(windowEdges, numLocalEdges - e);
+      preadFully(fd, edgeDestBuffer + e, count * sizeof(uint32_t),
+                 edgeDestPosition(edgeOffset + e, numGlobalNodes));
+      asyncBytesRead += count * sizeof(uint32_t);
+      if constexpr (!std::is_void<EdgeDataType>::value) {
+        preadFully(fd, edgeDataBuffer + e, count * sizeof(EdgeDataType),
+                   edgeDataPosition<EdgeDataType>(
+                       edgeOffset + e, numGlobalNodes, numGlobalEdges));
+        asyncBytesRead += count * sizeof(EdgeDataType);
+      }
+      edgesReady.store(e + count, std::memory_order_release);
+    }
+    close(fd);
+
+    asyncReadTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  }
+
+  //! Waits until the reader thread has loaded the given local edge
+  void waitForEdge(uint64_t localEdgeID) {
+    if (localEdgeID < edgesReady.load(std::memory_order_acquire)) {
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    while (localEdgeID >= edgesReady.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    stallTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  }
+
   /**
    * Resets graph metadata to default values. Does NOT touch the buffers.
    */
   void resetGraphStatus() {
     graphLoaded    = false;
+    edgesReady     = 0;
+    asyncBytesRead = 0;
+    asyncReadTime  = 0;
+    stallTime.reset();
     globalSize     = 0;
     globalEdgeSize = 0;
     nodeOffset     = 0;
@@ -273,7 +372,10 @@ public:
   /**
    * On destruction, free allocated buffers (if necessary).
    */
-  ~BufferedGraph() noexcept { freeMemory(); }
+  ~BufferedGraph() noexcept {
+    waitForLoad();
+    freeMemory();
+  }
 
   // copy not allowed
   //! disabled copy constructor
@@ -326,6 +428,7 @@ public:
     // may or may not do something depending on EdgeDataType
     loadEdgeData<EdgeDataType>(graphFile, 0, globalEdgeSize, globalSize,
                                globalEdgeSize);
+    edgesReady  = numLocalEdges;
     graphLoaded = true;
 
     graphFile.close();
@@ -368,11 +471,111 @@ public:
     // may or may not do something depending on EdgeDataType
     loadEdgeData<EdgeDataType>(graphFile, edgeStart, numLocalEdges,
                                numGlobalNodes, numGlobalEdges);
+    edgesReady  = numLocalEdges;
     graphLoaded = true;
 
     graphFile.close();
   }
 
+  /**
+   * Same as loadPartialGraph, except that only the out indices are read
+   * before returning. Edge destinations and edge data are streamed in
+   * windows of about windowBytes by a reader thread; edgeDestination and
+   * edgeData wait for the reader if the requested edge has not arrived yet.
+   *
+   * @param filename name of graph to load; should be in Galois binary graph
+   * format
+   * @param nodeStart First node to load
+   * @param nodeEnd Last node to load, non-inclusive
+   * @param edgeStart First edge to load; should correspond to first edge of
+   * first node
+   * @param edgeEnd Last edge to load, non-inclusive
+   * @param numGlobalNodes Total number of nodes in the graph
+   * @param numGlobalEdges Total number of edges in the graph
+   * @param windowBytes Bytes of edge destinations and data read at a time
+   */
+  void loadPartialGraphAsync(const std::string& filename, uint64_t nodeStart,
+                             uint64_t nodeEnd, uint64_t edgeStart,
+                             uint64_t edgeEnd, uint64_t numGlobalNodes,
+                             uint64_t numGlobalEdges,
+                             uint64_t windowBytes = 16 * 1024 * 1024) {
+    if (graphLoaded) {
+      GALOIS_DIE("Cannot load an buffered graph more than once.");
+    }
+
+    std::ifstream graphFile(filename.c_str());
+
+    globalSize     = numGlobalNodes;
+    globalEdgeSize = numGlobalEdges;
+
+    assert(nodeEnd >= nodeStart);
+    numLocalNodes = nodeEnd - nodeStart;
+    loadOutIndex(graphFile, nodeStart, numLocalNodes);
+    graphFile.close();
+
+    assert(edgeEnd >= edgeStart);
+    numLocalEdges = edgeEnd - edgeStart;
+    edgeOffset    = edgeStart;
+    edgesReady    = 0;
+    graphLoaded   = true;
+
+    if (numLocalEdges == 0) {
+      return;
+    }
+
+    assert(edgeDestBuffer == nullptr);
+    edgeDestBuffer = (uint32_t*)malloc(sizeof(uint32_t) * numLocalEdges);
+    if (edgeDestBuffer == nullptr) {
+      GALOIS_DIE("Failed to allocate memory for edge dest buffer.");
+    }
+    size_t edgeBytes = sizeof(uint32_t);
+    if constexpr (!std::is_void<EdgeDataType>::value) {
+      assert(edgeDataBuffer == nullptr);
+      edgeDataBuffer =
+          (EdgeDataType*)malloc(sizeof(EdgeDataType) * numLocalEdges);
+      if (edgeDataBuffer == nullptr) {
+        GALOIS_DIE("Failed to allocate memory for edge data buffer.");
+      }
+      edgeBytes += sizeof(EdgeDataType);
+    }
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      GALOIS_SYS_DIE("failed opening ", "'", filename, "'");
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    uint64_t windowEdges = std::max<uint64_t>(windowBytes / edgeBytes, 1);
+    readerThread = std::thread(&BufferedGraph::streamEdges, this, fd,
+                               numGlobalNodes, numGlobalEdges, windowEdges);
+  }
+
+  /**
+   * Blocks until an asynchronous load has read all edges. Returns
+   * immediately for synchronous loads.
+   */
+  void waitForLoad() {
+    if (readerThread.joinable()) {
+      readerThread.join();
+    }
+  }
+
+  //! @returns bytes of edges read by the last asynchronous load
+  uint64_t getAsyncBytesRead() {
+    waitForLoad();
+    return asyncBytesRead;
+  }
+
+  //! @returns microseconds the last asynchronous load spent reading edges
+  uint64_t getAsyncReadTime() {
+    waitForLoad();
+    return asyncReadTime;
+  }
+
+  //! @returns microseconds callers spent waiting for edges to arrive
+  uint64_t getStallTime() { return stallTime.reduce() / 1000; }
+
   //! Edge iterator typedef
   using EdgeIterator = boost::counting_iterator<uint64_t>;
   /**
@@ -448,6 +651,7 @@ public:
     numBytesReadEdgeDest += sizeof(uint32_t);
 
     uint64_t localEdgeID = globalEdgeID - edgeOffset;
+    waitForEdge(localEdgeID);
     return edgeDestBuffer[localEdgeID];
   }
 
@@ -477,6 +681,7 @@ public:
     numBytesReadEdgeData += sizeof(EdgeDataType);
 
     uint64_t localEdgeID = globalEdgeID - edgeOffset;
+    waitForEdge(localEdgeID);
     return edgeDataBuffer[localEdgeID];
   }
 
@@ -514,6 +719,7 @@ public:
    * Free all of the in memory buffers in this object and reset graph status.
    */
   void resetAndFree() {
+    waitForLoad();
     freeMemory();
     resetGraphStatus();
   }
@@ -177,6 +177,11 @@ private:
   size_t findIndex(size_t nodeSize, size_t edgeSize, size_t targetSize,
                    size_t lb, size_t ub);
 
+  /**
+   * Maps the file lazily and pages it in with all threads of the thread
+   * pool, each taking a node range (see pageInByNode), instead of faulting
+   * it in on one thread with MAP_POPULATE. Reports the page in bandwidth.
+   */
   void fromFileInterleaved(const std::string& filename, size_t sizeofEdgeData);
 
   /**
@@ -569,6 +574,9 @@ public:
   //! Returns the size of an edge
   size_t edgeSize() const { return sizeofEdge; }
 
+  //! Returns the gr version of the graph (1: 32-bit destinations, 2: 64-bit)
+  int getGraphVersion() const { return graphVersion; }
+
   /**
    * Default file graph constructor which initializes fields to null values.
    */
@@ -602,8 +610,10 @@ public:
    * be a graph with some specific layout.
    *
    * @param filename Graph file to load
+   * @param populate If false, pages are faulted in on first access instead of
+   * when mapping the file
    */
-  void fromFile(const std::string& filename);
+  void fromFile(const std::string& filename, bool populate = true);
 
   /**
    * Loads/mmaps particular portions of a graph corresponding to a node
@@ -664,6 +674,14 @@ public:
    * @todo perform host -> le on data
    */
   void toFile(const std::string& file);
+
+  /**
+   * Like toFile, but returns false instead of aborting when the file cannot
+   * be written; errno then describes the failure.
+   *
+   * @param file File to write to
+   */
+  bool tryToFile(const std::string& file);
 };
 
 /**
@@ -824,6 +842,109 @@ void makeSymmetric(FileGraph& in_graph, FileGraph& out) {
   out = std::move(g);
 }
 
+/**
+ * Reverses the edges of a graph. Edge data is copied from the original edge.
+ * The new graph is placed in the out parameter. The previous out is destroyed.
+ */
+template <typename EdgeTy>
+void transpose(FileGraph& in_graph, FileGraph& out) {
+  typedef FileGraph::GraphNode GNode;
+
+  FileGraphWriter g;
+
+  g.setNumNodes(in_graph.size());
+  g.setNumEdges<EdgeTy>(in_graph.sizeEdges());
+
+  g.phase1();
+  for (FileGraph::iterator ii = in_graph.begin(), ei = in_graph.end(); ii != ei;
+       ++ii) {
+    for (FileGraph::edge_iterator jj = in_graph.edge_begin(*ii),
+                                  ej = in_graph.edge_end(*ii);
+         jj != ej; ++jj) {
+      g.incrementDegree(in_graph.getEdgeDst(jj));
+    }
+  }
+
+  g.phase2();
+  for (FileGraph::iterator ii = in_graph.begin(), ei = in_graph.end(); ii != ei;
+       ++ii) {
+    GNode src = *ii;
+    for (FileGraph::edge_iterator jj = in_graph.edge_begin(src),
+                                  ej = in_graph.edge_end(src);
+         jj != ej; ++jj) {
+      GNode dst = in_graph.getEdgeDst(jj);
+      if constexpr (std::is_void<EdgeTy>::value) {
+        g.addNeighbor(dst, src);
+      } else {
+        g.addNeighbor<EdgeTy>(dst, src, in_graph.getEdgeData<EdgeTy>(jj));
+      }
+    }
+  }
+
+  g.finish();
+
+  out = std::move(g);
+}
+
+/**
+ * Copies a graph without the edges whose source and destination are the
+ * same node. The new graph is placed in the out parameter. The previous out
+ * is destroyed.
+ */
+template <typename EdgeTy>
+void removeSelfLoops(FileGraph& in_graph, FileGraph& out) {
+  typedef FileGraph::GraphNode GNode;
+
+  FileGraphWriter g;
+
+  size_t numEdges = 0;
+  for (FileGraph::iterator ii = in_graph.begin(), ei = in_graph.end(); ii != ei;
+       ++ii) {
+    for (FileGraph::edge_iterator jj = in_graph.edge_begin(*ii),
+                                  ej = in_graph.edge_end(*ii);
+         jj != ej; ++jj) {
+      if (in_graph.getEdgeDst(jj) != *ii)
+        numEdges += 1;
+    }
+  }
+
+  g.setNumNodes(in_graph.size());
+  g.setNumEdges<EdgeTy>(numEdges);
+
+  g.phase1();
+  for (FileGraph::iterator ii = in_graph.begin(), ei = in_graph.end(); ii != ei;
+       ++ii) {
+    for (FileGraph::edge_iterator jj = in_graph.edge_begin(*ii),
+                                  ej = in_graph.edge_end(*ii);
+         jj != ej; ++jj) {
+      if (in_graph.getEdgeDst(jj) != *ii)
+        g.incrementDegree(*ii);
+    }
+  }
+
+  g.phase2();
+  for (FileGraph::iterator ii = in_graph.begin(), ei = in_graph.end(); ii != ei;
+       ++ii) {
+    GNode src = *ii;
+    for (FileGraph::edge_iterator jj = in_graph.edge_begin(src),
+                                  ej = in_graph.edge_end(src);
+         jj != ej; ++jj) {
+      GNode dst = in_graph.getEdgeDst(jj);
+      if (dst == src)
+        continue;
+      if constexpr (std::is_void<EdgeTy>::value) {
+        g.addNeighbor(src, dst);
+      } else {
+        g.addNeighbor<EdgeTy>(src, dst, in_graph.getEdgeData<EdgeTy>(jj));
+      }
+    }
+  }
+
+  g.finish();
+
+  out = std::move(g);
+}
+
 /**
  * Permutes a graph.
  *
@@ -0,0 +1,125 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file GatherPrefetch.h
+ *
+ * Edge visitors for pull-style kernels that prefetch the data of upcoming
+ * edge destinations.
+ */
+
+#ifndef GALOIS_GRAPHS_GATHERPREFETCH_H
+#define GALOIS_GRAPHS_GATHERPREFETCH_H
+
+#include <type_traits>
+
+#include "galois/config.h"
+#include "galois/MethodFlags.h"
+#include "galois/substrate/CompilerSpecific.h"
+
+namespace galois {
+namespace graphs {
+
+/**
+ * Visits the edges of a node, prefetching the data of the destination
+ * distance edges ahead of the one being visited. Pull kernels read data of
+ * random destinations, and with only one neighbor list in flight the core
+ * spends most of its time waiting on DRAM; running the prefetches ahead keeps
+ * distance misses outstanding instead.
+ *
+ * In CSR graphs the edges of consecutive nodes are contiguous, so the
+ * prefetch window runs on into the neighbor lists of the nodes the thread
+ * visits next (do_all hands each thread contiguous blocks of nodes). It is
+ * bounded by the end of the edge array, never by the end of the current
+ * node.
+ *
+ * The address to prefetch is given by a functor from destination to pointer,
+ * so data kept outside the graph (e.g., a LargeArray indexed by node) can be
+ * prefetched as well. A distance of 0 disables prefetching.
+ *
+ * @tparam Graph LC_CSR_Graph or a graph with the same edge_iterator; the
+ * in-edge visitors need LC_CSR_CSC_Graph
+ */
+template <typename Graph>
+class GatherPrefetch {
+  using GraphNode     = typename Graph::GraphNode;
+  using edge_iterator = typename Graph::edge_iterator;
+
+  Graph& graph;
+  unsigned distance;
+
+  template <typename DstFn, typename AddrFn, typename Fn>
+  static bool visit(edge_iterator ii, edge_iterator ee, edge_iterator limit,
+                    unsigned distance, DstFn&& dstOf, AddrFn&& addrOf,
+                    Fn&& fn) {
+    edge_iterator pf = ii + distance;
+    for (; ii != ee; ++ii, ++pf) {
+      if (distance && pf < limit) {
+        substrate::prefetch(addrOf(dstOf(pf)));
+      }
+      if constexpr (std::is_same<std::invoke_result_t<Fn&, GraphNode>,
+                                 bool>::value) {
+        if (!fn(dstOf(ii))) {
+          return false;
+        }
+      } else {
+        fn(dstOf(ii));
+      }
+    }
+    return true;
+  }
+
+public:
+  //! Default prefetch distance in edges
+  static constexpr unsigned DEFAULT_DISTANCE = 16;
+
+  explicit GatherPrefetch(Graph& g, unsigned dist = DEFAULT_DISTANCE)
+      : graph(g), distance(dist) {}
+
+  /**
+   * Calls fn(dst) for each out-edge of n, prefetching addrOf(dst) ahead. If
+   * fn returns bool, returning false stops the visit.
+   *
+   * @returns false if fn stopped the visit early
+   */
+  template <typename AddrFn, typename Fn>
+  bool edges(GraphNode n, AddrFn&& addrOf, Fn&& fn) {
+    constexpr MethodFlag flag = MethodFlag::UNPROTECTED;
+    edge_iterator limit       = graph.edge_end(graph.size() - 1, flag);
+    return visit(
+        graph.edge_begin(n, flag), graph.edge_end(n, flag), limit, distance,
+        [&](edge_iterator e) { return graph.getEdgeDst(e); }, addrOf, fn);
+  }
+
+  //! Like edges, over the in-edges of n
+  template <typename AddrFn, typename Fn>
+  bool in_edges(GraphNode n, AddrFn&& addrOf, Fn&& fn) {
+    constexpr MethodFlag flag = MethodFlag::UNPROTECTED;
+    edge_iterator limit       = graph.in_edge_end(graph.size() - 1, flag);
+    return visit(
+        graph.in_edge_begin(n, flag), graph.in_edge_end(n, flag), limit,
+        distance, [&](edge_iterator e) { return graph.getInEdgeDst(e); },
+        addrOf, fn);
+  }
+};
+
+} // namespace graphs
+} // namespace galois
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_GRAPHCACHE_H
+#define GALOIS_GRAPHS_GRAPHCACHE_H
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Reduction.h"
+#include "galois/gIO.h"
+#include "galois/graphs/FileGraph.h"
+
+namespace galois {
+namespace graphs {
+
+//! Preprocessing steps whose output can be cached by readCachedGraph
+enum class GraphTransform {
+  SORT_BY_DST,      //!< sort the edges of each node by destination
+  DEGREE_RELABEL,   //!< renumber nodes by decreasing out-degree
+  SYMMETRIZE,       //!< add reverse edges; see makeSymmetric
+  TRANSPOSE,        //!< reverse every edge; see transpose
+  REMOVE_SELF_LOOPS //!< drop self loops; see removeSelfLoops
+};
+
+//! Short name of a transform as used in cache file names
+const char* graphTransformName(GraphTransform t);
+
+namespace internal {
+
+/**
+ * Cache file holding the result of applying pipeline to filename. It lives
+ * next to the input, e.g. "in.gr.relabel-sortdst.cache.gr"; its validation
+ * key is stored in the same path suffixed by ".key".
+ */
+std::string graphCachePath(const std::string& filename,
+                           const std::vector<GraphTransform>& pipeline);
+
+/**
+ * Key identifying the current contents of filename: its size, its
+ * modification time and a hash of sampled blocks, plus the pipeline and the
+ * edge data size the cache was built with.
+ */
+std::string graphCacheKey(const std::string& filename,
+                          const std::vector<GraphTransform>& pipeline,
+                          size_t sizeofEdgeData);
+
+//! Returns true if the cache at path was built with key
+bool graphCacheValid(const std::string& path, const std::string& key);
+
+/**
+ * Writes graph to the cache at path and records key. Failures only
+ * produce a warning since the cache is an optimization.
+ */
+void graphCacheStore(FileGraph& graph, const std::string& path,
+                     const std::string& key);
+
+} // namespace internal
+
+/**
+ * Applies a single transform to graph, replacing it by the result.
+ *
+ * @tparam EdgeTy edge data type of graph
+ */
+template <typename EdgeTy>
+void applyGraphTransform(FileGraph& graph, GraphTransform t) {
+  typedef FileGraph::GraphNode GNode;
+  FileGraph out;
+
+  switch (t) {
+  case GraphTransform::SORT_BY_DST:
+    // a FileGraph loaded from disk is backed by a read-only mapping
+    out = graph;
+    galois::do_all(
+        galois::iterate(out),
+        [&](GNode n) {
+          out.sortEdges<EdgeTy>(n, [](const EdgeSortValue<GNode, EdgeTy>& a,
+                                      const EdgeSortValue<GNode, EdgeTy>& b) {
+            return a.dst < b.dst;
+          });
+        },
+        galois::steal(), galois::no_stats());
+    break;
+  case GraphTransform::DEGREE_RELABEL: {
+    std::vector<uint64_t> degree(graph.size());
+    galois::GReduceMax<uint64_t> maxDegree;
+    galois::do_all(
+        galois::iterate(graph),
+        [&](GNode n) {
+          degree[n] = std::distance(graph.edge_begin(n), graph.edge_end(n));
+          maxDegree.update(degree[n]);
+        },
+        galois::no_stats());
+    // a stable sort by ascending maxDegree - degree keeps nodes of equal
+    // degree in their original order
+    uint64_t maxDeg = maxDegree.reduce();
+    std::vector<GNode> order(graph.size());
+    std::iota(order.begin(), order.end(), 0);
+    galois::ParallelSTL::radix_sort(order.begin(), order.end(), [&](GNode n) {
+      return maxDeg - degree[n];
+    });
+    std::vector<GNode> perm(graph.size());
+    galois::do_all(
+        galois::iterate(size_t{0}, order.size()),
+        [&](size_t i) { perm[order[i]] = i; }, galois::no_stats());
+    permute<EdgeTy>(graph, perm, out);
+    break;
+  }
+  case GraphTransform::SYMMETRIZE:
+    makeSymmetric<EdgeTy>(graph, out);
+    break;
+  case GraphTransform::TRANSPOSE:
+    transpose<EdgeTy>(graph, out);
+    break;
+  case GraphTransform::REMOVE_SELF_LOOPS:
+    removeSelfLoops<EdgeTy>(graph, out);
+    break;
+  default:
+    GALOIS_DIE("unknown graph transform");
+  }
+
+  graph = std::move(out);
+}
+
+/**
+ * Loads the result of applying a chain of transforms to a graph file.
+ *
+ * The first run applies the transforms in order and writes the result next
+ * to the input as a plain binary CSR (.gr) file. Later runs whose input
+ * still has the same size, modification time and sampled hash skip the
+ * preprocessing and mmap the cached file instead. Use readGraph or
+ * LC_Mapped_CSR_Graph::mapGraphFrom to get an LC graph from out. An empty
+ * pipeline just loads the input and is always a miss.
+ *
+ * @tparam EdgeTy edge data type of the input graph
+ * @param out graph to load into; the previous out is destroyed
+ * @param filename input graph in Galois binary format
+ * @param pipeline transforms to apply, in order
+ * @returns true if the graph was loaded from the cache
+ */
+template <typename EdgeTy>
+bool readCachedGraph(FileGraph& out, const std::string& filename,
+                     const std::vector<GraphTransform>& pipeline) {
+  if (pipeline.empty()) {
+    out.fromFile(filename);
+    return false;
+  }
+
+  std::string path = internal::graphCachePath(filename, pipeline);
+  std::string key  = internal::graphCacheKey(
+      filename, pipeline, LargeArray<EdgeTy>::size_of::value);
+
+  if (internal::graphCacheValid(path, key)) {
+    out.fromFile(path);
+    return true;
+  }
+
+  out.fromFile(filename);
+  for (GraphTransform t : pipeline)
+    applyGraphTransform<EdgeTy>(out, t);
+  internal::graphCacheStore(out, path, key);
+  return false;
+}
+
+} // namespace graphs
+} // namespace galois
+
+#endif
@@ -22,6 +22,8 @@
 
 #include "galois/config.h"
 #include "galois/graphs/LC_CSR_Graph.h"
+#include "galois/graphs/LC_Compressed_CSR_Graph.h"
+#include "galois/graphs/LC_Mapped_CSR_Graph.h"
 #include "galois/graphs/LC_InlineEdge_Graph.h"
 #include "galois/graphs/LC_Linear_Graph.h"
 #include "galois/graphs/LC_Morph_Graph.h"
@@ -30,6 +30,7 @@
 #include <boost/serialization/serialization.hpp>
 
 #include "galois/config.h"
+#include "galois/Bag.h"
 #include "galois/Galois.h"
 #include "galois/graphs/Details.h"
 #include "galois/graphs/FileGraph.h"
@@ -402,6 +403,16 @@ public:
 
   GraphNode getEdgeDst(edge_iterator ni) { return edgeDst[*ni]; }
 
+  /**
+   * Destinations of the edges starting at ni as a plain array. Edges of a
+   * node are stored contiguously, so getEdgeDstPtr(edge_begin(N)) together
+   * with getDegree(N) is the neighbor list of N, e.g., for
+   * galois::intersectCount.
+   */
+  const GraphNode* getEdgeDstPtr(edge_iterator ni) const {
+    return edgeDst.data() + *ni;
+  }
+
   size_t size() const { return numNodes; }
   size_t sizeEdges() const { return numEdges; }
 
@@ -501,15 +512,72 @@ public:
               });
   }
 
+private:
   /**
-   * Sorts all outgoing edges of all nodes in parallel. Comparison is over
-   * getEdgeDst(e).
+   * Sorts the edges of every node with sortSmall, one node per thread, except
+   * for nodes with so many edges that sorting them on one thread would leave
+   * the others idle. Those are sorted one after another with sortLarge, which
+   * is expected to use all threads.
    */
-  void sortAllEdgesByDst(MethodFlag mflag = MethodFlag::WRITE) {
+  template <typename SmallFn, typename LargeFn>
+  void sortAllEdgesSplit(MethodFlag mflag, const SmallFn& sortSmall,
+                         const LargeFn& sortLarge) {
+    const uint64_t cutoff = std::max<uint64_t>(
+        numEdges / (4 * galois::getActiveThreads()), 1 << 16);
+    galois::InsertBag<GraphNode> large;
     galois::do_all(
         galois::iterate(size_t{0}, this->size()),
-        [=](GraphNode N) { this->sortEdgesByDst(N, mflag); },
+        [&](GraphNode N) {
+          acquireNode(N, mflag);
+          if (getDegree(N) > cutoff)
+            large.push(N);
+          else
+            sortSmall(N);
+        },
         galois::no_stats(), galois::steal());
+    for (GraphNode N : large)
+      sortLarge(N);
+  }
+
+public:
+  /**
+   * Sorts all outgoing edges of all nodes in parallel.
+   * Comparison function is over <code>EdgeSortValue<EdgeTy></code>.
+   * The edges of high-degree nodes are sorted with a parallel samplesort.
+   */
+  template <typename CompTy>
+  void sortAllEdges(const CompTy& comp, MethodFlag mflag = MethodFlag::WRITE) {
+    sortAllEdgesSplit(
+        mflag,
+        [&](GraphNode N) {
+          std::sort(edge_sort_begin(N), edge_sort_end(N), comp);
+        },
+        [&](GraphNode N) {
+          galois::ParallelSTL::sample_sort(edge_sort_begin(N),
+                                           edge_sort_end(N), comp);
+        });
+  }
+
+  /**
+   * Sorts all outgoing edges of all nodes in parallel. Comparison is over
+   * getEdgeDst(e). The edges of high-degree nodes are sorted with a parallel
+   * radix sort on the destination.
+   */
+  void sortAllEdgesByDst(MethodFlag mflag = MethodFlag::WRITE) {
+    typedef EdgeSortValue<GraphNode, EdgeTy> EdgeSortVal;
+    sortAllEdgesSplit(
+        mflag,
+        [&](GraphNode N) {
+          std::sort(edge_sort_begin(N), edge_sort_end(N),
+                    [](const EdgeSortVal& e1, const EdgeSortVal& e2) {
+                      return e1.dst < e2.dst;
+                    });
+        },
+        [&](GraphNode N) {
+          galois::ParallelSTL::radix_sort(
+              edge_sort_begin(N), edge_sort_end(N),
+              [](const EdgeSortVal& e) { return e.dst; });
+        });
   }
 
   void allocateFrom(const FileGraph& graph) {
@@ -0,0 +1,842 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_LC_COMPRESSED_CSR_GRAPH_H
+#define GALOIS_GRAPHS_LC_COMPRESSED_CSR_GRAPH_H
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
+#include "galois/graphs/Details.h"
+#include "galois/graphs/FileGraph.h"
+#include "galois/graphs/GraphHelpers.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+namespace galois::graphs::internal {
+
+//! Number of edges between restart points of the gap encoding. Must be a
+//! power of two.
+constexpr uint64_t COMPRESSED_BLOCK_SIZE = 64;
+//! Zero bytes appended to the encoded edges so that decoding one element past
+//! the last edge never reads out of bounds
+constexpr uint64_t COMPRESSED_PADDING = 16;
+
+inline uint64_t zigzagEncode(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+//! Number of bytes needed to encode v as a LEB128 varint
+inline uint64_t varintSize(uint64_t v) {
+  uint64_t s = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    ++s;
+  }
+  return s;
+}
+
+inline uint8_t* varintEncode(uint64_t v, uint8_t* out) {
+  while (v >= 0x80) {
+    *out++ = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(v);
+  return out;
+}
+
+inline const uint8_t* varintDecode(const uint8_t* in, uint64_t& v) {
+  uint8_t b = *in++;
+  v         = b & 0x7F;
+  // most gaps fit in a byte on locality-ordered graphs
+  if (b < 0x80)
+    return in;
+  unsigned shift = 7;
+  do {
+    b = *in++;
+    v |= static_cast<uint64_t>(b & 0x7F) << shift;
+    shift += 7;
+  } while (b >= 0x80);
+  return in;
+}
+
+inline bool isRestart(uint64_t edge) {
+  return (edge & (COMPRESSED_BLOCK_SIZE - 1)) == 0;
+}
+
+/**
+ * Encodes a sorted neighbor list whose first edge has global index firstEdge.
+ * The first edge of every list and every edge whose global index is a
+ * multiple of COMPRESSED_BLOCK_SIZE is stored as the zigzag-encoded
+ * difference to src; all other edges store the gap to their predecessor.
+ *
+ * @param out Destination of the encoding; if null, only the size is computed
+ * @param skip If not null, receives the offset (relative to out) of every
+ *   restart edge on a block boundary, indexed by block
+ * @returns number of bytes of the encoding
+ */
+template <typename DstIter>
+uint64_t encodeNeighbors(uint32_t src, uint64_t firstEdge, DstIter ii,
+                         DstIter ei, uint8_t* out = nullptr,
+                         uint64_t* skip = nullptr, uint64_t base = 0) {
+  uint64_t size = 0;
+  uint32_t prev = 0;
+  for (uint64_t e = firstEdge; ii != ei; ++ii, ++e) {
+    uint32_t dst = *ii;
+    uint64_t code;
+    if (e == firstEdge || isRestart(e)) {
+      code = zigzagEncode(static_cast<int64_t>(dst) - src);
+      if (skip && isRestart(e))
+        skip[e / COMPRESSED_BLOCK_SIZE] = base + size;
+    } else {
+      assert(dst >= prev);
+      code = dst - prev;
+    }
+    if (out)
+      varintEncode(code, out + size);
+    size += varintSize(code);
+    prev = dst;
+  }
+  return size;
+}
+
+//! Pointers into the arrays of a compressed graph needed to seek within it
+struct CompressedEdgeLayout {
+  const uint8_t* bytes;
+  const uint64_t* edgeIndData;
+  const uint64_t* byteIndData;
+  const uint64_t* skipData;
+};
+
+/**
+ * Edge iterator of {@link LC_Compressed_CSR_Graph}. The destination of the
+ * current edge is decoded on increment; random access restarts decoding from
+ * the nearest block boundary, so it costs at most COMPRESSED_BLOCK_SIZE
+ * varint decodes.
+ *
+ * Dereferencing yields the iterator itself: code that iterates over a raw
+ * edge range (e.g., edge tiles) and passes the dereferenced value back to
+ * getEdgeDst/getEdgeData then keeps the decoded destination, much like the
+ * edge index obtained from the counting iterator of LC_CSR_Graph.
+ */
+class CompressedEdgeIterator {
+  const CompressedEdgeLayout* layout;
+  uint64_t at;
+  //! encoding of the edge after at; null if not positioned
+  const uint8_t* pos;
+  uint32_t src;
+  uint32_t dst;
+
+  void decodeNext() {
+    uint64_t code;
+    pos = varintDecode(pos, code);
+    if (isRestart(at))
+      dst = src + static_cast<uint32_t>(zigzagDecode(code));
+    else
+      dst += static_cast<uint32_t>(code);
+  }
+
+  //! Positions this iterator on edge at by decoding from the closest
+  //! restart point
+  void seek() {
+    uint64_t nodeBegin = src ? layout->edgeIndData[src - 1] : 0;
+    if (at >= layout->edgeIndData[src] || at < nodeBegin) {
+      // end iterator or out of range; decode lazily if ever asked
+      pos = nullptr;
+      return;
+    }
+    uint64_t block = at & ~(COMPRESSED_BLOCK_SIZE - 1);
+    uint64_t e;
+    if (block <= nodeBegin) {
+      e   = nodeBegin;
+      pos = layout->bytes + (src ? layout->byteIndData[src - 1] : 0);
+    } else {
+      e   = block;
+      pos = layout->bytes + layout->skipData[block / COMPRESSED_BLOCK_SIZE];
+    }
+    uint64_t code;
+    pos = varintDecode(pos, code);
+    dst = src + static_cast<uint32_t>(zigzagDecode(code));
+    for (++e; e <= at; ++e) {
+      pos = varintDecode(pos, code);
+      if (isRestart(e))
+        dst = src + static_cast<uint32_t>(zigzagDecode(code));
+      else
+        dst += static_cast<uint32_t>(code);
+    }
+  }
+
+public:
+  CompressedEdgeIterator()
+      : layout(nullptr), at(0), pos(nullptr), src(0), dst(0) {}
+
+  CompressedEdgeIterator(const CompressedEdgeLayout* l, uint32_t s, uint64_t x,
+                         bool position)
+      : layout(l), at(x), pos(nullptr), src(s), dst(0) {
+    if (position)
+      seek();
+  }
+
+  //! Global index of the current edge
+  uint64_t getIndex() const { return at; }
+
+  //! Destination of the current edge
+  uint32_t getDst() const {
+    if (pos)
+      return dst;
+    CompressedEdgeIterator tmp(layout, src, at, true);
+    return tmp.dst;
+  }
+
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef CompressedEdgeIterator value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const CompressedEdgeIterator* pointer;
+  typedef CompressedEdgeIterator reference;
+
+  reference operator*() const { return *this; }
+  reference operator[](difference_type n) const { return *this + n; }
+
+  CompressedEdgeIterator& operator++() {
+    ++at;
+    if (pos)
+      decodeNext();
+    return *this;
+  }
+  CompressedEdgeIterator operator++(int) {
+    CompressedEdgeIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+  CompressedEdgeIterator& operator--() {
+    --at;
+    seek();
+    return *this;
+  }
+  CompressedEdgeIterator operator--(int) {
+    CompressedEdgeIterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+  CompressedEdgeIterator& operator+=(difference_type n) {
+    at += n;
+    seek();
+    return *this;
+  }
+  CompressedEdgeIterator& operator-=(difference_type n) { return *this += -n; }
+  CompressedEdgeIterator operator+(difference_type n) const {
+    CompressedEdgeIterator tmp(*this);
+    return tmp += n;
+  }
+  friend CompressedEdgeIterator operator+(difference_type n,
+                                          const CompressedEdgeIterator& it) {
+    return it + n;
+  }
+  CompressedEdgeIterator operator-(difference_type n) const {
+    CompressedEdgeIterator tmp(*this);
+    return tmp -= n;
+  }
+  difference_type operator-(const CompressedEdgeIterator& other) const {
+    return (difference_type)at - (difference_type)other.at;
+  }
+
+  bool operator==(const CompressedEdgeIterator& o) const { return at == o.at; }
+  bool operator!=(const CompressedEdgeIterator& o) const { return at != o.at; }
+  bool operator<(const CompressedEdgeIterator& o) const { return at < o.at; }
+  bool operator>(const CompressedEdgeIterator& o) const { return at > o.at; }
+  bool operator<=(const CompressedEdgeIterator& o) const { return at <= o.at; }
+  bool operator>=(const CompressedEdgeIterator& o) const { return at >= o.at; }
+};
+
+} // namespace galois::graphs::internal
+
+namespace galois::graphs {
+
+/**
+ * Local computation graph (i.e., graph structure does not change) with
+ * compressed adjacency lists. Neighbor lists are sorted by destination and
+ * stored as variable-length (LEB128) gaps, which usually takes 1-2 bytes per
+ * edge instead of 4 on graphs with locality. Every COMPRESSED_BLOCK_SIZE
+ * edges the encoding restarts relative to the source node, and a skip table
+ * records the byte offset of each restart so iterators remain random access.
+ *
+ * Node data and edge data are stored uncompressed as in {@link LC_CSR_Graph},
+ * and the public interface is the same for read-only use, so algorithms that
+ * are templated on the graph type run on this graph unchanged. The graph
+ * can be built from a FileGraph (.gr) or read from a .zgr file written by
+ * {@link writeGraphToZGRFile}.
+ *
+ * @tparam NodeTy data on nodes
+ * @tparam EdgeTy data on out edges
+ */
+template <typename NodeTy, typename EdgeTy, bool HasNoLockable = false,
+          bool UseNumaAlloc = false, bool HasOutOfLineLockable = false,
+          typename FileEdgeTy = EdgeTy>
+class LC_Compressed_CSR_Graph
+    : private boost::noncopyable,
+      private internal::LocalIteratorFeature<UseNumaAlloc>,
+      private internal::OutOfLineLockableFeature<HasOutOfLineLockable &&
+                                                 !HasNoLockable> {
+public:
+  template <bool _has_id>
+  struct with_id {
+    typedef LC_Compressed_CSR_Graph type;
+  };
+
+  template <typename _node_data>
+  struct with_node_data {
+    typedef LC_Compressed_CSR_Graph<_node_data, EdgeTy, HasNoLockable,
+                                    UseNumaAlloc, HasOutOfLineLockable,
+                                    FileEdgeTy>
+        type;
+  };
+
+  template <typename _edge_data>
+  struct with_edge_data {
+    typedef LC_Compressed_CSR_Graph<NodeTy, _edge_data, HasNoLockable,
+                                    UseNumaAlloc, HasOutOfLineLockable,
+                                    FileEdgeTy>
+        type;
+  };
+
+  template <typename _file_edge_data>
+  struct with_file_edge_data {
+    typedef LC_Compressed_CSR_Graph<NodeTy, EdgeTy, HasNoLockable,
+                                    UseNumaAlloc, HasOutOfLineLockable,
+                                    _file_edge_data>
+        type;
+  };
+
+  //! If true, do not use abstract locks in graph
+  template <bool _has_no_lockable>
+  struct with_no_lockable {
+    typedef LC_Compressed_CSR_Graph<NodeTy, EdgeTy, _has_no_lockable,
+                                    UseNumaAlloc, HasOutOfLineLockable,
+                                    FileEdgeTy>
+        type;
+  };
+
+  //! If true, use NUMA-aware graph allocation; otherwise, use NUMA interleaved
+  //! allocation.
+  template <bool _use_numa_alloc>
+  struct with_numa_alloc {
+    typedef LC_Compressed_CSR_Graph<NodeTy, EdgeTy, HasNoLockable,
+                                    _use_numa_alloc, HasOutOfLineLockable,
+                                    FileEdgeTy>
+        type;
+  };
+
+  //! If true, store abstract locks separate from nodes
+  template <bool _has_out_of_line_lockable>
+  struct with_out_of_line_lockable {
+    typedef LC_Compressed_CSR_Graph<NodeTy, EdgeTy, HasNoLockable,
+                                    UseNumaAlloc, _has_out_of_line_lockable,
+                                    FileEdgeTy>
+        type;
+  };
+
+  typedef read_compressed_graph_tag read_tag;
+
+  //! Version written to the header of .zgr files
+  static constexpr uint64_t ZGR_VERSION = 1;
+
+protected:
+  typedef LargeArray<EdgeTy> EdgeData;
+  typedef LargeArray<uint8_t> EdgeBytes;
+  typedef internal::NodeInfoBaseTypes<NodeTy,
+                                      !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfoTypes;
+  typedef internal::NodeInfoBase<NodeTy,
+                                 !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfo;
+  typedef LargeArray<uint64_t> EdgeIndData;
+  typedef LargeArray<NodeInfo> NodeData;
+
+public:
+  typedef uint32_t GraphNode;
+  typedef EdgeTy edge_data_type;
+  typedef FileEdgeTy file_edge_data_type;
+  typedef NodeTy node_data_type;
+  typedef typename EdgeData::reference edge_data_reference;
+  typedef typename NodeInfoTypes::reference node_data_reference;
+  using edge_iterator = internal::CompressedEdgeIterator;
+  using iterator      = boost::counting_iterator<GraphNode>;
+  typedef iterator const_iterator;
+  typedef iterator local_iterator;
+  typedef iterator const_local_iterator;
+
+protected:
+  NodeData nodeData;
+  //! edge index one past the last edge of each node
+  EdgeIndData edgeIndData;
+  //! byte offset one past the encoding of each node's neighbors
+  EdgeIndData byteIndData;
+  //! byte offset of every COMPRESSED_BLOCK_SIZE-th edge, plus one sentinel
+  EdgeIndData skipData;
+  EdgeBytes edgeBytes;
+  EdgeData edgeData;
+  internal::CompressedEdgeLayout layout{};
+
+  uint64_t numNodes = 0;
+  uint64_t numEdges = 0;
+  uint64_t numBytes = 0;
+
+  uint64_t numBlocks() const {
+    return (numEdges + internal::COMPRESSED_BLOCK_SIZE - 1) /
+           internal::COMPRESSED_BLOCK_SIZE;
+  }
+
+  uint64_t raw_begin(GraphNode N) const {
+    return (N == 0) ? 0 : edgeIndData[N - 1];
+  }
+
+  uint64_t raw_end(GraphNode N) const { return edgeIndData[N]; }
+
+  uint64_t byte_begin(GraphNode N) const {
+    return (N == 0) ? 0 : byteIndData[N - 1];
+  }
+
+  void updateLayout() {
+    layout.bytes       = edgeBytes.data();
+    layout.edgeIndData = edgeIndData.data();
+    layout.byteIndData = byteIndData.data();
+    layout.skipData    = skipData.data();
+  }
+
+  template <bool _A1 = HasNoLockable, bool _A2 = HasOutOfLineLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<!_A1 && !_A2>::type* = 0) {
+    galois::runtime::acquire(&nodeData[N], mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<_A1 && !_A2>::type* = 0) {
+    this->outOfLineAcquire(N, mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode, MethodFlag,
+                   typename std::enable_if<_A2>::type* = 0) {}
+
+  template <bool _A1 = EdgeData::has_value,
+            bool _A2 = LargeArray<FileEdgeTy>::has_value>
+  void constructEdgeValue(FileGraph& graph, uint64_t e, uint64_t fileEdge,
+                          typename std::enable_if<!_A1 || _A2>::type* = 0) {
+    typedef LargeArray<FileEdgeTy> FED;
+    if (EdgeData::has_value)
+      edgeData.set(e, graph.getEdgeData<typename FED::value_type>(
+                          FileGraph::edge_iterator(fileEdge)));
+  }
+
+  template <bool _A1 = EdgeData::has_value,
+            bool _A2 = LargeArray<FileEdgeTy>::has_value>
+  void constructEdgeValue(FileGraph&, uint64_t e, uint64_t,
+                          typename std::enable_if<_A1 && !_A2>::type* = 0) {
+    edgeData.set(e, {});
+  }
+
+  /**
+   * Collects the destinations of N in the FileGraph sorted by destination.
+   * Ties keep file order so edge data assignment is deterministic.
+   */
+  static void sortedNeighbors(FileGraph& graph, GraphNode N,
+                              std::vector<std::pair<uint32_t, uint64_t>>& out) {
+    out.clear();
+    for (FileGraph::edge_iterator nn = graph.edge_begin(N),
+                                  en = graph.edge_end(N);
+         nn != en; ++nn) {
+      out.emplace_back(graph.getEdgeDst(nn), *nn);
+    }
+    if (!std::is_sorted(out.begin(), out.end()))
+      std::sort(out.begin(), out.end());
+  }
+
+  struct FirstOfPair {
+    uint32_t operator()(const std::pair<uint32_t, uint64_t>& p) const {
+      return p.first;
+    }
+  };
+
+  template <typename PairIter>
+  static auto dstIter(PairIter ii) {
+    return boost::make_transform_iterator(ii, FirstOfPair());
+  }
+
+  void allocateArrays() {
+    if (UseNumaAlloc) {
+      nodeData.allocateBlocked(numNodes);
+      edgeIndData.allocateBlocked(numNodes);
+      byteIndData.allocateBlocked(numNodes);
+      skipData.allocateBlocked(numBlocks() + 1);
+      edgeData.allocateBlocked(numEdges);
+      this->outOfLineAllocateBlocked(numNodes);
+    } else {
+      nodeData.allocateInterleaved(numNodes);
+      edgeIndData.allocateInterleaved(numNodes);
+      byteIndData.allocateInterleaved(numNodes);
+      skipData.allocateInterleaved(numBlocks() + 1);
+      edgeData.allocateInterleaved(numEdges);
+      this->outOfLineAllocateInterleaved(numNodes);
+    }
+  }
+
+  void allocateBytes() {
+    if (UseNumaAlloc) {
+      edgeBytes.allocateBlocked(numBytes + internal::COMPRESSED_PADDING);
+    } else {
+      edgeBytes.allocateInterleaved(numBytes + internal::COMPRESSED_PADDING);
+    }
+    std::memset(edgeBytes.data() + numBytes, 0, internal::COMPRESSED_PADDING);
+    skipData[numBlocks()] = numBytes;
+    updateLayout();
+  }
+
+public:
+  LC_Compressed_CSR_Graph(LC_Compressed_CSR_Graph&& rhs) = default;
+
+  LC_Compressed_CSR_Graph() = default;
+
+  LC_Compressed_CSR_Graph& operator=(LC_Compressed_CSR_Graph&&) = default;
+
+  friend void swap(LC_Compressed_CSR_Graph& lhs, LC_Compressed_CSR_Graph& rhs) {
+    swap(lhs.nodeData, rhs.nodeData);
+    swap(lhs.edgeIndData, rhs.edgeIndData);
+    swap(lhs.byteIndData, rhs.byteIndData);
+    swap(lhs.skipData, rhs.skipData);
+    swap(lhs.edgeBytes, rhs.edgeBytes);
+    swap(lhs.edgeData, rhs.edgeData);
+    std::swap(lhs.numNodes, rhs.numNodes);
+    std::swap(lhs.numEdges, rhs.numEdges);
+    std::swap(lhs.numBytes, rhs.numBytes);
+    std::swap(lhs.layout, rhs.layout);
+  }
+
+  node_data_reference getData(GraphNode N,
+                              MethodFlag mflag = MethodFlag::WRITE) {
+    NodeInfo& NI = nodeData[N];
+    acquireNode(N, mflag);
+    return NI.getData();
+  }
+
+  edge_data_reference
+  getEdgeData(edge_iterator ni,
+              MethodFlag GALOIS_UNUSED(mflag) = MethodFlag::UNPROTECTED) {
+    return edgeData[ni.getIndex()];
+  }
+
+  GraphNode getEdgeDst(edge_iterator ni) { return ni.getDst(); }
+
+  size_t size() const { return numNodes; }
+  size_t sizeEdges() const { return numEdges; }
+  //! Size in bytes of the encoded adjacency lists
+  size_t sizeEdgeBytes() const { return numBytes; }
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(numNodes); }
+
+  const_local_iterator local_begin() const {
+    return const_local_iterator(this->localBegin(numNodes));
+  }
+
+  const_local_iterator local_end() const {
+    return const_local_iterator(this->localEnd(numNodes));
+  }
+
+  local_iterator local_begin() {
+    return local_iterator(this->localBegin(numNodes));
+  }
+
+  local_iterator local_end() {
+    return local_iterator(this->localEnd(numNodes));
+  }
+
+  edge_iterator edge_begin(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    edge_iterator ii(&layout, N, raw_begin(N), true);
+    if (!HasNoLockable && galois::runtime::shouldLock(mflag)) {
+      for (edge_iterator jj = ii, ee = edge_end(N, MethodFlag::UNPROTECTED);
+           jj != ee; ++jj) {
+        acquireNode(jj.getDst(), mflag);
+      }
+    }
+    return ii;
+  }
+
+  edge_iterator edge_end(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    return edge_iterator(&layout, N, raw_end(N), false);
+  }
+
+  uint64_t getDegree(GraphNode N) const { return raw_end(N) - raw_begin(N); }
+
+  edge_iterator findEdge(GraphNode N1, GraphNode N2) {
+    return findEdgeSortedByDst(N1, N2);
+  }
+
+  //! Neighbor lists are always sorted, so this stops at the first larger dst
+  edge_iterator findEdgeSortedByDst(GraphNode N1, GraphNode N2) {
+    edge_iterator ee = edge_end(N1);
+    for (edge_iterator ii = edge_begin(N1); ii != ee; ++ii) {
+      GraphNode dst = ii.getDst();
+      if (dst == N2)
+        return ii;
+      if (dst > N2)
+        break;
+    }
+    return ee;
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return internal::make_no_deref_range(edge_begin(N, mflag),
+                                         edge_end(N, mflag));
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  out_edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return edges(N, mflag);
+  }
+
+  //! Edges are sorted by destination on construction; provided for
+  //! interface compatibility with LC_CSR_Graph.
+  void sortEdgesByDst(GraphNode, MethodFlag = MethodFlag::WRITE) {}
+
+  //! Edges are sorted by destination on construction; provided for
+  //! interface compatibility with LC_CSR_Graph.
+  void sortAllEdgesByDst(MethodFlag = MethodFlag::WRITE) {}
+
+  /**
+   * Allocates the graph and computes the size of the encoding of every
+   * neighbor list in parallel. Must be called outside of parallel execution.
+   */
+  void allocateFrom(FileGraph& graph) {
+    numNodes = graph.size();
+    numEdges = graph.sizeEdges();
+    allocateArrays();
+
+    galois::substrate::PerThreadStorage<
+        std::vector<std::pair<uint32_t, uint64_t>>>
+        scratch;
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          auto& nbrs = *scratch.getLocal();
+          sortedNeighbors(graph, n, nbrs);
+          byteIndData[n] = internal::encodeNeighbors(
+              n, *graph.edge_begin(n), dstIter(nbrs.begin()),
+              dstIter(nbrs.end()));
+        },
+        galois::no_stats(), galois::steal(),
+        galois::loopname("COMPRESSED_EDGE_SIZES"));
+
+    galois::ParallelSTL::partial_sum(byteIndData.begin(), byteIndData.end(),
+                                     byteIndData.begin());
+    numBytes = numNodes ? byteIndData[numNodes - 1] : 0;
+    allocateBytes();
+  }
+
+  void constructFrom(FileGraph& graph, unsigned tid, unsigned total,
+                     const bool readUnweighted = false) {
+    // at this point memory should already be allocated
+    const size_t nodeSize = NodeData::size_of::value +
+                            2 * EdgeIndData::size_of::value +
+                            LC_Compressed_CSR_Graph::size_of_out_of_line::value;
+    // roughly two bytes per encoded destination
+    const size_t edgeSize = EdgeData::size_of::value + 2;
+    auto r = graph.divideByNode(nodeSize, edgeSize, tid, total).first;
+
+    this->setLocalRange(*r.first, *r.second);
+
+    std::vector<std::pair<uint32_t, uint64_t>> nbrs;
+    for (FileGraph::iterator ii = r.first, ei = r.second; ii != ei; ++ii) {
+      GraphNode n = *ii;
+      nodeData.constructAt(n);
+      edgeIndData[n] = *graph.edge_end(n);
+
+      this->outOfLineConstructAt(n);
+
+      sortedNeighbors(graph, n, nbrs);
+      uint64_t first = *graph.edge_begin(n);
+      uint64_t bytes = byte_begin(n);
+      internal::encodeNeighbors(n, first, dstIter(nbrs.begin()),
+                                dstIter(nbrs.end()), edgeBytes.data() + bytes,
+                                skipData.data(), bytes);
+      for (size_t i = 0; i < nbrs.size(); ++i) {
+        if constexpr (EdgeData::has_value) {
+          if (readUnweighted) {
+            edgeData.set(first + i, {});
+            continue;
+          }
+        }
+        constructEdgeValue(graph, first + i, nbrs[i].second);
+      }
+    }
+  }
+
+  /**
+   * Returns the reference to the edgeIndData LargeArray
+   * (a prefix sum of edges)
+   *
+   * @returns reference to LargeArray edgeIndData
+   */
+  const EdgeIndData& getEdgePrefixSum() const { return edgeIndData; }
+
+  auto divideByNode(size_t nodeSize, size_t edgeSize, size_t id, size_t total) {
+    return galois::graphs::divideNodesBinarySearch(
+        numNodes, numEdges, nodeSize, edgeSize, id, total, edgeIndData);
+  }
+
+  /**
+   * Given a manually created graph, initialize the local ranges on this graph
+   * so that threads can iterate over a balanced number of vertices.
+   */
+  void initializeLocalRanges() {
+    galois::on_each([&](unsigned tid, unsigned total) {
+      auto r = divideByNode(0, 1, tid, total).first;
+      this->setLocalRange(*r.first, *r.second);
+    });
+  }
+
+  /**
+   * Writes the compressed graph to a .zgr file. Layout (all integers are
+   * little-endian uint64_t):
+   *
+   * header: version, sizeof(EdgeTy), numNodes, numEdges, numBytes, block size
+   * edge index array (numNodes), byte index array (numNodes),
+   * skip table (numBlocks + 1), encoded edges (numBytes, padded to 8 bytes),
+   * edge data (numEdges * sizeof(EdgeTy))
+   */
+  void writeGraphToZGRFile(const std::string& filename) {
+    std::ofstream graphFile(filename.c_str(), std::ios::binary);
+    if (!graphFile.is_open()) {
+      GALOIS_DIE("failed to open file ", filename);
+    }
+    uint64_t header[6] = {ZGR_VERSION, EdgeData::size_of::value,
+                          numNodes,    numEdges,
+                          numBytes,    internal::COMPRESSED_BLOCK_SIZE};
+    graphFile.write(reinterpret_cast<char*>(header), sizeof(header));
+    graphFile.write(reinterpret_cast<const char*>(edgeIndData.data()),
+                    sizeof(uint64_t) * numNodes);
+    graphFile.write(reinterpret_cast<const char*>(byteIndData.data()),
+                    sizeof(uint64_t) * numNodes);
+    graphFile.write(reinterpret_cast<const char*>(skipData.data()),
+                    sizeof(uint64_t) * (numBlocks() + 1));
+    // padding is zeroed, so writing part of it keeps the file aligned
+    graphFile.write(reinterpret_cast<const char*>(edgeBytes.data()),
+                    (numBytes + 7) & ~UINT64_C(7));
+    if (EdgeData::has_value) {
+      graphFile.write(reinterpret_cast<const char*>(edgeData.data()),
+                      EdgeData::size_of::value * numEdges);
+    }
+    if (!graphFile) {
+      GALOIS_DIE("failed to write file ", filename);
+    }
+  }
+
+  /**
+   * Reads a .zgr file written by {@link writeGraphToZGRFile} directly into
+   * the graph's arrays.
+   *
+   * @param readUnweighted ignore edge data stored in the file and
+   *   default-initialize edge data instead
+   */
+  void readGraphFromZGRFile(const std::string& filename,
+                            const bool readUnweighted = false) {
+    std::ifstream graphFile(filename.c_str(), std::ios::binary);
+    if (!graphFile.is_open()) {
+      GALOIS_DIE("failed to open file ", filename);
+    }
+    uint64_t header[6];
+    graphFile.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!graphFile || header[0] != ZGR_VERSION) {
+      GALOIS_DIE("unknown compressed file version: ", header[0]);
+    }
+    if (header[5] != internal::COMPRESSED_BLOCK_SIZE) {
+      GALOIS_DIE("unsupported compressed block size: ", header[5]);
+    }
+    uint64_t sizeofEdgeData = header[1];
+    uint64_t expectedSize   = EdgeData::size_of::value;
+    bool readEdgeData       = EdgeData::has_value && !readUnweighted;
+    if (readEdgeData && sizeofEdgeData != expectedSize) {
+      GALOIS_DIE("edge data size mismatch: file has ", sizeofEdgeData,
+                 " graph expects ", expectedSize);
+    }
+    numNodes = header[2];
+    numEdges = header[3];
+    numBytes = header[4];
+    allocateArrays();
+    allocateBytes();
+
+    graphFile.read(reinterpret_cast<char*>(edgeIndData.data()),
+                   sizeof(uint64_t) * numNodes);
+    graphFile.read(reinterpret_cast<char*>(byteIndData.data()),
+                   sizeof(uint64_t) * numNodes);
+    graphFile.read(reinterpret_cast<char*>(skipData.data()),
+                   sizeof(uint64_t) * (numBlocks() + 1));
+    graphFile.read(reinterpret_cast<char*>(edgeBytes.data()), numBytes);
+    std::memset(edgeBytes.data() + numBytes, 0, internal::COMPRESSED_PADDING);
+    graphFile.seekg(((numBytes + 7) & ~UINT64_C(7)) - numBytes,
+                    std::ios::cur);
+    if (readEdgeData) {
+      graphFile.read(reinterpret_cast<char*>(edgeData.data()),
+                     EdgeData::size_of::value * numEdges);
+    }
+    if (!graphFile) {
+      GALOIS_DIE("failed to read file ", filename);
+    }
+
+    galois::do_all(
+        galois::iterate(UINT64_C(0), numNodes),
+        [&](uint64_t n) {
+          nodeData.constructAt(n);
+          this->outOfLineConstructAt(n);
+        },
+        galois::no_stats(), galois::loopname("CONSTRUCT_NODES"));
+    if constexpr (EdgeData::has_value) {
+      if (!readEdgeData) {
+        galois::do_all(
+            galois::iterate(UINT64_C(0), numEdges),
+            [&](uint64_t e) { edgeData.set(e, {}); }, galois::no_stats(),
+            galois::loopname("CONSTRUCT_EDGE_DATA"));
+      }
+    }
+
+    initializeLocalRanges();
+  }
+};
+
+} // namespace galois::graphs
+
+#endif
@@ -0,0 +1,404 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_GRAPHS_LC_MAPPED_CSR_GRAPH_H
+#define GALOIS_GRAPHS_LC_MAPPED_CSR_GRAPH_H
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/graphs/Details.h"
+#include "galois/graphs/FileGraph.h"
+#include "galois/graphs/GraphHelpers.h"
+
+namespace galois::graphs {
+
+/**
+ * Read-only local computation graph whose CSR arrays alias a memory-mapped
+ * .gr file instead of being copied into LargeArrays. Only node data (and
+ * out-of-line locks) are allocated, so reading a graph costs no more memory
+ * than the page cache already holds and no time beyond faulting the file in.
+ *
+ * The public interface matches {@link LC_CSR_Graph} for read-only use.
+ * Edge data is returned by const reference and edges cannot be sorted; sort
+ * the input file beforehand (e.g. graph-convert) if an algorithm needs
+ * sorted neighbors. Only version 1 .gr files (32-bit destinations) on
+ * little-endian hosts can be mapped.
+ *
+ * @tparam NodeTy data on nodes
+ * @tparam EdgeTy data on out edges
+ */
+template <typename NodeTy, typename EdgeTy, bool HasNoLockable = false,
+          bool UseNumaAlloc = false, bool HasOutOfLineLockable = false,
+          typename FileEdgeTy = EdgeTy>
+class LC_Mapped_CSR_Graph
+    : private boost::noncopyable,
+      private internal::LocalIteratorFeature<UseNumaAlloc>,
+      private internal::OutOfLineLockableFeature<HasOutOfLineLockable &&
+                                                 !HasNoLockable> {
+public:
+  template <bool _has_id>
+  struct with_id {
+    typedef LC_Mapped_CSR_Graph type;
+  };
+
+  template <typename _node_data>
+  struct with_node_data {
+    typedef LC_Mapped_CSR_Graph<_node_data, EdgeTy, HasNoLockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  template <typename _edge_data>
+  struct with_edge_data {
+    typedef LC_Mapped_CSR_Graph<NodeTy, _edge_data, HasNoLockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  template <typename _file_edge_data>
+  struct with_file_edge_data {
+    typedef LC_Mapped_CSR_Graph<NodeTy, EdgeTy, HasNoLockable, UseNumaAlloc,
+                                HasOutOfLineLockable, _file_edge_data>
+        type;
+  };
+
+  //! If true, do not use abstract locks in graph
+  template <bool _has_no_lockable>
+  struct with_no_lockable {
+    typedef LC_Mapped_CSR_Graph<NodeTy, EdgeTy, _has_no_lockable,
+                                UseNumaAlloc, HasOutOfLineLockable, FileEdgeTy>
+        type;
+  };
+
+  //! If true, node data is allocated and the file paged in by the threads
+  //! that own each node range; otherwise, node data is interleaved.
+  template <bool _use_numa_alloc>
+  struct with_numa_alloc {
+    typedef LC_Mapped_CSR_Graph<NodeTy, EdgeTy, HasNoLockable,
+                                _use_numa_alloc, HasOutOfLineLockable,
+                                FileEdgeTy>
+        type;
+  };
+
+  //! If true, store abstract locks separate from nodes
+  template <bool _has_out_of_line_lockable>
+  struct with_out_of_line_lockable {
+    typedef LC_Mapped_CSR_Graph<NodeTy, EdgeTy, HasNoLockable, UseNumaAlloc,
+                                _has_out_of_line_lockable, FileEdgeTy>
+        type;
+  };
+
+  typedef read_mapped_graph_tag read_tag;
+
+protected:
+  typedef LargeArray<EdgeTy> EdgeData;
+  typedef internal::NodeInfoBaseTypes<NodeTy,
+                                      !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfoTypes;
+  typedef internal::NodeInfoBase<NodeTy,
+                                 !HasNoLockable && !HasOutOfLineLockable>
+      NodeInfo;
+  typedef LargeArray<NodeInfo> NodeData;
+
+public:
+  typedef uint32_t GraphNode;
+  typedef EdgeTy edge_data_type;
+  typedef FileEdgeTy file_edge_data_type;
+  typedef NodeTy node_data_type;
+  typedef typename EdgeData::const_reference edge_data_reference;
+  typedef typename NodeInfoTypes::reference node_data_reference;
+  using edge_iterator = boost::counting_iterator<uint64_t>;
+  using iterator      = boost::counting_iterator<GraphNode>;
+  typedef iterator const_iterator;
+  typedef iterator local_iterator;
+  typedef iterator const_local_iterator;
+
+protected:
+  //! Owns the mapping when the graph was read from a file
+  FileGraph fileGraph;
+  NodeData nodeData;
+  //! Zeroed edge data used when a weighted graph is read as unweighted
+  EdgeData unweightedData;
+
+  const uint64_t* edgeIndData = nullptr;
+  const uint32_t* edgeDst     = nullptr;
+  const char* edgeData        = nullptr;
+
+  uint64_t numNodes = 0;
+  uint64_t numEdges = 0;
+
+  //! Stride used to fault in file pages, which are never huge pages
+  static constexpr size_t PAGE_IN_STRIDE = 4096;
+
+  uint64_t raw_begin(GraphNode N) const {
+    return (N == 0) ? 0 : edgeIndData[N - 1];
+  }
+
+  uint64_t raw_end(GraphNode N) const { return edgeIndData[N]; }
+
+  template <bool _A1 = HasNoLockable, bool _A2 = HasOutOfLineLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<!_A1 && !_A2>::type* = 0) {
+    galois::runtime::acquire(&nodeData[N], mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode N, MethodFlag mflag,
+                   typename std::enable_if<_A1 && !_A2>::type* = 0) {
+    this->outOfLineAcquire(N, mflag);
+  }
+
+  template <bool _A1 = HasOutOfLineLockable, bool _A2 = HasNoLockable>
+  void acquireNode(GraphNode, MethodFlag,
+                   typename std::enable_if<_A2>::type* = 0) {}
+
+  static void pageInRange(const void* ptr, size_t len) {
+    if (len)
+      runtime::pageInReadOnly(const_cast<void*>(ptr), len, PAGE_IN_STRIDE);
+  }
+
+public:
+  LC_Mapped_CSR_Graph(LC_Mapped_CSR_Graph&& rhs) = default;
+
+  LC_Mapped_CSR_Graph() = default;
+
+  LC_Mapped_CSR_Graph& operator=(LC_Mapped_CSR_Graph&&) = default;
+
+  node_data_reference getData(GraphNode N,
+                              MethodFlag mflag = MethodFlag::WRITE) {
+    NodeInfo& NI = nodeData[N];
+    acquireNode(N, mflag);
+    return NI.getData();
+  }
+
+  edge_data_reference
+  getEdgeData(edge_iterator ni,
+              MethodFlag GALOIS_UNUSED(mflag) = MethodFlag::UNPROTECTED) const {
+    if constexpr (EdgeData::has_value) {
+      return reinterpret_cast<const EdgeTy*>(edgeData)[*ni];
+    } else {
+      return 0;
+    }
+  }
+
+  GraphNode getEdgeDst(edge_iterator ni) const { return edgeDst[*ni]; }
+
+  size_t size() const { return numNodes; }
+  size_t sizeEdges() const { return numEdges; }
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(numNodes); }
+
+  const_local_iterator local_begin() const {
+    return const_local_iterator(this->localBegin(numNodes));
+  }
+
+  const_local_iterator local_end() const {
+    return const_local_iterator(this->localEnd(numNodes));
+  }
+
+  local_iterator local_begin() {
+    return local_iterator(this->localBegin(numNodes));
+  }
+
+  local_iterator local_end() {
+    return local_iterator(this->localEnd(numNodes));
+  }
+
+  edge_iterator edge_begin(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    if (!HasNoLockable && galois::runtime::shouldLock(mflag)) {
+      for (uint64_t ii = raw_begin(N), ee = raw_end(N); ii != ee; ++ii) {
+        acquireNode(edgeDst[ii], mflag);
+      }
+    }
+    return edge_iterator(raw_begin(N));
+  }
+
+  edge_iterator edge_end(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    acquireNode(N, mflag);
+    return edge_iterator(raw_end(N));
+  }
+
+  uint64_t getDegree(GraphNode N) const { return raw_end(N) - raw_begin(N); }
+
+  edge_iterator findEdge(GraphNode N1, GraphNode N2) {
+    return std::find_if(edge_begin(N1), edge_end(N1),
+                        [=](uint64_t e) { return edgeDst[e] == N2; });
+  }
+
+  //! Requires the neighbors of N1 to be sorted by destination in the file
+  edge_iterator findEdgeSortedByDst(GraphNode N1, GraphNode N2) {
+    const uint32_t* first = edgeDst + raw_begin(N1);
+    const uint32_t* last  = edgeDst + raw_end(N1);
+    return edge_iterator(std::lower_bound(first, last, N2) - edgeDst);
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return internal::make_no_deref_range(edge_begin(N, mflag),
+                                         edge_end(N, mflag));
+  }
+
+  runtime::iterable<NoDerefIterator<edge_iterator>>
+  out_edges(GraphNode N, MethodFlag mflag = MethodFlag::WRITE) {
+    return edges(N, mflag);
+  }
+
+  /**
+   * Maps a .gr file and builds the graph on top of it. The mapping is owned
+   * by this graph.
+   *
+   * @param filename .gr file to map
+   * @param readUnweighted ignore the edge data in the file
+   * @param pageIn fault the file in with all threads, each paging in the
+   * node range it owns, instead of lazily on first access
+   */
+  void mapGraphFromGRFile(const std::string& filename,
+                          const bool readUnweighted = false,
+                          const bool pageIn         = true) {
+    fileGraph = FileGraph();
+    fileGraph.fromFile(filename, false);
+    mapGraphFrom(fileGraph, readUnweighted, pageIn);
+  }
+
+  /**
+   * Builds the graph on top of the arrays of an existing FileGraph without
+   * copying them. The FileGraph must outlive this graph and must hold a
+   * whole graph (not a partFromFile piece).
+   *
+   * @param graph FileGraph to alias
+   * @param readUnweighted ignore the edge data in the file
+   * @param pageIn fault the arrays in with all threads, each paging in the
+   * node range it owns
+   */
+  void mapGraphFrom(FileGraph& graph, const bool readUnweighted = false,
+                    const bool pageIn = true) {
+    if (graph.getGraphVersion() != 1) {
+      GALOIS_DIE("mapped graphs need version 1 gr files, got version ",
+                 graph.getGraphVersion());
+    }
+    if (convert_le32toh(1) != 1) {
+      GALOIS_DIE("mapped graphs need a little-endian host");
+    }
+    if (graph.size() > std::numeric_limits<GraphNode>::max()) {
+      GALOIS_DIE("too many nodes for a mapped graph: ", graph.size());
+    }
+
+    numNodes    = graph.size();
+    numEdges    = graph.sizeEdges();
+    edgeIndData = numNodes ? graph.edge_id_begin().base() : nullptr;
+    edgeDst     = numNodes ? graph.neighbor_begin(0).base() : nullptr;
+    edgeData    = nullptr;
+
+    if constexpr (EdgeData::has_value) {
+      if (readUnweighted) {
+        unweightedData.destroy();
+        unweightedData.deallocate();
+        if (UseNumaAlloc) {
+          unweightedData.allocateBlocked(numEdges);
+        } else {
+          unweightedData.allocateInterleaved(numEdges);
+        }
+        edgeData = reinterpret_cast<const char*>(unweightedData.data());
+      } else {
+        if (graph.edgeSize() != sizeof(EdgeTy)) {
+          GALOIS_DIE("edge data in file has size ", graph.edgeSize(),
+                     ", expected ", sizeof(EdgeTy));
+        }
+        if (numEdges)
+          edgeData = reinterpret_cast<const char*>(
+              graph.edge_data_begin<EdgeTy>());
+      }
+    }
+
+    nodeData.destroy();
+    nodeData.deallocate();
+    if (UseNumaAlloc) {
+      nodeData.allocateBlocked(numNodes);
+      this->outOfLineAllocateBlocked(numNodes);
+    } else {
+      nodeData.allocateInterleaved(numNodes);
+      this->outOfLineAllocateInterleaved(numNodes);
+    }
+
+    const size_t nodeSize = NodeData::size_of::value + sizeof(uint64_t) +
+                            LC_Mapped_CSR_Graph::size_of_out_of_line::value;
+    const size_t edgeSize = sizeof(uint32_t) + EdgeData::size_of::value;
+    galois::on_each([&](unsigned tid, unsigned total) {
+      auto r = divideByNode(nodeSize, edgeSize, tid, total).first;
+      this->setLocalRange(*r.first, *r.second);
+      if (r.first == r.second)
+        return;
+
+      uint64_t ebegin = raw_begin(*r.first);
+      uint64_t eend   = raw_end(*r.second - 1);
+      if (pageIn) {
+        pageInRange(edgeIndData + *r.first,
+                    (*r.second - *r.first) * sizeof(uint64_t));
+        pageInRange(edgeDst + ebegin, (eend - ebegin) * sizeof(uint32_t));
+        if (edgeData && !readUnweighted)
+          pageInRange(edgeData + ebegin * EdgeData::size_of::value,
+                      (eend - ebegin) * EdgeData::size_of::value);
+      }
+
+      for (GraphNode n = *r.first; n < *r.second; ++n) {
+        nodeData.constructAt(n);
+        this->outOfLineConstructAt(n);
+      }
+      if constexpr (EdgeData::has_value) {
+        if (readUnweighted) {
+          for (uint64_t e = ebegin; e < eend; ++e)
+            unweightedData.constructAt(e);
+        }
+      }
+    });
+  }
+
+  /**
+   * Returns the prefix sum of edges, which is the index array of the
+   * mapped file
+   */
+  const uint64_t* getEdgePrefixSum() const { return edgeIndData; }
+
+  auto divideByNode(size_t nodeSize, size_t edgeSize, size_t id, size_t total) {
+    return galois::graphs::divideNodesBinarySearch<const uint64_t*, GraphNode>(
+        numNodes, numEdges, nodeSize, edgeSize, id, total, edgeIndData);
+  }
+
+  /**
+   * Given a manually created graph, initialize the local ranges on this graph
+   * so that threads can iterate over a balanced number of vertices.
+   */
+  void initializeLocalRanges() {
+    galois::on_each([&](unsigned tid, unsigned total) {
+      auto r = divideByNode(0, 1, tid, total).first;
+      this->setLocalRange(*r.first, *r.second);
+    });
+  }
+};
+
+} // namespace galois::graphs
+
+#endif
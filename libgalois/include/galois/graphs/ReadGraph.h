@@ -192,6 +192,46 @@ void readGraphDispatch(GraphTy& graph, read_with_aux_first_graph_tag tag,
   readGraphDispatch(graph, tag, f);
 }
 
+/**
+ * Compressed graphs are read directly from .zgr files; any other input is
+ * loaded as a FileGraph and compressed while constructing the graph.
+ */
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_compressed_graph_tag,
+                       const std::string& filename,
+                       const bool readUnweighted = false) {
+  const std::string ext = ".zgr";
+  if (filename.size() >= ext.size() &&
+      filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0) {
+    graph.readGraphFromZGRFile(filename, readUnweighted);
+    return;
+  }
+  readGraphDispatch(graph, read_default_graph_tag(), filename, readUnweighted);
+}
+
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_compressed_graph_tag, FileGraph& f,
+                       const bool readUnweighted = false) {
+  readGraphDispatch(graph, read_default_graph_tag(), f, readUnweighted);
+}
+
+/**
+ * Mapped graphs alias the .gr file instead of copying it; when given a
+ * FileGraph, the FileGraph must outlive the graph.
+ */
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_mapped_graph_tag,
+                       const std::string& filename,
+                       const bool readUnweighted = false) {
+  graph.mapGraphFromGRFile(filename, readUnweighted);
+}
+
+template <typename GraphTy>
+void readGraphDispatch(GraphTy& graph, read_mapped_graph_tag, FileGraph& f,
+                       const bool readUnweighted = false) {
+  graph.mapGraphFrom(f, readUnweighted);
+}
+
 template <typename GraphTy>
 void readGraphDispatch(GraphTy& graph, read_lc_inout_graph_tag,
                        const std::string& f1, const std::string& f2) {
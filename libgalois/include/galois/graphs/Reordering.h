@@ -0,0 +1,444 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file Reordering.h
+ *
+ * In-memory node reordering of LC_CSR_Graph: computing an order that
+ * improves locality and permuting a graph into it.
+ */
+
+#ifndef GALOIS_GRAPHS_REORDERING_H
+#define GALOIS_GRAPHS_REORDERING_H
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Timer.h"
+#include "galois/gIO.h"
+
+namespace galois {
+namespace graphs {
+
+//! Node orders computed by computeReordering
+enum class ReorderAlgo {
+  NONE,        //!< keep the input order
+  DEGREE_SORT, //!< decreasing out-degree
+  HUB_SORT,    //!< hubs by decreasing degree, then the rest in input order
+  HUB_CLUSTER, //!< hubs, then the rest, both in input order
+  RCM,         //!< reverse Cuthill-McKee
+  GORDER       //!< windowed approximation of Gorder
+};
+
+//! Returns a short name of the reordering algorithm
+inline const char* reorderAlgoName(ReorderAlgo algo) {
+  switch (algo) {
+  case ReorderAlgo::NONE:
+    return "none";
+  case ReorderAlgo::DEGREE_SORT:
+    return "degree";
+  case ReorderAlgo::HUB_SORT:
+    return "hubsort";
+  case ReorderAlgo::HUB_CLUSTER:
+    return "hubcluster";
+  case ReorderAlgo::RCM:
+    return "rcm";
+  case ReorderAlgo::GORDER:
+    return "gorder";
+  default:
+    GALOIS_DIE("unknown reordering algorithm");
+  }
+}
+
+namespace internal {
+
+template <typename Graph>
+std::vector<uint64_t> outDegrees(Graph& graph) {
+  std::vector<uint64_t> degrees(graph.size());
+  galois::do_all(
+      galois::iterate(size_t{0}, graph.size()),
+      [&](size_t n) {
+        degrees[n] = std::distance(graph.edge_begin(n), graph.edge_end(n));
+      },
+      galois::no_stats());
+  return degrees;
+}
+
+//! Inverts an order (position to node) into a mapping (node to position)
+inline std::vector<uint32_t>
+orderToMapping(const std::vector<uint32_t>& order) {
+  std::vector<uint32_t> oldToNew(order.size());
+  galois::do_all(
+      galois::iterate(size_t{0}, order.size()),
+      [&](size_t i) { oldToNew[order[i]] = i; }, galois::no_stats());
+  return oldToNew;
+}
+
+/**
+ * Places hubs (nodes with more than average degree) first, optionally sorted
+ * by decreasing degree, followed by the other nodes in input order.
+ */
+inline std::vector<uint32_t> hubOrder(const std::vector<uint64_t>& degrees,
+                                      uint64_t numEdges, bool sortHubs) {
+  size_t numNodes    = degrees.size();
+  uint64_t avgDegree = numNodes ? numEdges / numNodes : 0;
+
+  std::vector<uint64_t> isHub(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) { isHub[n] = degrees[n] > avgDegree; }, galois::no_stats());
+  std::vector<uint64_t> hubPrefix(numNodes);
+  galois::ParallelSTL::partial_sum(isHub.begin(), isHub.end(),
+                                   hubPrefix.begin());
+  uint64_t numHubs = numNodes ? hubPrefix.back() : 0;
+
+  std::vector<uint32_t> order(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        if (isHub[n]) {
+          order[hubPrefix[n] - 1] = n;
+        } else {
+          order[numHubs + n - hubPrefix[n]] = n;
+        }
+      },
+      galois::no_stats());
+
+  if (sortHubs) {
+    std::stable_sort(order.begin(), order.begin() + numHubs,
+                     [&](uint32_t a, uint32_t b) {
+                       return degrees[a] > degrees[b];
+                     });
+  }
+  return order;
+}
+
+/**
+ * Reverse Cuthill-McKee over out-edges: a BFS from a low-degree node of
+ * each component that visits neighbors by increasing degree, reversed.
+ */
+template <typename Graph>
+std::vector<uint32_t> rcmOrder(Graph& graph,
+                               const std::vector<uint64_t>& degrees) {
+  size_t numNodes = graph.size();
+  std::vector<uint32_t> byDegree(numNodes);
+  std::iota(byDegree.begin(), byDegree.end(), 0);
+  galois::ParallelSTL::sort(byDegree.begin(), byDegree.end(),
+                            [&](uint32_t a, uint32_t b) {
+                              return degrees[a] < degrees[b] ||
+                                     (degrees[a] == degrees[b] && a < b);
+                            });
+
+  std::vector<uint32_t> order;
+  order.reserve(numNodes);
+  std::vector<bool> visited(numNodes);
+  std::vector<uint32_t> neighbors;
+
+  for (uint32_t root : byDegree) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    // the order vector doubles as the BFS queue
+    size_t head = order.size();
+    order.push_back(root);
+    for (; head < order.size(); ++head) {
+      uint32_t n = order[head];
+      neighbors.clear();
+      for (auto e : graph.edges(n, galois::MethodFlag::UNPROTECTED)) {
+        uint32_t dst = graph.getEdgeDst(e);
+        if (!visited[dst]) {
+          visited[dst] = true;
+          neighbors.push_back(dst);
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end(),
+                [&](uint32_t a, uint32_t b) {
+                  return degrees[a] < degrees[b] ||
+                         (degrees[a] == degrees[b] && a < b);
+                });
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+/**
+ * Greedy Gorder (Wei et al., SIGMOD 2016): repeatedly places the node that
+ * shares the most edges and in-neighbors with the last window nodes placed.
+ * Scores are kept in a lazy max-heap instead of Gorder's unit heap, and
+ * in-neighbors with more than sqrt(|V|) out-edges are not expanded when
+ * counting shared in-neighbors, as in the original.
+ */
+template <typename Graph>
+std::vector<uint32_t> gorderOrder(Graph& graph,
+                                  const std::vector<uint64_t>& degrees,
+                                  unsigned window) {
+  constexpr galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
+  size_t numNodes                   = graph.size();
+
+  // in-edges in CSR form
+  std::vector<uint64_t> inIndex(numNodes + 1);
+  std::vector<uint32_t> inSrc(graph.sizeEdges());
+  for (size_t n = 0; n < numNodes; ++n) {
+    for (auto e : graph.edges(n, flag)) {
+      ++inIndex[graph.getEdgeDst(e) + 1];
+    }
+  }
+  std::partial_sum(inIndex.begin(), inIndex.end(), inIndex.begin());
+  {
+    std::vector<uint64_t> pos(inIndex.begin(), inIndex.end() - 1);
+    for (size_t n = 0; n < numNodes; ++n) {
+      for (auto e : graph.edges(n, flag)) {
+        inSrc[pos[graph.getEdgeDst(e)]++] = n;
+      }
+    }
+  }
+
+  // seeds when no candidate shares anything with the window
+  std::vector<uint32_t> byInDegree(numNodes);
+  std::iota(byInDegree.begin(), byInDegree.end(), 0);
+  galois::ParallelSTL::sort(byInDegree.begin(), byInDegree.end(),
+                            [&](uint32_t a, uint32_t b) {
+                              uint64_t da = inIndex[a + 1] - inIndex[a];
+                              uint64_t db = inIndex[b + 1] - inIndex[b];
+                              return da > db || (da == db && a < b);
+                            });
+
+  uint64_t hubDegree = std::sqrt(numNodes);
+  std::vector<int64_t> score(numNodes);
+  std::vector<bool> placed(numNodes);
+  std::priority_queue<std::pair<int64_t, uint32_t>> heap;
+
+  auto bump = [&](uint32_t u, int64_t delta) {
+    if (!placed[u]) {
+      score[u] += delta;
+      if (score[u] > 0) {
+        heap.emplace(score[u], u);
+      }
+    }
+  };
+  auto adjust = [&](uint32_t v, int64_t delta) {
+    for (auto e : graph.edges(v, flag)) {
+      bump(graph.getEdgeDst(e), delta);
+    }
+    for (uint64_t i = inIndex[v]; i < inIndex[v + 1]; ++i) {
+      uint32_t w = inSrc[i];
+      bump(w, delta);
+      if (degrees[w] <= hubDegree) {
+        for (auto e : graph.edges(w, flag)) {
+          uint32_t sibling = graph.getEdgeDst(e);
+          if (sibling != v) {
+            bump(sibling, delta);
+          }
+        }
+      }
+    }
+  };
+
+  std::vector<uint32_t> order;
+  order.reserve(numNodes);
+  std::deque<uint32_t> recent;
+  size_t nextSeed = 0;
+
+  while (order.size() < numNodes) {
+    uint32_t next = numNodes;
+    while (!heap.empty()) {
+      auto top = heap.top();
+      heap.pop();
+      if (!placed[top.second] && top.first == score[top.second]) {
+        next = top.second;
+        break;
+      }
+    }
+    if (next == numNodes) {
+      while (placed[byInDegree[nextSeed]]) {
+        ++nextSeed;
+      }
+      next = byInDegree[nextSeed];
+    }
+
+    placed[next] = true;
+    order.push_back(next);
+    recent.push_back(next);
+    adjust(next, 1);
+    if (recent.size() > window) {
+      adjust(recent.front(), -1);
+      recent.pop_front();
+    }
+  }
+
+  return order;
+}
+
+} // namespace internal
+
+/**
+ * Computes a new order of the nodes of graph.
+ *
+ * Degree computation, sorting and mapping construction run in parallel; the
+ * traversal-based orders (RCM and Gorder) are inherently sequential.
+ *
+ * @param graph graph to reorder; only out-edges are used
+ * @param algo ordering to compute
+ * @param window Gorder window size
+ * @returns mapping from old to new node ids
+ */
+template <typename Graph>
+std::vector<uint32_t> computeReordering(Graph& graph, ReorderAlgo algo,
+                                        unsigned window = 5) {
+  std::vector<uint64_t> degrees = internal::outDegrees(graph);
+  std::vector<uint32_t> order(graph.size());
+
+  switch (algo) {
+  case ReorderAlgo::NONE:
+    std::iota(order.begin(), order.end(), 0);
+    break;
+  case ReorderAlgo::DEGREE_SORT:
+    std::iota(order.begin(), order.end(), 0);
+    galois::ParallelSTL::sort(order.begin(), order.end(),
+                              [&](uint32_t a, uint32_t b) {
+                                return degrees[a] > degrees[b] ||
+                                       (degrees[a] == degrees[b] && a < b);
+                              });
+    break;
+  case ReorderAlgo::HUB_SORT:
+    order = internal::hubOrder(degrees, graph.sizeEdges(), true);
+    break;
+  case ReorderAlgo::HUB_CLUSTER:
+    order = internal::hubOrder(degrees, graph.sizeEdges(), false);
+    break;
+  case ReorderAlgo::RCM:
+    order = internal::rcmOrder(graph, degrees);
+    break;
+  case ReorderAlgo::GORDER:
+    order = internal::gorderOrder(graph, degrees, window);
+    break;
+  default:
+    GALOIS_DIE("unknown reordering algorithm");
+  }
+
+  return internal::orderToMapping(order);
+}
+
+/**
+ * Permutes an LC_CSR_Graph in parallel: node n of the old graph becomes node
+ * oldToNew[n], keeping its edges and edge data. Edges of each node end up
+ * sorted by their new destination. Node data is not moved (it may point into
+ * the graph, as with UnionFindNode), so reorder before initializing it.
+ *
+ * @param graph graph to permute in place
+ * @param oldToNew mapping from old to new node ids; must be a permutation
+ */
+template <typename Graph>
+void permuteGraph(Graph& graph, const std::vector<uint32_t>& oldToNew) {
+  using EdgeData = typename Graph::edge_data_type;
+  constexpr galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
+
+  size_t numNodes = graph.size();
+  assert(oldToNew.size() == numNodes);
+
+  std::vector<uint64_t> newDegrees(numNodes);
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        newDegrees[oldToNew[n]] =
+            std::distance(graph.edge_begin(n, flag), graph.edge_end(n, flag));
+      },
+      galois::no_stats());
+  std::vector<uint64_t> newPrefixSum(numNodes);
+  galois::ParallelSTL::partial_sum(newDegrees.begin(), newDegrees.end(),
+                                   newPrefixSum.begin());
+
+  // gather the permuted edges first since they overwrite those of graph
+  std::vector<uint32_t> newDst(graph.sizeEdges());
+  std::vector<typename LargeArray<EdgeData>::value_type> newEdgeData(
+      LargeArray<EdgeData>::has_value ? graph.sizeEdges() : 0);
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        uint32_t newID = oldToNew[n];
+        uint64_t e     = newPrefixSum[newID] - newDegrees[newID];
+        for (auto ii : graph.edges(n, flag)) {
+          newDst[e] = oldToNew[graph.getEdgeDst(ii)];
+          if constexpr (!std::is_void<EdgeData>::value) {
+            newEdgeData[e] = graph.getEdgeData(ii, flag);
+          }
+          ++e;
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  galois::do_all(
+      galois::iterate(size_t{0}, numNodes),
+      [&](size_t n) {
+        graph.fixEndEdge(n, newPrefixSum[n]);
+        for (uint64_t e = newPrefixSum[n] - newDegrees[n]; e < newPrefixSum[n];
+             ++e) {
+          if constexpr (std::is_void<EdgeData>::value) {
+            graph.constructEdge(e, newDst[e]);
+          } else {
+            graph.constructEdge(e, newDst[e], newEdgeData[e]);
+          }
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  graph.sortAllEdgesByDst(flag);
+  graph.initializeLocalRanges();
+}
+
+/**
+ * Reorders graph in memory with the given algorithm.
+ *
+ * @returns mapping from old to new node ids
+ */
+template <typename Graph>
+std::vector<uint32_t> reorderGraph(Graph& graph, ReorderAlgo algo,
+                                   unsigned window = 5) {
+  galois::StatTimer computeTimer("ComputeReordering", "Reordering");
+  computeTimer.start();
+  std::vector<uint32_t> oldToNew = computeReordering(graph, algo, window);
+  computeTimer.stop();
+
+  galois::StatTimer permuteTimer("PermuteGraph", "Reordering");
+  permuteTimer.start();
+  permuteGraph(graph, oldToNew);
+  permuteTimer.stop();
+
+  return oldToNew;
+}
+
+} // namespace graphs
+} // namespace galois
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_RUNTIME_ADAPTIVECHUNK_H
+#define GALOIS_RUNTIME_ADAPTIVECHUNK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace runtime {
+
+/**
+ * Per-thread chunk size controller for loops run with
+ * {@link galois::adaptive_chunk}. The size doubles while full chunks finish
+ * faster than TARGET_LOW_NS, which amortizes scheduling overhead on regular
+ * loops, and halves when a chunk takes longer than TARGET_HIGH_NS or the thread
+ * had to steal work, which indicates that the remaining work is unevenly
+ * spread.
+ */
+class AdaptiveChunk {
+  using Clock = std::chrono::steady_clock;
+
+  unsigned size;
+  unsigned minSize;
+  unsigned maxSize;
+  Clock::time_point start;
+
+public:
+  static constexpr uint64_t TARGET_LOW_NS  = 10000;
+  static constexpr uint64_t TARGET_HIGH_NS = 100000;
+
+  AdaptiveChunk(unsigned initial, unsigned min, unsigned max)
+      : size(std::min(std::max(initial, min), max)), minSize(min),
+        maxSize(max) {}
+
+  unsigned get() const { return size; }
+
+  //! Marks the start of a chunk
+  void begin() { start = Clock::now(); }
+
+  //! Marks the end of a chunk; partial chunks can only shrink the size
+  void end(bool full) {
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Clock::now() - start)
+                      .count();
+    if (ns > TARGET_HIGH_NS)
+      size = std::max(size / 2, minSize);
+    else if (full && ns < TARGET_LOW_NS)
+      size = std::min(size * 2, maxSize);
+  }
+
+  //! Records that this thread ran out of work and stole from another
+  void stole() { size = std::max(size / 2, minSize); }
+};
+
+//! Sizes a thread's controller picked, one sample per chunk it took
+struct ChunkSizeSamples {
+  size_t count = 0;
+  size_t sum   = 0;
+  size_t min   = std::numeric_limits<size_t>::max();
+  size_t max   = 0;
+
+  void add(size_t size) {
+    ++count;
+    sum += size;
+    min = std::min(min, size);
+    max = std::max(max, size);
+  }
+};
+
+//! Chunk size controller with the same interface as AdaptiveChunk that keeps
+//! the initial size
+class FixedChunk {
+  unsigned size;
+
+public:
+  FixedChunk(unsigned initial, unsigned, unsigned) : size(initial) {}
+
+  unsigned get() const { return size; }
+  void begin() {}
+  void end(bool) {}
+  void stole() {}
+};
+
+} // namespace runtime
+} // namespace galois
+
+#endif
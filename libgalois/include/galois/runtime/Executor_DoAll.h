@@ -22,15 +22,19 @@
 
 #include "galois/config.h"
 #include "galois/gIO.h"
+#include "galois/runtime/AdaptiveChunk.h"
 #include "galois/runtime/Executor_OnEach.h"
+#include "galois/runtime/LoopStatistics.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
 #include "galois/runtime/Statistics.h"
+#include "galois/runtime/TaskScheduler.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/PaddedLock.h"
 #include "galois/substrate/PerThreadStorage.h"
 #include "galois/substrate/Termination.h"
 #include "galois/substrate/ThreadPool.h"
+#include "galois/substrate/Trace.h"
 #include "galois/Timer.h"
 
 namespace galois::runtime {
@@ -50,6 +54,11 @@ class DoAllStealingExec {
   constexpr static const bool MORE_STATS =
       NEED_STATS && has_trait<more_stats_tag, ArgsTuple>();
   constexpr static const bool USE_TERM = false;
+  constexpr static const bool ADAPTIVE =
+      has_trait<adaptive_chunk_tag, ArgsTuple>();
+
+  using ChunkCtl   = std::conditional_t<ADAPTIVE, AdaptiveChunk, FixedChunk>;
+  using ChunkStats = ChunkStatistics<NEED_STATS && ADAPTIVE>;
 
   struct ThreadContext {
 
@@ -74,22 +83,32 @@ class DoAllStealingExec {
         : work_mutex(), id(id), shared_beg(beg), shared_end(end),
           m_size(std::distance(beg, end)), num_iter(0) {}
 
-    bool doWork(F func, const unsigned chunk_size) {
+    bool doWork(F func, ChunkCtl& chunk, ChunkStats& chunkStats,
+                const char* loopname) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
       bool didwork = false;
 
-      while (getWork(beg, end, chunk_size)) {
+      while (getWork(beg, end, chunk.get())) {
 
         didwork = true;
 
+        chunkStats.inc_chunks(chunk.get());
+        chunk.begin();
+        size_t items = 0;
+        substrate::TraceSpan span(substrate::TraceCategory::CHUNK, loopname);
+
         for (; beg != end; ++beg) {
           if (NEED_STATS) {
             ++num_iter;
           }
+          ++items;
           func(*beg);
         }
+
+        chunk.end(items == chunk.get());
+        span.setArg(items);
       }
 
       return didwork;
@@ -407,6 +426,10 @@ public:
   void operator()(void) {
 
     ThreadContext& ctx = *workers.getLocal();
+    ChunkCtl chunk(chunk_size, chunk_size_tag::MIN, chunk_size_tag::MAX);
+    ChunkStats chunkStats(loopname);
+    PerfCounterStatistics<NEED_STATS> counters(loopname);
+    substrate::TraceSpan span(substrate::TraceCategory::LOOP, loopname);
     totalTime.start();
 
     while (true) {
@@ -414,7 +437,7 @@ public:
 
       execTime.start();
 
-      if (ctx.doWork(func, chunk_size)) {
+      if (ctx.doWork(func, chunk, chunkStats, loopname)) {
         workHappened = true;
       }
 
@@ -423,10 +446,16 @@ public:
       assert(!ctx.hasWork());
 
       stealTime.start();
-      bool stole = trySteal(ctx);
+      bool stole;
+      {
+        substrate::TraceSpan steal(substrate::TraceCategory::STEAL, loopname);
+        stole = trySteal(ctx);
+        steal.setArg(stole);
+      }
       stealTime.stop();
 
       if (stole) {
+        chunk.stole();
         continue;
 
       } else {
@@ -493,6 +522,8 @@ struct ChooseDoAllImpl<false> {
           PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
           PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
+          PerfCounterStatistics<NEED_STATS> counters(loopname);
+          substrate::TraceSpan span(substrate::TraceCategory::LOOP, loopname);
 
           totalTime.start();
           initTime.start();
@@ -540,14 +571,22 @@ void do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
 
   using ArgsT = decltype(argsT);
 
+  OperatorReferenceType<decltype(std::forward<F>(func))> func_ref = func;
+
+  // nested in a task: run as tasks on the threads already running
+  if (TaskScheduler* sched = TaskScheduler::current()) {
+    sched->parallelFor(range.begin(), range.end(), func_ref);
+    return;
+  }
+
   constexpr bool TIME_IT = has_trait<loopname_tag, ArgsT>();
   CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(argsT));
 
   timer.start();
 
-  constexpr bool STEAL = has_trait<steal_tag, ArgsT>();
+  constexpr bool STEAL = has_trait<steal_tag, ArgsT>() ||
+                        has_trait<adaptive_chunk_tag, ArgsT>();
 
-  OperatorReferenceType<decltype(std::forward<F>(func))> func_ref = func;
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
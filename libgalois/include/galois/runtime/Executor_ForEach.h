@@ -38,6 +38,7 @@
 #include "galois/runtime/UserContextAccess.h"
 #include "galois/substrate/Termination.h"
 #include "galois/substrate/ThreadPool.h"
+#include "galois/substrate/Trace.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
 #include "galois/Traits.h"
@@ -157,6 +158,7 @@ public:
   static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
   static constexpr bool MORE_STATS =
       needStats && has_trait<more_stats_tag, ArgsTy>();
+  static constexpr bool ADAPTIVE = has_trait<adaptive_chunk_tag, ArgsTy>();
 
 protected:
   typedef typename WorkListTy::value_type value_type;
@@ -303,10 +305,20 @@ protected:
     return wl.empty();
   }
 
+  void recordChunkSize(WorkListTy&, ThreadLocalData&, ...) {}
+
+  template <typename WL>
+  auto recordChunkSize(WL& wl, ThreadLocalData& tld, int)
+      -> decltype(wl.chunkSizeSamples(), void()) {
+    if (ADAPTIVE)
+      tld.merge_chunks(wl.chunkSizeSamples());
+  }
+
   template <bool couldAbort, bool isLeader>
   void go() {
 
     execTime.start();
+    substrate::TraceSpan span(substrate::TraceCategory::LOOP, loopname);
 
     // Thread-local data goes on the local stack to be NUMA friendly
     ThreadLocalData tld(origFunction, loopname);
@@ -319,6 +331,11 @@ protected:
                                            std::placeholders::_1));
 
     while (true) {
+      // time from the last work found to global termination
+      substrate::TraceSpan idle(substrate::TraceCategory::TERMINATION,
+                                loopname);
+      size_t idleRounds = 0;
+
       do {
         bool didWork = false;
 
@@ -337,6 +354,13 @@ protected:
           didWork = b || didWork;
         }
 
+        if (didWork) {
+          idle.restart();
+          idleRounds = 0;
+        } else {
+          idle.setArg(++idleRounds);
+        }
+
         // Update node color and prop token
         term.localTermination(didWork);
         substrate::asmPause(); // Let token propagate
@@ -353,9 +377,11 @@ protected:
       }
 
       term.initializeThread();
-      barrier.wait();
+      barrier();
     }
 
+    recordChunkSize(wl, tld, 0);
+
     if (couldAbort)
       setThreadContext(0);
   }
@@ -426,6 +452,31 @@ constexpr auto has_with_iterator(...) -> bool {
   return false;
 }
 
+template <typename WLTy>
+constexpr auto has_with_adaptive_chunk(int)
+    -> decltype(std::declval<
+                    typename WLTy::template with_adaptive_chunk<true>>(),
+                bool()) {
+  return true;
+}
+
+template <typename>
+constexpr auto has_with_adaptive_chunk(...) -> bool {
+  return false;
+}
+
+template <typename WLTy, bool Adaptive, typename Enable = void>
+struct readapt {
+  typedef WLTy type;
+};
+
+template <typename WLTy>
+struct readapt<
+    WLTy, true,
+    typename std::enable_if<has_with_adaptive_chunk<WLTy>(0)>::type> {
+  typedef typename WLTy::template with_adaptive_chunk<true> type;
+};
+
 template <typename WLTy, typename IterTy, typename Enable = void>
 struct reiterator {
   typedef WLTy type;
@@ -443,9 +494,11 @@ void for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
   typedef typename std::iterator_traits<typename RangeTy::iterator>::value_type
       value_type;
   typedef typename get_trait_type<wl_tag, ArgsTy>::type::type BaseWorkListTy;
-  typedef typename reiterator<BaseWorkListTy, typename RangeTy::iterator>::
-      type ::template retype<value_type>
-          WorkListTy;
+  typedef typename readapt<
+      typename reiterator<BaseWorkListTy, typename RangeTy::iterator>::type,
+      has_trait<adaptive_chunk_tag, ArgsTy>()>::type ::template retype<
+      value_type>
+      WorkListTy;
   using FuncRefType =
       OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))>;
   typedef ForEachExecutor<WorkListTy, FuncRefType, ArgsTy> WorkTy;
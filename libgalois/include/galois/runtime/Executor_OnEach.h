@@ -24,6 +24,7 @@
 #include "galois/gIO.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
 #include "galois/runtime/Statistics.h"
+#include "galois/runtime/TaskScheduler.h"
 #include "galois/runtime/ThreadTimer.h"
 #include "galois/substrate/ThreadPool.h"
 #include "galois/Threads.h"
@@ -51,10 +52,16 @@ inline void on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
 
   PerThreadTimer<MORE_STATS> execTime(loopname, "Execute");
 
-  const auto numT = getActiveThreads();
-
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
+  // nested in a task: the other threads are busy with their own tasks
+  if (TaskScheduler::current()) {
+    fn_ref(0, 1);
+    return;
+  }
+
+  const auto numT = getActiveThreads();
+
   auto runFun = [&] {
     execTime.start();
 
@@ -20,15 +20,79 @@
 #ifndef GALOIS_RUNTIME_LOOPSTATISTICS_H
 #define GALOIS_RUNTIME_LOOPSTATISTICS_H
 
+#include <algorithm>
+#include <limits>
+
 #include "galois/config.h"
+#include "galois/runtime/AdaptiveChunk.h"
+#include "galois/runtime/PerfCounters.h"
 #include "galois/runtime/Statistics.h"
 
 namespace galois {
 namespace runtime {
 
+/**
+ * Chunk sizes picked by loops run with {@link galois::adaptive_chunk}. Nothing
+ * is reported unless a chunk size was recorded.
+ */
+template <bool Enabled>
+class ChunkStatistics {
+
+protected:
+  size_t m_chunks;
+  size_t m_chunkItems;
+  size_t m_minChunk;
+  size_t m_maxChunk;
+  const char* loopname;
+
+public:
+  explicit ChunkStatistics(const char* ln)
+      : m_chunks(0), m_chunkItems(0),
+        m_minChunk(std::numeric_limits<size_t>::max()), m_maxChunk(0),
+        loopname(ln) {}
+
+  ~ChunkStatistics() {
+    if (!m_chunks)
+      return;
+    reportStat_Tsum(loopname, "Chunks", m_chunks);
+    reportStat_Tmin(loopname, "ChunkSizeMin", m_minChunk);
+    reportStat_Tmax(loopname, "ChunkSizeMax", m_maxChunk);
+    reportStat_Tavg(loopname, "ChunkSizeAvg", m_chunkItems / m_chunks);
+  }
+
+  size_t chunks(void) const { return m_chunks; }
+
+  inline void inc_chunks(size_t size) {
+    ++m_chunks;
+    m_chunkItems += size;
+    m_minChunk = std::min(m_minChunk, size);
+    m_maxChunk = std::max(m_maxChunk, size);
+  }
+
+  inline void merge_chunks(const ChunkSizeSamples& samples) {
+    m_chunks += samples.count;
+    m_chunkItems += samples.sum;
+    m_minChunk = std::min(m_minChunk, samples.min);
+    m_maxChunk = std::max(m_maxChunk, samples.max);
+  }
+};
+
+template <>
+class ChunkStatistics<false> {
+public:
+  explicit ChunkStatistics(const char*) {}
+
+  size_t chunks(void) const { return 0; }
+
+  inline void inc_chunks(size_t) const {}
+
+  inline void merge_chunks(const ChunkSizeSamples&) const {}
+};
+
 // Usually instantiated per thread
 template <bool Enabled>
-class LoopStatistics {
+class LoopStatistics : public ChunkStatistics<Enabled>,
+                       public PerfCounterStatistics<Enabled> {
 
 protected:
   size_t m_iterations;
@@ -38,7 +102,8 @@ protected:
 
 public:
   explicit LoopStatistics(const char* ln)
-      : m_iterations(0), m_pushes(0), m_conflicts(0), loopname(ln) {}
+      : ChunkStatistics<Enabled>(ln), PerfCounterStatistics<Enabled>(ln),
+        m_iterations(0), m_pushes(0), m_conflicts(0), loopname(ln) {}
 
   ~LoopStatistics() {
     reportStat_Tsum(loopname, "Iterations", m_iterations);
@@ -59,9 +124,11 @@ public:
 };
 
 template <>
-class LoopStatistics<false> {
+class LoopStatistics<false> : public ChunkStatistics<false>,
+                              public PerfCounterStatistics<false> {
 public:
-  explicit LoopStatistics(const char*) {}
+  explicit LoopStatistics(const char* ln)
+      : ChunkStatistics<false>(ln), PerfCounterStatistics<false>(ln) {}
 
   size_t iterations(void) const { return 0; }
   size_t pushes(void) const { return 0; }
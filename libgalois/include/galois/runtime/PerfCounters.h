@@ -0,0 +1,128 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_RUNTIME_PERFCOUNTERS_H
+#define GALOIS_RUNTIME_PERFCOUNTERS_H
+
+#include <cstdint>
+
+#include "galois/config.h"
+#include "galois/runtime/Statistics.h"
+
+namespace galois {
+namespace runtime {
+
+//! Hardware events sampled by {@link PerfCounterStatistics}
+enum PerfCounter : unsigned {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_LLC_MISSES,
+  PERF_DTLB_MISSES,
+  PERF_BRANCH_MISSES,
+  NUM_PERF_COUNTERS
+};
+
+//! Statistic names of the events, indexed by {@link PerfCounter}
+extern const char* const perfCounterNames[NUM_PERF_COUNTERS];
+
+/**
+ * Returns a bitmask of the {@link PerfCounter}s that can be read by the calling
+ * thread. Counters are only opened when the environment variable
+ * GALOIS_PERF_EVENTS is set and the kernel grants access to them
+ * (perf_event_paranoid <= 2 for user-space counting); otherwise the mask is 0.
+ */
+unsigned perfCountersAvailable();
+
+//! One reading of the calling thread's counters
+struct PerfCounterSample {
+  uint64_t vals[NUM_PERF_COUNTERS];
+  //! Nanoseconds the counters were enabled and actually counting; running is
+  //! less than enabled when the kernel multiplexes more events than the PMU
+  //! has counters
+  uint64_t enabled;
+  uint64_t running;
+};
+
+/**
+ * Reads the calling thread's counters into sample. Counters that are not
+ * available are left untouched. Returns false if no counter is available or
+ * the read fails.
+ */
+bool perfCountersRead(PerfCounterSample& sample);
+
+/**
+ * Returns the count of event i between start and end, scaled up by the
+ * fraction of the time that the counters were not running. Returns 0 if they
+ * did not run at all.
+ */
+inline uint64_t perfCounterDelta(const PerfCounterSample& start,
+                                 const PerfCounterSample& end, unsigned i) {
+  uint64_t enabled = end.enabled - start.enabled;
+  uint64_t running = end.running - start.running;
+  uint64_t count   = end.vals[i] - start.vals[i];
+  if (running == 0)
+    return 0;
+  if (running >= enabled)
+    return count;
+  return static_cast<uint64_t>(double(count) * enabled / running);
+}
+
+/**
+ * Per-thread hardware counters for a named loop. The counters are sampled on
+ * construction and destruction, and the difference is reported with
+ * reportStat_Tsum under the loop name. Nothing is reported if either read
+ * fails.
+ */
+template <bool Enabled>
+class PerfCounterStatistics {
+  PerfCounterSample m_start;
+  unsigned m_mask;
+  const char* loopname;
+
+public:
+  explicit PerfCounterStatistics(const char* ln)
+      : m_mask(perfCountersAvailable()), loopname(ln) {
+    if (m_mask && !perfCountersRead(m_start))
+      m_mask = 0;
+  }
+
+  ~PerfCounterStatistics() {
+    if (!m_mask)
+      return;
+    PerfCounterSample end;
+    if (!perfCountersRead(end))
+      return;
+    for (unsigned i = 0; i < NUM_PERF_COUNTERS; ++i) {
+      if (m_mask & (1u << i))
+        reportStat_Tsum(loopname, perfCounterNames[i],
+                        perfCounterDelta(m_start, end, i));
+    }
+  }
+};
+
+template <>
+class PerfCounterStatistics<false> {
+public:
+  explicit PerfCounterStatistics(const char*) {}
+};
+
+} // namespace runtime
+} // namespace galois
+
+#endif
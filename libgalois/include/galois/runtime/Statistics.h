@@ -22,8 +22,11 @@
 
 #include <limits>
 #include <map>
+#include <ostream>
+#include <sstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -332,15 +335,110 @@ using ScalarStatManager = BasicStatMap<ScalarStat<T>>;
 
 } // end namespace internal
 
+//! Layouts supported by {@link StatManager::print}
+enum class StatFormat { TEXT, CSV, JSON };
+
+//! Run-wide fields repeated in structured (CSV/JSON) stats output
+struct StatRunInfo {
+  std::string uuid;
+  std::string hostname;
+  std::string input;
+  std::string version;
+  std::string revision;
+  unsigned threads = 0;
+  unsigned hosts   = 1;
+};
+
+/**
+ * One statistic flattened to strings for structured output. Records with scope
+ * "total" carry the value combined over all hosts; records with scope "host"
+ * carry the breakdown of a single host.
+ */
+struct StatRecord {
+  const char* kind  = "";
+  const char* scope = "total";
+  int host          = -1;
+  std::string region;
+  std::string category;
+  std::string totalTy;
+  std::string total;
+  std::string min;
+  std::string max;
+  std::string mean;
+  //! per-thread values, or per-host values for distributed totals
+  std::vector<std::string> values;
+  bool numeric = true;
+};
+
+/**
+ * Writes {@link StatRecord}s as CSV (one header row, then one row per record
+ * with the run info repeated) or as JSON lines (one "run" object followed by
+ * one object per record). Both carry {@link StatWriter::SCHEMA_VERSION}.
+ */
+class StatWriter {
+  std::ostream& out;
+  StatFormat format;
+  StatRunInfo info;
+
+public:
+  static constexpr unsigned SCHEMA_VERSION = 1;
+
+  StatWriter(std::ostream& out, StatFormat format, const StatRunInfo& info);
+
+  void write(const StatRecord& r);
+};
+
+namespace internal {
+
+template <typename T>
+std::string statToStr(const T& val) {
+  std::ostringstream ss;
+  ss << val;
+  return ss.str();
+}
+
+template <typename T>
+void fillStatAggregates(StatRecord& r, const VecStat<T>& s) {
+  if (s.values().empty()) {
+    return;
+  }
+  r.min  = statToStr(s.min());
+  r.max  = statToStr(s.max());
+  r.mean = statToStr(double(s.sum()) / s.count());
+}
+
+inline void fillStatAggregates(StatRecord& r, const VecStat<gstl::Str>&) {
+  r.numeric = false;
+}
+
+template <typename S, typename T>
+StatRecord makeStatRecord(const char* kind, const S& region, const S& category,
+                          const char* totalTy, const VecStat<T>& s) {
+  StatRecord r;
+  r.kind     = kind;
+  r.region   = statToStr(region);
+  r.category = statToStr(category);
+  r.totalTy  = totalTy;
+  r.total    = statToStr(s.total());
+  for (const auto& v : s.values()) {
+    r.values.push_back(statToStr(v));
+  }
+  fillStatAggregates(r, s);
+  return r;
+}
+
+} // end namespace internal
+
 class StatManager {
 
 public:
   using Str = galois::gstl::Str;
 
-  static constexpr const char* const SEP           = ", ";
-  static constexpr const char* const TSTAT_SEP     = "; ";
-  static constexpr const char* const TSTAT_NAME    = "ThreadValues";
-  static constexpr const char* const TSTAT_ENV_VAR = "PRINT_PER_THREAD_STATS";
+  static constexpr const char* const SEP            = ", ";
+  static constexpr const char* const TSTAT_SEP      = "; ";
+  static constexpr const char* const TSTAT_NAME     = "ThreadValues";
+  static constexpr const char* const TSTAT_ENV_VAR  = "PRINT_PER_THREAD_STATS";
+  static constexpr const char* const FORMAT_ENV_VAR = "GALOIS_STAT_FORMAT";
 
   static bool printingThreadVals(void);
 
@@ -440,6 +538,15 @@ private:
         }
       }
     }
+
+    void write(StatWriter& w) const {
+      for (auto i = cbegin(), end_i = cend(); i != end_i; ++i) {
+        const auto& s = this->stat(i);
+        w.write(internal::makeStatRecord(statKind<T>(), this->region(i),
+                                         this->category(i),
+                                         StatTotal::str(s.totalTy()), s));
+      }
+    }
   };
 
   using IntStats     = StatManagerImpl<int64_t>;
@@ -491,6 +598,18 @@ protected:
     strStats.readStat(i, region, category, total, type, vec);
   }
 
+  //! Looks up a merged parameter; returns an empty string if it was not set
+  Str findParam(const Str& region, const Str& category) const;
+
+  /**
+   * Output layout: GALOIS_STAT_FORMAT (text, csv or json) if set, otherwise
+   * picked from the extension of the stat file (.csv, .json or .jsonl).
+   */
+  StatFormat statFormat(void) const;
+
+  //! Run info for structured output; stats must be merged first
+  virtual StatRunInfo runInfo(void) const;
+
   virtual void printStats(std::ostream& out);
 
   void printHeader(std::ostream& out) const;
@@ -625,9 +744,11 @@ void setStatFile(const std::string& f);
 void reportRUsage(const std::string& id);
 
 // TODO: switch to gstl::Str in here
-//! Reports Galois system memory stats for all threads
+//! Reports Galois system memory stats for all threads along with the bytes
+//! of hugetlbfs, THP and small pages obtained from the OS
 void reportPageAlloc(const char* category);
-//! Reports NUMA memory stats for all NUMA nodes
+//! Reports hugetlbfs, THP and small page bytes backing large (NUMA placed)
+//! allocations
 void reportNumaAlloc(const char* category);
 
 } // end namespace runtime
@@ -0,0 +1,172 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file TaskScheduler.h
+ *
+ * Work-stealing scheduler behind galois::TaskGroup.
+ */
+
+#ifndef GALOIS_RUNTIME_TASKSCHEDULER_H
+#define GALOIS_RUNTIME_TASKSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/SimpleLock.h"
+
+namespace galois::runtime {
+
+class TaskScheduler;
+
+/**
+ * A unit of work with dependencies. A task becomes ready once every task it
+ * depends on has finished; when it finishes, it readies its successors.
+ */
+class Task {
+  friend class TaskScheduler;
+
+  substrate::SimpleLock lock;
+  std::vector<std::shared_ptr<Task>> successors;
+  //! unfinished predecessors, plus one until the task is submitted
+  std::atomic<unsigned> pending{1};
+  std::atomic<bool> done{false};
+  //! unfinished tasks of the group this task belongs to
+  std::atomic<size_t>* outstanding = nullptr;
+
+protected:
+  virtual void execute() = 0;
+
+public:
+  virtual ~Task() = default;
+
+  bool isDone() const { return done.load(std::memory_order_acquire); }
+};
+
+/**
+ * Runs tasks on the threads of a single thread pool run. Each thread keeps a
+ * deque of ready tasks: it pushes and pops at the back and steals from the
+ * front of the other threads' deques, starting with its neighbors (nearby
+ * thread ids share a socket).
+ *
+ * Inside a task, galois::do_all splits its range into tasks of this
+ * scheduler and the calling thread helps run them until they finish, so
+ * nested loops use the threads already running instead of starting new ones.
+ */
+class TaskScheduler {
+  struct Deque {
+    substrate::SimpleLock lock;
+    std::deque<std::shared_ptr<Task>> tasks;
+  };
+
+  substrate::PerThreadStorage<Deque> deques;
+  unsigned numThreads;
+  //! next deque for tasks submitted outside the pool run
+  unsigned nextDeque = 0;
+
+  void push(std::shared_ptr<Task> t);
+  std::shared_ptr<Task> pop();
+  std::shared_ptr<Task> steal();
+  void runTask(std::shared_ptr<Task> t);
+
+public:
+  explicit TaskScheduler(unsigned numThreads);
+
+  //! scheduler running the calling thread's task, or nullptr
+  static TaskScheduler* current();
+
+  /**
+   * Submits task t, counted in outstanding, to run after deps finish.
+   */
+  void submit(std::shared_ptr<Task> t, std::atomic<size_t>& outstanding,
+              const std::vector<std::shared_ptr<Task>>& deps);
+
+  /**
+   * Runs tasks, own or stolen, until outstanding reaches zero.
+   */
+  void helpUntil(const std::atomic<size_t>& outstanding);
+
+  /**
+   * Runs tasks on numThreads threads of the thread pool until outstanding
+   * reaches zero. Must be called outside of a parallel region.
+   */
+  void run(const std::atomic<size_t>& outstanding);
+
+  /**
+   * Applies fn to each element in [b, e) as tasks of this scheduler. The
+   * calling thread runs the first block and helps with the rest.
+   */
+  template <typename Iter, typename FunctionTy>
+  void parallelFor(Iter b, Iter e, FunctionTy& fn);
+};
+
+template <typename Iter, typename FunctionTy>
+void TaskScheduler::parallelFor(Iter b, Iter e, FunctionTy& fn) {
+  // a few blocks per thread so that blocks of uneven cost balance out
+  constexpr size_t BLOCKS_PER_THREAD = 4;
+
+  struct Block : public Task {
+    Iter bb, ee;
+    FunctionTy& fn;
+
+    Block(Iter bb, Iter ee, FunctionTy& fn) : bb(bb), ee(ee), fn(fn) {}
+
+    void execute() override {
+      for (; bb != ee; ++bb)
+        fn(*bb);
+    }
+  };
+
+  size_t size = std::distance(b, e);
+  size_t numBlocks =
+      std::min<size_t>(size, size_t{numThreads} * BLOCKS_PER_THREAD);
+  if (numBlocks <= 1) {
+    for (; b != e; ++b)
+      fn(*b);
+    return;
+  }
+
+  auto blockEnd = [&](Iter bb, size_t i) {
+    std::advance(bb, size / numBlocks + (i < size % numBlocks));
+    return bb;
+  };
+
+  std::atomic<size_t> outstanding{0};
+  Iter first_end = blockEnd(b, 0);
+  Iter bb        = first_end;
+  for (size_t i = 1; i < numBlocks; ++i) {
+    Iter ee = blockEnd(bb, i);
+    submit(std::make_shared<Block>(bb, ee, fn), outstanding, {});
+    bb = ee;
+  }
+
+  for (; b != first_end; ++b)
+    fn(*b);
+  helpUntil(outstanding);
+}
+
+} // namespace galois::runtime
+
+#endif
@@ -26,6 +26,7 @@
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/substrate/ThreadPool.h"
+#include "galois/substrate/Trace.h"
 
 namespace galois {
 namespace substrate {
@@ -41,7 +42,10 @@ public:
   virtual void wait() = 0;
 
   // wait at this barrier
-  void operator()(void) { wait(); }
+  void operator()(void) {
+    TraceSpan span(TraceCategory::BARRIER, name());
+    wait();
+  }
 
   // barrier type.
   virtual const char* name() const = 0;
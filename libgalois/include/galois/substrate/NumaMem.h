@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "galois/config.h"
+#include "galois/substrate/PageAlloc.h"
 
 namespace galois {
 namespace substrate {
@@ -38,17 +39,27 @@ struct largeFreer {
 
 typedef std::unique_ptr<void, internal::largeFreer> LAptr;
 
-LAptr largeMallocLocal(size_t bytes);    // fault in locally
-LAptr largeMallocFloating(size_t bytes); // leave numa mapping undefined
+// policy selects the pages backing the allocation (see PagePolicy); NUMA
+// placement is the same for every policy
+LAptr largeMallocLocal(size_t bytes, PagePolicy policy = PagePolicy::DEFAULT);
+// leave numa mapping undefined
+LAptr largeMallocFloating(size_t bytes,
+                          PagePolicy policy = PagePolicy::DEFAULT);
 // fault in interleaved mapping
-LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads);
+LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads,
+                             PagePolicy policy = PagePolicy::DEFAULT);
 // fault in block interleaved mapping
-LAptr largeMallocBlocked(size_t bytes, unsigned numThreads);
+LAptr largeMallocBlocked(size_t bytes, unsigned numThreads,
+                         PagePolicy policy = PagePolicy::DEFAULT);
 
 // fault in specified regions for each thread (threadRanges)
 template <typename RangeArrayTy>
 LAptr largeMallocSpecified(size_t bytes, uint32_t numThreads,
-                           RangeArrayTy& threadRanges, size_t elementSize);
+                           RangeArrayTy& threadRanges, size_t elementSize,
+                           PagePolicy policy = PagePolicy::DEFAULT);
+
+//! Returns the total bytes of the given page kind obtained by largeMalloc*
+size_t numLargeAllocBytes(PageKind kind);
 
 } // namespace substrate
 } // namespace galois
@@ -62,15 +62,43 @@ static_assert(0, "No Anonymous mapping");
 namespace galois {
 namespace substrate {
 
+//! Which pages back an allocation; each huge page policy falls back to the
+//! next cheaper one (1GB -> 2MB -> THP -> small) when the OS refuses it
+enum class PagePolicy {
+  DEFAULT,    //!< use the global policy (see setPagePolicy)
+  HUGETLB_1G, //!< 1GB hugetlbfs pages for allocations of at least 1GB
+  HUGETLB_2M, //!< 2MB hugetlbfs pages
+  THP,        //!< small pages with madvise(MADV_HUGEPAGE)
+  SMALL       //!< small pages only
+};
+
+//! Kind of pages actually obtained from the OS
+enum class PageKind { HUGETLB, THP, SMALL };
+
+//! Set the policy used by allocations that ask for PagePolicy::DEFAULT.
+//! The initial value comes from the GALOIS_PAGE_POLICY environment variable
+//! (1G, 2M, THP or SMALL) and is 2M if unset; passing DEFAULT restores it.
+void setPagePolicy(PagePolicy policy);
+
+//! Returns the global page policy
+PagePolicy getPagePolicy();
+
 // size of pages
 size_t allocSize();
 
-// allocate contiguous pages, optionally faulting them in
-void* allocPages(unsigned num, bool preFault);
+// allocate contiguous pages, optionally faulting them in; if kind is
+// non-null, the kind of pages obtained is stored there
+void* allocPages(unsigned num, bool preFault,
+                 PagePolicy policy = PagePolicy::DEFAULT,
+                 PageKind* kind    = nullptr);
 
 // free page range
 void freePages(void* ptr, unsigned num);
 
+//! Returns the total bytes requested from allocPages that were backed by the
+//! given kind of pages
+size_t numPageAllocBytes(PageKind kind);
+
 } // namespace substrate
 } // namespace galois
 
@@ -64,37 +64,38 @@ protected:
 
   //! Per-thread mailboxes for notification
   struct per_signal {
+    //! value of release while the owner sleeps in the kernel
+    static constexpr int PARKED = 2;
+
     std::condition_variable cv;
     std::mutex m;
     unsigned wbegin, wend;
     std::atomic<int> done;
-    std::atomic<int> fastRelease;
+    std::atomic<int> release;
     ThreadTopoInfo topo;
 
-    void wakeup(bool fastmode) {
-      if (fastmode) {
-        done        = 0;
-        fastRelease = 1;
-      } else {
-        std::lock_guard<std::mutex> lg(m);
-        done = 0;
-        cv.notify_one();
-        // start.release();
+    void wakeup() {
+      done = 0;
+      if (release.exchange(1) == PARKED) {
+        unpark();
       }
     }
 
-    void wait(bool fastmode) {
-      if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
-          asmPause();
+    //! In fastmode spin until woken; otherwise spin for up to spin pauses and
+    //! then sleep until woken
+    void wait(bool fastmode, unsigned spin) {
+      while (fastmode || spin--) {
+        if (release.load(std::memory_order_acquire)) {
+          release.store(0, std::memory_order_relaxed);
+          return;
         }
-        fastRelease = 0;
-      } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
+        asmPause();
       }
+      park();
     }
+
+    void park();
+    void unpark();
   };
 
   thread_local static per_signal my_box;
@@ -102,8 +103,12 @@ protected:
   MachineTopoInfo mi;
   std::vector<per_signal*> signals;
   std::vector<std::thread> threads;
+  //! ascending tids that start a new socket; read when splitting wakeups
+  std::vector<unsigned> socketStarts;
   unsigned reserved;
   unsigned masterFastmode;
+  //! pauses an idle thread spins before parking
+  unsigned spinPauses;
   bool running;
   std::function<void(void)> work;
 
@@ -116,8 +121,11 @@ protected:
   //! main thread loop
   void threadLoop(unsigned tid);
 
+  //! split point of a wakeup range, kept on socket boundaries when possible
+  unsigned cascadeSplit(unsigned wbegin, unsigned wend) const;
+
   //! spin up for run
-  void cascade(bool fastmode);
+  void cascade();
 
   //! spin down after run
   void decascade();
@@ -209,6 +217,10 @@ public:
     return my_box.topo.cumulativeMaxSocket;
   }
   static unsigned getNumaNode() { return my_box.topo.numaNode; }
+
+  //! True if the calling thread is the master thread or a thread of this
+  //! pool; other threads also report tid 0
+  bool isPoolThread() const { return signals[getTID()] == &my_box; }
 };
 
 /**
@@ -0,0 +1,147 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file Trace.h
+ *
+ * Timeline of runtime events that can be viewed in chrome://tracing or
+ * Perfetto. Each thread records events into its own fixed-size ring buffer
+ * without synchronization; when the ring is full, the oldest events are
+ * overwritten. The rings are written as Chrome trace JSON to the file named by
+ * the GALOIS_TRACE_FILE environment variable when the runtime shuts down.
+ * Event names are copied when an event is recorded, so callers may pass
+ * temporary strings; names longer than 31 characters are truncated.
+ *
+ * Recording is compiled in only when Galois is configured with
+ * GALOIS_ENABLE_TRACE=ON. Otherwise, every function here is an empty inline
+ * function and TraceSpan is an empty class.
+ */
+#ifndef GALOIS_SUBSTRATE_TRACE_H
+#define GALOIS_SUBSTRATE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+namespace substrate {
+
+enum class TraceCategory : uint8_t {
+  LOOP,
+  CHUNK,
+  STEAL,
+  BARRIER,
+  TERMINATION,
+  NETWORK,
+};
+
+#ifdef GALOIS_ENABLE_TRACE
+
+namespace internal {
+//! True when GALOIS_TRACE_FILE is set, until the trace is dumped
+extern std::atomic<bool> traceActive;
+
+inline bool traceEnabled() {
+  return traceActive.load(std::memory_order_relaxed);
+}
+
+uint64_t traceNow();
+
+void traceRecord(TraceCategory cat, const char* name, uint64_t start,
+                 uint64_t end, uint64_t arg, bool instant);
+} // namespace internal
+
+//! Records an event without duration, e.g., a failed steal
+inline void traceInstant(TraceCategory cat, const char* name,
+                         uint64_t arg = 0) {
+  if (internal::traceEnabled()) {
+    uint64_t now = internal::traceNow();
+    internal::traceRecord(cat, name, now, now, arg, true);
+  }
+}
+
+//! Names the calling thread in the timeline
+void traceThreadName(const char* name);
+
+//! Sets the process id used in the timeline and appends it to the output file
+//! name, so that each host of a distributed run writes its own file
+void traceProcess(unsigned id);
+
+//! Stops recording and writes the timeline to GALOIS_TRACE_FILE; called when
+//! the runtime shuts down. Threads that are still running, e.g., the network
+//! progress threads, may call the recording functions concurrently; their
+//! events are discarded.
+void traceDump();
+
+/**
+ * Records the time between its construction and destruction as one event.
+ */
+class TraceSpan {
+  const char* name;
+  uint64_t start;
+  uint64_t arg;
+  TraceCategory cat;
+
+public:
+  TraceSpan(TraceCategory c, const char* n, uint64_t a = 0)
+      : name(n), start(internal::traceEnabled() ? internal::traceNow() : 0),
+        arg(a), cat(c) {}
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  ~TraceSpan() {
+    if (internal::traceEnabled())
+      internal::traceRecord(cat, name, start, internal::traceNow(), arg, false);
+  }
+
+  void setArg(uint64_t a) { arg = a; }
+
+  //! Moves the start of the span to now
+  void restart() {
+    if (internal::traceEnabled())
+      start = internal::traceNow();
+  }
+};
+
+#else
+
+inline void traceInstant(TraceCategory, const char*, uint64_t = 0) {}
+inline void traceThreadName(const char*) {}
+inline void traceProcess(unsigned) {}
+inline void traceDump() {}
+
+class TraceSpan {
+public:
+  TraceSpan(TraceCategory, const char*, uint64_t = 0) {}
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  void setArg(uint64_t) {}
+  void restart() {}
+};
+
+#endif
+
+} // end namespace substrate
+} // end namespace galois
+
+#endif
@@ -20,10 +20,14 @@
 #ifndef GALOIS_WORKLIST_CHUNK_H
 #define GALOIS_WORKLIST_CHUNK_H
 
+#include <type_traits>
+
 #include "galois/config.h"
 #include "galois/FixedSizeRing.h"
+#include "galois/runtime/AdaptiveChunk.h"
 #include "galois/runtime/Mem.h"
 #include "galois/substrate/PaddedLock.h"
+#include "galois/substrate/Trace.h"
 #include "galois/worklists/WLCompileCheck.h"
 #include "galois/worklists/WorkListHelpers.h"
 
@@ -55,20 +59,28 @@ struct squeue<false, PS, TQ> {
 };
 
 //! Common functionality to all chunked worklists
+//!
+//! With Adaptive, each thread fills chunks up to a size between 1 and
+//! ChunkSize that follows the time it takes to process a chunk and how often
+//! it takes chunks from other threads (see runtime::AdaptiveChunk).
 template <typename T, template <typename, bool> class QT, bool Distributed,
-          bool IsStack, int ChunkSize, bool Concurrent>
+          bool IsStack, int ChunkSize, bool Concurrent, bool Adaptive = false>
 struct ChunkMaster {
   template <typename _T>
-  using retype =
-      ChunkMaster<_T, QT, Distributed, IsStack, ChunkSize, Concurrent>;
+  using retype = ChunkMaster<_T, QT, Distributed, IsStack, ChunkSize,
+                             Concurrent, Adaptive>;
 
   template <int _chunk_size>
-  using with_chunk_size =
-      ChunkMaster<T, QT, Distributed, IsStack, _chunk_size, Concurrent>;
+  using with_chunk_size = ChunkMaster<T, QT, Distributed, IsStack, _chunk_size,
+                                      Concurrent, Adaptive>;
 
   template <bool _Concurrent>
-  using rethread =
-      ChunkMaster<T, QT, Distributed, IsStack, ChunkSize, _Concurrent>;
+  using rethread = ChunkMaster<T, QT, Distributed, IsStack, ChunkSize,
+                               _Concurrent, Adaptive>;
+
+  template <bool _adaptive>
+  using with_adaptive_chunk = ChunkMaster<T, QT, Distributed, IsStack,
+                                          ChunkSize, Concurrent, _adaptive>;
 
 private:
   class Chunk : public FixedSizeRing<T, ChunkSize>,
@@ -76,10 +88,17 @@ private:
 
   runtime::FixedSizeAllocator<Chunk> alloc;
 
+  typedef std::conditional_t<Adaptive, runtime::AdaptiveChunk,
+                             runtime::FixedChunk>
+      ChunkCtl;
+
   struct p {
     Chunk* cur;
     Chunk* next;
-    p() : cur(0), next(0) {}
+    ChunkCtl chunk;
+    runtime::ChunkSizeSamples samples;
+    unsigned taken;
+    p() : cur(0), next(0), chunk(ChunkSize, 1, ChunkSize), taken(0) {}
   };
 
   typedef QT<Chunk, Concurrent> LevelItem;
@@ -108,7 +127,7 @@ private:
     return I.pop();
   }
 
-  Chunk* popChunk() {
+  Chunk* popChunkAny(p& n) {
     int id   = Q.myEffectiveID();
     Chunk* r = popChunkByID(id);
     if (r)
@@ -116,23 +135,43 @@ private:
 
     for (int i = id + 1; i < (int)Q.size(); ++i) {
       r = popChunkByID(i);
-      if (r)
+      if (r) {
+        n.chunk.stole();
+        substrate::traceInstant(substrate::TraceCategory::STEAL, "chunk", i);
         return r;
+      }
     }
 
     for (int i = 0; i < id; ++i) {
       r = popChunkByID(i);
-      if (r)
+      if (r) {
+        n.chunk.stole();
+        substrate::traceInstant(substrate::TraceCategory::STEAL, "chunk", i);
         return r;
+      }
     }
 
     return 0;
   }
 
+  Chunk* popChunk(p& n) {
+    if (Adaptive && n.taken)
+      n.chunk.end(n.taken >= n.chunk.get());
+    Chunk* r = popChunkAny(n);
+    if (Adaptive) {
+      n.taken = r ? r->size() : 0;
+      if (r)
+        n.samples.add(n.chunk.get());
+      n.chunk.begin();
+    }
+    return r;
+  }
+
   template <typename... Args>
   T* emplacei(p& n, Args&&... args) {
     T* retval = 0;
-    if (n.next && (retval = n.next->emplace_back(std::forward<Args>(args)...)))
+    if (n.next && (!Adaptive || n.next->size() < n.chunk.get()) &&
+        (retval = n.next->emplace_back(std::forward<Args>(args)...)))
       return retval;
     if (n.next)
       pushChunk(n.next);
@@ -181,7 +220,7 @@ public:
         return &n.next->back();
       if (n.next)
         delChunk(n.next);
-      n.next = popChunk();
+      n.next = popChunk(n);
       if (n.next && !n.next->empty())
         return &n.next->back();
       return NULL;
@@ -190,7 +229,7 @@ public:
         return &n.cur->front();
       if (n.cur)
         delChunk(n.cur);
-      n.cur = popChunk();
+      n.cur = popChunk(n);
       if (!n.cur) {
         n.cur  = n.next;
         n.next = 0;
@@ -235,6 +274,17 @@ public:
     push(rp.first, rp.second);
   }
 
+  //! Number of items the calling thread currently puts in a chunk
+  unsigned chunkSize() {
+    p& n = data.get();
+    return n.chunk.get();
+  }
+
+  //! Sizes the calling thread used, sampled each time it took a chunk
+  const runtime::ChunkSizeSamples& chunkSizeSamples() {
+    return data.get().samples;
+  }
+
   galois::optional<value_type> pop() {
     p& n = data.get();
     galois::optional<value_type> retval;
@@ -243,7 +293,7 @@ public:
         return retval;
       if (n.next)
         delChunk(n.next);
-      n.next = popChunk();
+      n.next = popChunk(n);
       if (n.next)
         return n.next->extract_back();
       return galois::optional<value_type>();
@@ -252,7 +302,7 @@ public:
         return retval;
       if (n.cur)
         delChunk(n.cur);
-      n.cur = popChunk();
+      n.cur = popChunk(n);
       if (!n.cur) {
         n.cur  = n.next;
         n.next = 0;
@@ -0,0 +1,312 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_WORKLIST_MULTIQUEUE_H
+#define GALOIS_WORKLIST_MULTIQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/runtime/Substrate.h"
+#include "galois/substrate/PaddedLock.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/worklists/WLCompileCheck.h"
+#include "galois/worklists/WorkListHelpers.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Relaxed priority scheduling with a MultiQueue. The worklist keeps C
+ * sequential binary heaps per active thread, each protected by its own lock.
+ * A push inserts into one heap, and a pop looks at the tops of two randomly
+ * chosen heaps and removes from the one with the higher priority.
+ *
+ * Unlike {@link OrderedByIntegerMetric}, there are no buckets whose width has
+ * to be tuned per input: priorities are compared exactly, and the rank error
+ * of a pop only depends on the number of heaps, stickiness and batch size.
+ *
+ * To reduce contention, a thread keeps using the heaps it picked for
+ * StickyPeriod operations, buffers up to BatchSize pushes before inserting
+ * them into a heap and removes up to BatchSize items per pop from a heap.
+ * Buffered pushes of a thread are flushed before it looks for new work, so a
+ * pop only fails when all heaps are empty.
+ *
+ * Indexer has the same requirements as in {@link OrderedByIntegerMetric},
+ * and lower indices are higher priority. The index type must be usable with
+ * std::atomic.
+ *
+ * An example:
+ * \code
+ * typedef galois::worklists::MultiQueue<Indexer> WL;
+ * galois::for_each(galois::iterate(items), Fn, galois::wl<WL>(Indexer{}));
+ * \endcode
+ *
+ * @tparam Indexer      Indexer class
+ * @tparam C            Number of heaps per thread
+ * @tparam StickyPeriod Number of operations a thread uses a heap before it
+ *                      picks a new random one
+ * @tparam BatchSize    Maximum number of items moved between a thread and a
+ *                      heap at once
+ */
+template <class Indexer = DummyIndexer<int>, unsigned C = 4,
+          unsigned StickyPeriod = 8, unsigned BatchSize = 8, typename T = int,
+          typename Index = unsigned, bool Concurrent = true>
+class MultiQueue : private boost::noncopyable {
+  static_assert(C > 0 && StickyPeriod > 0 && BatchSize > 0,
+                "MultiQueue parameters must be positive");
+
+public:
+  template <typename _T>
+  using retype =
+      MultiQueue<Indexer, C, StickyPeriod, BatchSize, _T,
+                 typename std::result_of<Indexer(_T)>::type, Concurrent>;
+
+  template <bool _b>
+  using rethread =
+      MultiQueue<Indexer, C, StickyPeriod, BatchSize, T, Index, _b>;
+
+  template <unsigned _c>
+  struct with_queues_per_thread {
+    typedef MultiQueue<Indexer, _c, StickyPeriod, BatchSize, T, Index,
+                       Concurrent>
+        type;
+  };
+
+  template <unsigned _period>
+  struct with_sticky_period {
+    typedef MultiQueue<Indexer, C, _period, BatchSize, T, Index, Concurrent>
+        type;
+  };
+
+  template <unsigned _size>
+  struct with_batch_size {
+    typedef MultiQueue<Indexer, C, StickyPeriod, _size, T, Index, Concurrent>
+        type;
+  };
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef MultiQueue<_indexer, C, StickyPeriod, BatchSize, T, Index,
+                       Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+private:
+  typedef std::pair<Index, T> Item;
+
+  struct Greater {
+    bool operator()(const Item& a, const Item& b) const {
+      return b.first < a.first;
+    }
+  };
+
+  struct Heap {
+    substrate::PaddedLock<Concurrent> lock;
+    //! Index of the top item; only a hint when read without the lock
+    std::atomic<Index> top;
+    std::atomic<size_t> size;
+    std::vector<Item> items;
+
+    Heap() : size(0) {}
+  };
+
+  struct ThreadData {
+    uint64_t seed;
+    unsigned pushHeap;
+    unsigned pushLeft;
+    unsigned popHeap;
+    unsigned popLeft;
+    std::vector<Item> pushed;
+    std::deque<T> popped;
+
+    ThreadData()
+        : seed(0x9E3779B97F4A7C15ULL * (substrate::ThreadPool::getTID() + 1)),
+          pushHeap(0), pushLeft(0), popHeap(0), popLeft(0) {}
+
+    unsigned random(unsigned n) {
+      // xorshift64*
+      seed ^= seed >> 12;
+      seed ^= seed << 25;
+      seed ^= seed >> 27;
+      return ((seed * 0x2545F4914F6CDD1DULL) >> 32) % n;
+    }
+  };
+
+  substrate::PerThreadStorage<ThreadData> data;
+  unsigned numHeaps;
+  std::unique_ptr<Heap[]> heaps;
+  Indexer indexer;
+
+  //! Moves the top items of a locked heap into the pop buffer
+  void take(Heap& h, ThreadData& p) {
+    for (unsigned i = 0; i < BatchSize && !h.items.empty(); ++i) {
+      std::pop_heap(h.items.begin(), h.items.end(), Greater());
+      p.popped.push_back(std::move(h.items.back().second));
+      h.items.pop_back();
+    }
+    update(h);
+  }
+
+  void update(Heap& h) {
+    h.size.store(h.items.size(), std::memory_order_relaxed);
+    if (!h.items.empty())
+      h.top.store(h.items.front().first, std::memory_order_relaxed);
+  }
+
+  void flush(ThreadData& p) {
+    if (p.pushed.empty())
+      return;
+
+    while (true) {
+      if (p.pushLeft == 0) {
+        p.pushHeap = p.random(numHeaps);
+        p.pushLeft = StickyPeriod;
+      }
+      Heap& h = heaps[p.pushHeap];
+      if (!h.lock.try_lock()) {
+        p.pushLeft = 0;
+        continue;
+      }
+      --p.pushLeft;
+      for (auto& item : p.pushed) {
+        h.items.push_back(std::move(item));
+        std::push_heap(h.items.begin(), h.items.end(), Greater());
+      }
+      update(h);
+      h.lock.unlock();
+      break;
+    }
+    p.pushed.clear();
+  }
+
+  //! Two-choice pop with sticky heaps
+  bool fastPop(ThreadData& p) {
+    for (unsigned attempt = 0; attempt < 2 * C; ++attempt) {
+      if (p.popLeft == 0 ||
+          heaps[p.popHeap].size.load(std::memory_order_relaxed) == 0) {
+        unsigned i = p.random(numHeaps);
+        unsigned j = p.random(numHeaps);
+        if (better(heaps[j], heaps[i]))
+          i = j;
+        if (heaps[i].size.load(std::memory_order_relaxed) == 0)
+          continue;
+        p.popHeap = i;
+        p.popLeft = StickyPeriod;
+      }
+      Heap& h = heaps[p.popHeap];
+      if (!h.lock.try_lock()) {
+        p.popLeft = 0;
+        continue;
+      }
+      --p.popLeft;
+      take(h, p);
+      h.lock.unlock();
+      if (!p.popped.empty())
+        return true;
+    }
+    return false;
+  }
+
+  //! Checks every heap so that a failed pop means there is no work left
+  bool slowPop(ThreadData& p) {
+    unsigned start = p.random(numHeaps);
+    for (unsigned k = 0; k < numHeaps; ++k) {
+      unsigned i = (start + k) % numHeaps;
+      Heap& h    = heaps[i];
+      if (h.size.load(std::memory_order_relaxed) == 0)
+        continue;
+      h.lock.lock();
+      take(h, p);
+      h.lock.unlock();
+      if (!p.popped.empty()) {
+        p.popHeap = i;
+        p.popLeft = StickyPeriod;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool better(const Heap& a, const Heap& b) {
+    if (a.size.load(std::memory_order_relaxed) == 0)
+      return false;
+    if (b.size.load(std::memory_order_relaxed) == 0)
+      return true;
+    return a.top.load(std::memory_order_relaxed) <
+           b.top.load(std::memory_order_relaxed);
+  }
+
+public:
+  MultiQueue(const Indexer& x = Indexer())
+      : numHeaps(C * std::max(runtime::activeThreads, 1U)),
+        heaps(new Heap[numHeaps]), indexer(x) {}
+
+  void push(const value_type& val) {
+    ThreadData& p = *data.getLocal();
+    p.pushed.emplace_back(indexer(val), val);
+    if (p.pushed.size() >= BatchSize)
+      flush(p);
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    auto rp = range.local_pair();
+    push(rp.first, rp.second);
+    flush(*data.getLocal());
+  }
+
+  galois::optional<value_type> pop() {
+    ThreadData& p = *data.getLocal();
+
+    if (p.popped.empty()) {
+      flush(p);
+      if (!fastPop(p) && !slowPop(p))
+        return galois::optional<value_type>();
+    }
+
+    galois::optional<value_type> item(std::move(p.popped.front()));
+    p.popped.pop_front();
+    return item;
+  }
+};
+GALOIS_WLCOMPILECHECK(MultiQueue)
+
+} // namespace worklists
+} // namespace galois
+
+#endif
@@ -28,6 +28,7 @@
 #include "galois/worklists/Chunk.h"
 #include "galois/worklists/Simple.h"
 #include "galois/worklists/LocalQueue.h"
+#include "galois/worklists/MultiQueue.h"
 #include "galois/worklists/Obim.h"
 #include "galois/worklists/OrderedList.h"
 #include "galois/worklists/OwnerComputes.h"
@@ -38,7 +39,8 @@ namespace galois {
  * Scheduling policies for Galois iterators. Unless you have very specific
  * scheduling requirement, {@link PerSocketChunkLIFO} or {@link
  * PerSocketChunkFIFO} is a reasonable scheduling policy. If you need
- * approximate priority scheduling, use {@link OrderedByIntegerMetric}. For
+ * approximate priority scheduling, use {@link OrderedByIntegerMetric} or
+ * {@link MultiQueue}, which does not need a bucket width. For
  * debugging, you may be interested in {@link FIFO} or {@link LIFO}, which try
  * to follow serial order exactly.
  *
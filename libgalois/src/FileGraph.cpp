@@ -29,6 +29,7 @@
 #include "galois/substrate/PageAlloc.h"
 
 #include <cassert>
+#include <cerrno>
 #include <fstream>
 
 #include <sys/stat.h>
@@ -270,7 +271,7 @@ void* FileGraph::fromArrays(uint64_t* out_idx, uint64_t num_nodes, void* outs,
   return edgeData;
 }
 
-void FileGraph::fromFile(const std::string& filename) {
+void FileGraph::fromFile(const std::string& filename, bool populate) {
   int fd = open(filename.c_str(), O_RDONLY);
   if (fd == -1)
     GALOIS_SYS_DIE("failed opening ", "'", filename, "'");
@@ -283,7 +284,8 @@ void FileGraph::fromFile(const std::string& filename) {
   // mmap file, then load from mem using fromMem function
   int _MAP_BASE = MAP_PRIVATE;
 #ifdef MAP_POPULATE
-  _MAP_BASE |= MAP_POPULATE;
+  if (populate)
+    _MAP_BASE |= MAP_POPULATE;
 #endif
   void* base = mmap(nullptr, buf.st_size, PROT_READ, _MAP_BASE, fd, 0);
   if (base == MAP_FAILED)
@@ -480,28 +482,38 @@ auto FileGraph::divideByEdge(size_t, size_t, size_t id, size_t total)
 }
 
 void FileGraph::toFile(const std::string& file) {
+  if (!tryToFile(file))
+    GALOIS_SYS_DIE("failed writing to ", "'", file, "'");
+}
+
+bool FileGraph::tryToFile(const std::string& file) {
   // FIXME handle files with multiple mappings
   GALOIS_ASSERT(mappings.size() == 1);
 
   ssize_t retval;
   mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
   int fd      = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, mode);
-  mapping mm  = mappings.back();
-  mappings.pop_back();
+  if (fd == -1)
+    return false;
+  // the graph stays usable (and keeps owning its memory) after writing
+  mapping mm = mappings.back();
 
   size_t total = mm.len;
   char* ptr    = (char*)mm.ptr;
   while (total) {
     retval = write(fd, ptr, total);
-    if (retval == -1) {
-      GALOIS_SYS_DIE("failed writing to ", "'", file, "'");
-    } else if (retval == 0) {
-      GALOIS_DIE("ran out of space writing to ", "'", file, "'");
+    if (retval <= 0) {
+      if (retval == 0)
+        errno = ENOSPC;
+      int err = errno;
+      close(fd);
+      errno = err;
+      return false;
     }
     total -= retval;
     ptr += retval;
   }
-  close(fd);
+  return close(fd) == 0;
 }
 
 uint64_t FileGraph::getEdgeIdx(GraphNode src, GraphNode dst) {
@@ -529,18 +541,9 @@ uint64_t FileGraph::getEdgeIdx(GraphNode src, GraphNode dst) {
   }
 }
 
-/**
- * Touch pages of a buffer to page them in.
- *
- * @param buf Buffer to touch
- * @param len Length to touch
- * @param stride How much to stride when touching pages
- */
-static void pageInReadOnly(void* buf, size_t len, size_t stride) {
-  volatile char* ptr = reinterpret_cast<volatile char*>(buf);
-  for (size_t i = 0; i < len; i += stride)
-    ptr[i];
-}
+//! File mappings are backed by small pages; touching every huge page worth
+//! of data would leave most of the file unread
+static const size_t pageInStride = sysconf(_SC_PAGESIZE);
 
 void FileGraph::pageInByNode(size_t id, size_t total, size_t sizeofEdgeData) {
   size_t edgeSize = 0;
@@ -568,22 +571,25 @@ void FileGraph::pageInByNode(size_t id, size_t total, size_t sizeofEdgeData) {
     eend = *edge_end(*r.second - 1 + nodeOffset);
 
   // page in the outIdx array
-  pageInReadOnly(outIdx + *r.first,
-                 std::distance(r.first, r.second) * sizeof(*outIdx),
-                 runtime::pagePoolSize());
+  runtime::pageInReadOnly(outIdx + *r.first,
+                          std::distance(r.first, r.second) * sizeof(*outIdx),
+                          pageInStride);
 
   // page in outs array
   if (graphVersion == 1) {
-    pageInReadOnly((uint32_t*)outs + ebegin, (eend - ebegin) * sizeof(uint32_t),
-                   runtime::pagePoolSize());
+    runtime::pageInReadOnly((uint32_t*)outs + ebegin,
+                            (eend - ebegin) * sizeof(uint32_t),
+                            pageInStride);
   } else {
-    pageInReadOnly((uint64_t*)outs + ebegin, (eend - ebegin) * sizeof(uint64_t),
-                   runtime::pagePoolSize());
+    runtime::pageInReadOnly((uint64_t*)outs + ebegin,
+                            (eend - ebegin) * sizeof(uint64_t),
+                            pageInStride);
   }
 
   // page in edge data
-  pageInReadOnly(edgeData + ebegin * sizeofEdgeData,
-                 (eend - ebegin) * sizeofEdgeData, runtime::pagePoolSize());
+  runtime::pageInReadOnly(edgeData + ebegin * sizeofEdgeData,
+                          (eend - ebegin) * sizeofEdgeData,
+                          pageInStride);
 }
 
 void* FileGraph::raw_neighbor_begin(GraphNode N) {
@@ -18,37 +18,43 @@
  */
 
 #include "galois/graphs/FileGraph.h"
+#include "galois/runtime/Statistics.h"
 #include "galois/substrate/ThreadPool.h"
-#include "galois/substrate/HWTopo.h"
+#include "galois/Timer.h"
 
-#include <mutex>
-#include <condition_variable>
+#include <algorithm>
+
+#include <sys/mman.h>
 
 namespace galois {
 namespace graphs {
 
 void FileGraph::fromFileInterleaved(const std::string& filename,
                                     size_t sizeofEdgeData) {
-  fromFile(filename);
+  galois::Timer timer;
+  timer.start();
+
+  // MAP_POPULATE would fault the whole file in on this thread; map lazily
+  // and let every thread fault in the node range it is responsible for
+  fromFile(filename, false);
+  const mapping& m = mappings.back();
+#ifdef MADV_WILLNEED
+  // start readahead of the whole file while threads touch their pieces
+  madvise(m.ptr, m.len, MADV_WILLNEED);
+#endif
 
-  std::mutex lock;
-  std::condition_variable cond;
   auto& tp            = substrate::getThreadPool();
-  unsigned maxSockets = tp.getMaxSockets();
-  unsigned count      = maxSockets;
-
-  // Interleave across all NUMA nodes
-  tp.run(tp.getMaxThreads(), [&]() {
-    std::unique_lock<std::mutex> lk(lock);
-    if (substrate::ThreadPool::isLeader()) {
-      pageInByNode(substrate::ThreadPool::getSocket(), maxSockets,
-                   sizeofEdgeData);
-      if (--count == 0)
-        cond.notify_all();
-    } else {
-      cond.wait(lk, [&]() { return count == 0; });
-    }
+  unsigned numThreads = tp.getMaxThreads();
+  tp.run(numThreads, [&]() {
+    pageInByNode(substrate::ThreadPool::getTID(), numThreads, sizeofEdgeData);
   });
+
+  timer.stop();
+  uint64_t usec = std::max<uint64_t>(timer.get_usec(), 1);
+  galois::runtime::reportStat_Tsum("FileGraph", "PageInBytes", m.len);
+  galois::runtime::reportStat_Tsum("FileGraph", "PageInTimeMs", usec / 1000);
+  galois::runtime::reportStat_Single("FileGraph", "PageInMBPerSec",
+                                     m.len / usec);
 }
 
 } // namespace graphs
@@ -0,0 +1,184 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/graphs/GraphCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+//! Number of blocks of the input that are hashed to validate a cache
+constexpr size_t numHashBlocks = 64;
+constexpr size_t hashBlockSize = 4096;
+
+//! Bumped whenever the meaning of a transform or the key format changes
+constexpr int cacheFormatVersion = 1;
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * Hash of numHashBlocks blocks spread evenly over the file, which catches
+ * rewritten inputs without reading all of a multi-gigabyte graph.
+ */
+uint64_t sampledHash(int fd, uint64_t fileSize) {
+  uint64_t hash = 14695981039346656037ULL;
+  char buf[hashBlockSize];
+  for (size_t i = 0; i <= numHashBlocks; ++i) {
+    uint64_t offset = fileSize > hashBlockSize
+                          ? (fileSize - hashBlockSize) * i / numHashBlocks
+                          : 0;
+    ssize_t numRead = pread(fd, buf, hashBlockSize, offset);
+    if (numRead < 0)
+      GALOIS_SYS_DIE("failed reading graph for cache validation");
+    hash = fnv1a(hash, buf, numRead);
+  }
+  return hash;
+}
+
+std::string directoryOf(const std::string& path) {
+  size_t pos = path.find_last_of('/');
+  if (pos == std::string::npos)
+    return ".";
+  if (pos == 0)
+    return "/";
+  return path.substr(0, pos);
+}
+
+} // namespace
+
+const char* galois::graphs::graphTransformName(GraphTransform t) {
+  switch (t) {
+  case GraphTransform::SORT_BY_DST:
+    return "sortdst";
+  case GraphTransform::DEGREE_RELABEL:
+    return "relabel";
+  case GraphTransform::SYMMETRIZE:
+    return "sym";
+  case GraphTransform::TRANSPOSE:
+    return "tr";
+  case GraphTransform::REMOVE_SELF_LOOPS:
+    return "noself";
+  default:
+    GALOIS_DIE("unknown graph transform");
+  }
+}
+
+std::string galois::graphs::internal::graphCachePath(
+    const std::string& filename, const std::vector<GraphTransform>& pipeline) {
+  std::string path = filename + ".";
+  for (size_t i = 0; i < pipeline.size(); ++i) {
+    if (i)
+      path += "-";
+    path += graphTransformName(pipeline[i]);
+  }
+  return path + ".cache.gr";
+}
+
+std::string galois::graphs::internal::graphCacheKey(
+    const std::string& filename, const std::vector<GraphTransform>& pipeline,
+    size_t sizeofEdgeData) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    GALOIS_SYS_DIE("failed opening ", "'", filename, "'");
+  struct stat buf;
+  if (fstat(fd, &buf) == -1)
+    GALOIS_SYS_DIE("failed reading ", "'", filename, "'");
+
+  std::ostringstream key;
+  key << "version " << cacheFormatVersion << "\n";
+  key << "size " << buf.st_size << "\n";
+  key << "mtime " << buf.st_mtim.tv_sec << "." << buf.st_mtim.tv_nsec << "\n";
+  key << "hash " << sampledHash(fd, buf.st_size) << "\n";
+  key << "edgedata " << sizeofEdgeData << "\n";
+  key << "pipeline";
+  for (GraphTransform t : pipeline)
+    key << " " << graphTransformName(t);
+  key << "\n";
+  close(fd);
+
+  return key.str();
+}
+
+bool galois::graphs::internal::graphCacheValid(const std::string& path,
+                                               const std::string& key) {
+  std::ifstream keyFile(path + ".key");
+  if (!keyFile)
+    return false;
+  std::stringstream stored;
+  stored << keyFile.rdbuf();
+  // the graph is written before its key, so a matching key implies a
+  // complete graph file
+  return stored.str() == key && access(path.c_str(), R_OK) == 0;
+}
+
+void galois::graphs::internal::graphCacheStore(FileGraph& graph,
+                                               const std::string& path,
+                                               const std::string& key) {
+  if (access(directoryOf(path).c_str(), W_OK) != 0) {
+    galois::gWarn("cannot write graph cache '", path, "'");
+    return;
+  }
+
+  // write to temporaries and rename so that concurrent runs never observe a
+  // partial cache
+  std::string suffix   = ".tmp" + std::to_string(getpid());
+  std::string keyPath  = path + ".key";
+  std::string graphTmp = path + suffix;
+  std::string keyTmp   = keyPath + suffix;
+
+  unlink(keyPath.c_str());
+  if (!graph.tryToFile(graphTmp)) {
+    galois::gWarn("cannot write graph cache '", path, "': ",
+                  std::strerror(errno));
+    unlink(graphTmp.c_str());
+    return;
+  }
+  if (rename(graphTmp.c_str(), path.c_str()) != 0) {
+    galois::gWarn("cannot write graph cache '", path, "'");
+    unlink(graphTmp.c_str());
+    return;
+  }
+
+  {
+    std::ofstream keyFile(keyTmp);
+    keyFile << key;
+    if (!keyFile) {
+      galois::gWarn("cannot write graph cache key '", keyPath, "'");
+      return;
+    }
+  }
+  if (rename(keyTmp.c_str(), keyPath.c_str()) != 0) {
+    galois::gWarn("cannot write graph cache key '", keyPath, "'");
+    unlink(keyTmp.c_str());
+  }
+}
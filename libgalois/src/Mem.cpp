@@ -24,6 +24,12 @@
 
 using namespace galois::runtime;
 
+void galois::runtime::pageInReadOnly(void* buf, size_t len, size_t stride) {
+  volatile char* ptr = reinterpret_cast<volatile char*>(buf);
+  for (size_t i = 0; i < len; i += stride)
+    ptr[i];
+}
+
 // Anchor the class
 SystemHeap::SystemHeap() { assert(AllocSize == runtime::pagePoolSize()); }
 
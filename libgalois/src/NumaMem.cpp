@@ -22,17 +22,20 @@
 #include "galois/substrate/ThreadPool.h"
 #include "galois/gIO.h"
 
+#include <atomic>
 #include <cassert>
 
 using namespace galois::substrate;
 
 /* Access pages on each thread so each thread has some pages already loaded
- * (preferably ones it will use) */
+ * (preferably ones it will use). Allocations made from inside a parallel
+ * region (e.g., by a task of a TaskGroup) cannot start another run, so the
+ * calling thread pages in everything. */
 static void pageIn(void* _ptr, size_t len, size_t pageSize, unsigned numThreads,
                    bool finegrained) {
   char* ptr = static_cast<char*>(_ptr);
 
-  if (numThreads == 1) {
+  if (numThreads == 1 || getThreadPool().isRunning()) {
     for (size_t x = 0; x < len; x += pageSize / 2)
       ptr[x] = 0;
   } else {
@@ -81,7 +84,7 @@ static void pageInSpecified(void* _ptr, size_t len, size_t pageSize,
 
   char* ptr = static_cast<char*>(_ptr);
 
-  if (numThreads > 1) {
+  if (numThreads > 1 && !getThreadPool().isRunning()) {
     getThreadPool().run(
         numThreads, [ptr, pageSize, threadRanges, elementSize]() {
           auto myID = ThreadPool::getTID();
@@ -124,12 +127,27 @@ static void pageInSpecified(void* _ptr, size_t len, size_t pageSize,
           }
         });
   } else {
-    // 1 thread case
+    // 1 thread or nested case
     for (size_t x = 0; x < len; x += pageSize / 2)
       ptr[x] = 0;
   }
 }
 
+static std::atomic<size_t> largeAllocBytes[3];
+
+//! allocPages plus accounting of the kind of pages obtained
+static void* largeAllocPages(size_t bytes, bool preFault, PagePolicy policy) {
+  PageKind kind;
+  void* data = allocPages(bytes / allocSize(), preFault, policy, &kind);
+  if (data)
+    largeAllocBytes[static_cast<int>(kind)] += bytes;
+  return data;
+}
+
+size_t galois::substrate::numLargeAllocBytes(PageKind kind) {
+  return largeAllocBytes[static_cast<int>(kind)];
+}
+
 static void largeFree(void* ptr, size_t bytes) {
   freePages(ptr, bytes / allocSize());
 }
@@ -148,7 +166,8 @@ static size_t roundup(size_t data, size_t mult) {
 }
 
 LAptr galois::substrate::largeMallocInterleaved(size_t bytes,
-                                                unsigned numThreads) {
+                                                unsigned numThreads,
+                                                PagePolicy policy) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
 
@@ -159,7 +178,7 @@ LAptr galois::substrate::largeMallocInterleaved(size_t bytes,
   // the alloc would go
 #endif
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
+  void* data = largeAllocPages(bytes, false, policy);
 
   // Then page in based on thread number
   if (data)
@@ -169,27 +188,29 @@ LAptr galois::substrate::largeMallocInterleaved(size_t bytes,
   return LAptr{data, internal::largeFreer{bytes}};
 }
 
-LAptr galois::substrate::largeMallocLocal(size_t bytes) {
+LAptr galois::substrate::largeMallocLocal(size_t bytes, PagePolicy policy) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
   // Get a prefaulted allocation
-  return LAptr{allocPages(bytes / allocSize(), true),
+  return LAptr{largeAllocPages(bytes, true, policy),
                internal::largeFreer{bytes}};
 }
 
-LAptr galois::substrate::largeMallocFloating(size_t bytes) {
+LAptr galois::substrate::largeMallocFloating(size_t bytes,
+                                             PagePolicy policy) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
   // Get a non-prefaulted allocation
-  return LAptr{allocPages(bytes / allocSize(), false),
+  return LAptr{largeAllocPages(bytes, false, policy),
                internal::largeFreer{bytes}};
 }
 
-LAptr galois::substrate::largeMallocBlocked(size_t bytes, unsigned numThreads) {
+LAptr galois::substrate::largeMallocBlocked(size_t bytes, unsigned numThreads,
+                                           PagePolicy policy) {
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
+  void* data = largeAllocPages(bytes, false, policy);
   if (data)
     // false = blocked paging
     pageIn(data, bytes, allocSize(), numThreads, false);
@@ -207,16 +228,18 @@ LAptr galois::substrate::largeMallocBlocked(size_t bytes, unsigned numThreads) {
  * @param threadRanges Array specifying distribution of elements among threads
  * @param elementSize Size of a data element that will be stored in the
  * allocated memory
+ * @param policy Pages to back the allocation with
  * @returns The allocated memory along with a freer object
  */
 template <typename RangeArrayTy>
 LAptr galois::substrate::largeMallocSpecified(size_t bytes, uint32_t numThreads,
                                               RangeArrayTy& threadRanges,
-                                              size_t elementSize) {
+                                              size_t elementSize,
+                                              PagePolicy policy) {
   // ceiling to nearest page
   bytes = roundup(bytes, allocSize());
 
-  void* data = allocPages(bytes / allocSize(), false);
+  void* data = largeAllocPages(bytes, false, policy);
 
   // NUMA aware page in based on element distribution specified in threadRanges
   if (data)
@@ -229,7 +252,7 @@ LAptr galois::substrate::largeMallocSpecified(size_t bytes, uint32_t numThreads,
 // file
 template LAptr galois::substrate::largeMallocSpecified<std::vector<uint32_t>>(
     size_t bytes, uint32_t numThreads, std::vector<uint32_t>& threadRanges,
-    size_t elementSize);
+    size_t elementSize, PagePolicy policy);
 template LAptr galois::substrate::largeMallocSpecified<std::vector<uint64_t>>(
     size_t bytes, uint32_t numThreads, std::vector<uint64_t>& threadRanges,
-    size_t elementSize);
+    size_t elementSize, PagePolicy policy);
@@ -18,15 +18,24 @@
  */
 
 #include "galois/substrate/PageAlloc.h"
+#include "galois/substrate/EnvCheck.h"
 #include "galois/substrate/SimpleLock.h"
 #include "galois/gIO.h"
 
+#include <atomic>
+#include <map>
 #include <mutex>
 
 // figure this out dynamically
 const size_t hugePageSize = 2 * 1024 * 1024;
+const size_t gigPageSize  = 1024 * 1024 * 1024;
 // protect mmap, munmap since linux has issues
 static galois::substrate::SimpleLock allocLock;
+// 1GB mappings are rounded past the requested length; remember their size
+// so freePages can unmap all of it (protected by allocLock)
+static std::map<void*, size_t> gigMappings;
+
+static std::atomic<size_t> allocBytes[3];
 
 static void* trymmap(size_t size, int flag) {
   std::lock_guard<galois::substrate::SimpleLock> lg(allocLock);
@@ -48,38 +57,159 @@ static const bool doHandMap    = true;
 #ifdef MAP_HUGETLB
 static const int _MAP_HUGE_POP = MAP_HUGETLB | _MAP_POP;
 static const int _MAP_HUGE     = MAP_HUGETLB | _MAP;
+static const bool haveHuge     = true;
 #else
 static const int _MAP_HUGE_POP = _MAP_POP;
 static const int _MAP_HUGE     = _MAP;
+static const bool haveHuge     = false;
+#endif
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_1GB)
+static const int _MAP_GIG_POP = MAP_HUGE_1GB | _MAP_HUGE_POP;
+static const int _MAP_GIG     = MAP_HUGE_1GB | _MAP_HUGE;
+static const bool haveGig     = true;
+#else
+static const int _MAP_GIG_POP  = _MAP_HUGE_POP;
+static const int _MAP_GIG      = _MAP_HUGE;
+static const bool haveGig      = false;
+#endif
+
+//! Maps size bytes aligned to hugePageSize and advises the kernel to back
+//! them with transparent huge pages
+static void* trymmapTHP(size_t size) {
+#ifdef MADV_HUGEPAGE
+  // over-allocate so an aligned region fits, then trim both ends
+  char* raw = static_cast<char*>(trymmap(size + hugePageSize, _MAP));
+  if (!raw)
+    return nullptr;
+  std::lock_guard<galois::substrate::SimpleLock> lg(allocLock);
+  uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+  char* ptr      = raw + (hugePageSize - addr % hugePageSize) % hugePageSize;
+  size_t head    = ptr - raw;
+  if (head && munmap(raw, head) != 0)
+    GALOIS_SYS_DIE("Unmap failed");
+  if (hugePageSize - head && munmap(ptr + size, hugePageSize - head) != 0)
+    GALOIS_SYS_DIE("Unmap failed");
+  if (madvise(ptr, size, MADV_HUGEPAGE) != 0) {
+    galois::gDebug("THP madvise failed, using small pages");
+    if (munmap(ptr, size) != 0)
+      GALOIS_SYS_DIE("Unmap failed");
+    return nullptr;
+  }
+  return ptr;
+#else
+  (void)size;
+  return nullptr;
 #endif
+}
+
+static galois::substrate::PagePolicy initialPagePolicy() {
+  using galois::substrate::PagePolicy;
+  std::string val;
+  if (!galois::substrate::EnvCheck("GALOIS_PAGE_POLICY", val))
+    return PagePolicy::HUGETLB_2M;
+  if (val == "1G")
+    return PagePolicy::HUGETLB_1G;
+  if (val == "2M")
+    return PagePolicy::HUGETLB_2M;
+  if (val == "THP")
+    return PagePolicy::THP;
+  if (val == "SMALL")
+    return PagePolicy::SMALL;
+  galois::gWarn("Unknown GALOIS_PAGE_POLICY ", val, ", using 2M");
+  return PagePolicy::HUGETLB_2M;
+}
+
+static std::atomic<galois::substrate::PagePolicy>& globalPagePolicy() {
+  static std::atomic<galois::substrate::PagePolicy> policy{
+      initialPagePolicy()};
+  return policy;
+}
+
+void galois::substrate::setPagePolicy(PagePolicy policy) {
+  if (policy == PagePolicy::DEFAULT)
+    policy = initialPagePolicy();
+  globalPagePolicy() = policy;
+}
+
+galois::substrate::PagePolicy galois::substrate::getPagePolicy() {
+  return globalPagePolicy();
+}
 
 size_t galois::substrate::allocSize() { return hugePageSize; }
 
-void* galois::substrate::allocPages(unsigned num, bool preFault) {
-  if (num > 0) {
-    void* ptr =
-        trymmap(num * hugePageSize, preFault ? _MAP_HUGE_POP : _MAP_HUGE);
-    if (!ptr) {
-      gDebug("Huge page alloc failed, falling back");
-      ptr = trymmap(num * hugePageSize, preFault ? _MAP_POP : _MAP);
+size_t galois::substrate::numPageAllocBytes(PageKind kind) {
+  return allocBytes[static_cast<int>(kind)];
+}
+
+void* galois::substrate::allocPages(unsigned num, bool preFault,
+                                    PagePolicy policy, PageKind* kind) {
+  if (num == 0)
+    return nullptr;
+
+  if (policy == PagePolicy::DEFAULT)
+    policy = getPagePolicy();
+
+  size_t len   = num * hugePageSize;
+  PageKind got = PageKind::HUGETLB;
+  void* ptr    = nullptr;
+
+  // only worth rounding up when the waste is less than the request
+  if (haveGig && policy == PagePolicy::HUGETLB_1G && len >= gigPageSize) {
+    size_t mapped = (len + gigPageSize - 1) / gigPageSize * gigPageSize;
+    ptr           = trymmap(mapped, preFault ? _MAP_GIG_POP : _MAP_GIG);
+    if (ptr) {
+      std::lock_guard<SimpleLock> lg(allocLock);
+      gigMappings[ptr] = mapped;
+    } else {
+      gDebug("1GB huge page alloc failed, falling back");
     }
+  }
 
+  if (!ptr && haveHuge &&
+      (policy == PagePolicy::HUGETLB_1G || policy == PagePolicy::HUGETLB_2M)) {
+    ptr = trymmap(len, preFault ? _MAP_HUGE_POP : _MAP_HUGE);
     if (!ptr)
-      GALOIS_SYS_DIE("Out of Memory");
+      gDebug("Huge page alloc failed, falling back");
+  }
 
-    if (preFault && doHandMap)
-      for (size_t x = 0; x < num * hugePageSize; x += 4096)
-        static_cast<char*>(ptr)[x] = 0;
+  bool handMap = preFault && doHandMap;
+  if (!ptr && policy != PagePolicy::SMALL) {
+    got = PageKind::THP;
+    // populating before the advice would fault in small pages
+    ptr     = trymmapTHP(len);
+    handMap = preFault;
+  }
 
-    return ptr;
-  } else {
-    return nullptr;
+  if (!ptr) {
+    got     = PageKind::SMALL;
+    ptr     = trymmap(len, preFault ? _MAP_POP : _MAP);
+    handMap = preFault && doHandMap;
   }
+
+  if (!ptr)
+    GALOIS_SYS_DIE("Out of Memory");
+
+  if (handMap)
+    for (size_t x = 0; x < len; x += 4096)
+      static_cast<char*>(ptr)[x] = 0;
+
+  // count the requested length so that the kinds add up to what callers
+  // asked for, whether or not a 1GB mapping was rounded up
+  allocBytes[static_cast<int>(got)] += len;
+  if (kind)
+    *kind = got;
+  return ptr;
 }
 
 void galois::substrate::freePages(void* ptr, unsigned num) {
   std::lock_guard<SimpleLock> lg(allocLock);
-  if (munmap(ptr, num * hugePageSize) != 0)
+  size_t len = num * hugePageSize;
+  auto ii    = gigMappings.find(ptr);
+  if (ii != gigMappings.end()) {
+    len = ii->second;
+    gigMappings.erase(ii);
+  }
+  if (munmap(ptr, len) != 0)
     GALOIS_SYS_DIE("Unmap failed");
 }
 
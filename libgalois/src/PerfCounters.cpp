@@ -0,0 +1,164 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/runtime/PerfCounters.h"
+#include "galois/gIO.h"
+#include "galois/substrate/EnvCheck.h"
+
+#ifdef __linux__
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace galois {
+namespace runtime {
+
+const char* const perfCounterNames[NUM_PERF_COUNTERS] = {
+    "Cycles", "Instructions", "LLCMisses", "DTLBMisses", "BranchMisses"};
+
+} // namespace runtime
+} // namespace galois
+
+using namespace galois::runtime;
+
+#ifdef __linux__
+
+namespace {
+
+bool perfEventsRequested() {
+  static const bool requested =
+      galois::substrate::EnvCheck("GALOIS_PERF_EVENTS");
+  return requested;
+}
+
+int perfOpen(uint32_t type, uint64_t config, int group) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = type;
+  attr.config         = config;
+  attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+//! One counter group per thread, opened on first use and kept across loops
+struct PerfGroup {
+  int fds[NUM_PERF_COUNTERS];
+  unsigned mask = 0;
+  unsigned num  = 0;
+
+  PerfGroup() {
+    std::fill(fds, fds + NUM_PERF_COUNTERS, -1);
+    if (!perfEventsRequested())
+      return;
+
+    const uint64_t dtlbReadMiss = PERF_COUNT_HW_CACHE_DTLB |
+                                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct {
+      uint32_t type;
+      uint64_t config;
+    } events[NUM_PERF_COUNTERS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HW_CACHE, dtlbReadMiss},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    int leader = -1;
+    for (unsigned i = 0; i < NUM_PERF_COUNTERS; ++i) {
+      fds[i] = perfOpen(events[i].type, events[i].config, leader);
+      if (fds[i] < 0)
+        continue;
+      if (leader < 0)
+        leader = fds[i];
+      mask |= 1u << i;
+      ++num;
+    }
+
+    if (!mask) {
+      static bool warned = false;
+      if (!__sync_lock_test_and_set(&warned, true))
+        galois::gWarn("GALOIS_PERF_EVENTS set but perf_event_open failed: ",
+                      std::strerror(errno));
+    }
+  }
+
+  ~PerfGroup() {
+    for (int fd : fds) {
+      if (fd >= 0)
+        close(fd);
+    }
+  }
+
+  bool read(PerfCounterSample& sample) {
+    if (!mask)
+      return false;
+    // number of counters, the times the group was enabled and running, then
+    // the values in the order the counters were added to the group
+    uint64_t buf[3 + NUM_PERF_COUNTERS];
+    int leader = fds[__builtin_ctz(mask)];
+    if (::read(leader, buf, sizeof(buf)) < (ssize_t)((3 + num) * 8))
+      return false;
+    sample.enabled = buf[1];
+    sample.running = buf[2];
+    for (unsigned i = 0, j = 3; i < NUM_PERF_COUNTERS; ++i) {
+      if (mask & (1u << i))
+        sample.vals[i] = buf[j++];
+    }
+    return true;
+  }
+};
+
+PerfGroup& perfGroup() {
+  static thread_local PerfGroup group;
+  return group;
+}
+
+} // namespace
+
+unsigned galois::runtime::perfCountersAvailable() {
+  if (!perfEventsRequested())
+    return 0;
+  return perfGroup().mask;
+}
+
+bool galois::runtime::perfCountersRead(PerfCounterSample& sample) {
+  if (!perfEventsRequested())
+    return false;
+  return perfGroup().read(sample);
+}
+
+#else
+
+unsigned galois::runtime::perfCountersAvailable() { return 0; }
+
+bool galois::runtime::perfCountersRead(PerfCounterSample&) { return false; }
+
+#endif
@@ -0,0 +1,259 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/SetIntersection.h"
+#include "galois/gIO.h"
+#include "galois/substrate/EnvCheck.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GALOIS_INTERSECT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+//! Size ratio above which the shorter list is galloped through the longer one
+constexpr size_t gallopRatio = 32;
+
+template <bool Materialize>
+size_t mergeScalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                   uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      if (Materialize)
+        out[count] = a[i];
+      ++count;
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+//! First position in b[lo, n) that is not less than key
+size_t gallop(const uint32_t* b, size_t lo, size_t n, uint32_t key) {
+  size_t hi   = lo;
+  size_t step = 1;
+  while (hi < n && b[hi] < key) {
+    lo = hi + 1;
+    hi += step;
+    step <<= 1;
+  }
+  return std::lower_bound(b + lo, b + std::min(hi, n), key) - b;
+}
+
+template <bool Materialize>
+size_t gallopIntersect(const uint32_t* small, size_t ns, const uint32_t* large,
+                       size_t nl, uint32_t* out) {
+  size_t j = 0, count = 0;
+  for (size_t i = 0; i < ns && j < nl; ++i) {
+    j = gallop(large, j, nl, small[i]);
+    if (j < nl && large[j] == small[i]) {
+      if (Materialize)
+        out[count] = small[i];
+      ++count;
+      ++j;
+    }
+  }
+  return count;
+}
+
+#ifdef GALOIS_INTERSECT_X86
+
+/**
+ * Compares a block of 8 elements of a against all rotations of a block of b,
+ * then advances the block(s) with the smaller maximum. Every common element
+ * is seen exactly once because each pair of blocks is compared at most once.
+ */
+template <bool Materialize>
+__attribute__((target("avx2,popcnt"))) size_t
+mergeAVX2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+          uint32_t* out) {
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  size_t i = 0, j = 0, count = 0;
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m256i va    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i match = _mm256_cmpeq_epi32(va, vb);
+    for (int r = 1; r < 8; ++r) {
+      vb    = _mm256_permutevar8x32_epi32(vb, rotate);
+      match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+    }
+    unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(match));
+    if (Materialize) {
+      for (; mask; mask &= mask - 1)
+        out[count++] = a[i + __builtin_ctz(mask)];
+    } else {
+      count += __builtin_popcount(mask);
+    }
+
+    uint32_t amax = a[i + 7], bmax = b[j + 7];
+    if (amax <= bmax)
+      i += 8;
+    if (bmax <= amax)
+      j += 8;
+  }
+  return count + mergeScalar<Materialize>(a + i, na - i, b + j, nb - j,
+                                          out + (Materialize ? count : 0));
+}
+
+//! mergeAVX2 with blocks of 16 and compress-stores for materialization
+template <bool Materialize>
+__attribute__((target("avx512f,popcnt"))) size_t
+mergeAVX512(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+            uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  while (i + 16 <= na && j + 16 <= nb) {
+    __m512i va      = _mm512_loadu_si512(a + i);
+    __m512i vb      = _mm512_loadu_si512(b + j);
+    __mmask16 match = _mm512_cmpeq_epi32_mask(va, vb);
+    for (int r = 1; r < 16; ++r) {
+      // the masked form avoids GCC's uninitialized-source warning
+      vb = _mm512_mask_alignr_epi32(vb, 0xFFFF, vb, vb, 1);
+      match |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    if (Materialize)
+      _mm512_mask_compressstoreu_epi32(out + count, match, va);
+    count += __builtin_popcount(match);
+
+    uint32_t amax = a[i + 15], bmax = b[j + 15];
+    if (amax <= bmax)
+      i += 16;
+    if (bmax <= amax)
+      j += 16;
+  }
+  return count + mergeScalar<Materialize>(a + i, na - i, b + j, nb - j,
+                                          out + (Materialize ? count : 0));
+}
+
+#endif
+
+galois::IntersectKernel selectKernel() {
+  using galois::IntersectKernel;
+  IntersectKernel kernel = IntersectKernel::SCALAR;
+  if (galois::intersectKernelSupported(IntersectKernel::AVX512)) {
+    kernel = IntersectKernel::AVX512;
+  } else if (galois::intersectKernelSupported(IntersectKernel::AVX2)) {
+    kernel = IntersectKernel::AVX2;
+  }
+
+  std::string requested;
+  if (galois::substrate::EnvCheck("GALOIS_INTERSECT_KERNEL", requested)) {
+    for (IntersectKernel k : {IntersectKernel::SCALAR, IntersectKernel::AVX2,
+                              IntersectKernel::AVX512}) {
+      if (requested != galois::intersectKernelName(k))
+        continue;
+      if (galois::intersectKernelSupported(k))
+        return k;
+      galois::gWarn("GALOIS_INTERSECT_KERNEL=", requested,
+                    " is not supported on this machine; using ",
+                    galois::intersectKernelName(kernel));
+      return kernel;
+    }
+    galois::gWarn("unknown GALOIS_INTERSECT_KERNEL=", requested, "; using ",
+                  galois::intersectKernelName(kernel));
+  }
+  return kernel;
+}
+
+template <bool Materialize>
+size_t dispatch(galois::IntersectKernel kernel, const uint32_t* a, size_t na,
+                const uint32_t* b, size_t nb, uint32_t* out) {
+  if (na == 0 || nb == 0)
+    return 0;
+  if (na * gallopRatio < nb)
+    return gallopIntersect<Materialize>(a, na, b, nb, out);
+  if (nb * gallopRatio < na)
+    return gallopIntersect<Materialize>(b, nb, a, na, out);
+
+  switch (kernel) {
+#ifdef GALOIS_INTERSECT_X86
+  case galois::IntersectKernel::AVX512:
+    return mergeAVX512<Materialize>(a, na, b, nb, out);
+  case galois::IntersectKernel::AVX2:
+    return mergeAVX2<Materialize>(a, na, b, nb, out);
+#endif
+  default:
+    return mergeScalar<Materialize>(a, na, b, nb, out);
+  }
+}
+
+} // namespace
+
+const char* galois::intersectKernelName(IntersectKernel kernel) {
+  switch (kernel) {
+  case IntersectKernel::SCALAR:
+    return "scalar";
+  case IntersectKernel::AVX2:
+    return "avx2";
+  case IntersectKernel::AVX512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+bool galois::intersectKernelSupported(IntersectKernel kernel) {
+  switch (kernel) {
+  case IntersectKernel::SCALAR:
+    return true;
+#ifdef GALOIS_INTERSECT_X86
+  case IntersectKernel::AVX2:
+    return __builtin_cpu_supports("avx2");
+  case IntersectKernel::AVX512:
+    return __builtin_cpu_supports("avx512f");
+#endif
+  default:
+    return false;
+  }
+}
+
+galois::IntersectKernel galois::intersectKernel() {
+  static const IntersectKernel kernel = selectKernel();
+  return kernel;
+}
+
+size_t galois::intersectCount(const uint32_t* a, size_t na, const uint32_t* b,
+                              size_t nb) {
+  return dispatch<false>(intersectKernel(), a, na, b, nb, nullptr);
+}
+
+size_t galois::intersect(const uint32_t* a, size_t na, const uint32_t* b,
+                         size_t nb, uint32_t* out) {
+  return dispatch<true>(intersectKernel(), a, na, b, nb, out);
+}
+
+size_t galois::intersectCount(IntersectKernel kernel, const uint32_t* a,
+                              size_t na, const uint32_t* b, size_t nb) {
+  GALOIS_ASSERT(intersectKernelSupported(kernel));
+  return dispatch<false>(kernel, a, na, b, nb, nullptr);
+}
+
+size_t galois::intersect(IntersectKernel kernel, const uint32_t* a, size_t na,
+                         const uint32_t* b, size_t nb, uint32_t* out) {
+  GALOIS_ASSERT(intersectKernelSupported(kernel));
+  return dispatch<true>(kernel, a, na, b, nb, out);
+}
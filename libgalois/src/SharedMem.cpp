@@ -21,6 +21,7 @@
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/ThreadPool.h"
 #include "galois/substrate/Termination.h"
+#include "galois/substrate/Trace.h"
 
 #include <memory>
 
@@ -37,6 +38,8 @@ galois::substrate::SharedMem::SharedMem() {
 }
 
 galois::substrate::SharedMem::~SharedMem() {
+  traceDump();
+
   internal::setTermDetect(nullptr);
   internal::setBarrierInstance(nullptr);
 
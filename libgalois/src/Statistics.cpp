@@ -19,10 +19,20 @@
 
 #include "galois/runtime/Statistics.h"
 #include "galois/runtime/Executor_OnEach.h"
+#include "galois/substrate/NumaMem.h"
+#include "galois/substrate/PageAlloc.h"
+#include "galois/Version.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 
+#include <unistd.h>
+
 using namespace galois::runtime;
 
 boost::uuids::uuid galois::runtime::getRandUUID(void) {
@@ -79,8 +89,67 @@ void StatManager::print(void) {
   }
 }
 
+StatFormat StatManager::statFormat(void) const {
+  std::string name;
+  if (!galois::substrate::EnvCheck(FORMAT_ENV_VAR, name)) {
+    auto dot = m_outfile.rfind('.');
+    name     = dot == std::string::npos ? "" : m_outfile.substr(dot + 1);
+  }
+  std::transform(name.begin(), name.end(), name.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+
+  if (name == "csv") {
+    return StatFormat::CSV;
+  } else if (name == "json" || name == "jsonl") {
+    return StatFormat::JSON;
+  }
+  return StatFormat::TEXT;
+}
+
+StatManager::Str StatManager::findParam(const Str& region,
+                                        const Str& category) const {
+  auto i = strStats.result.findStat(region, category);
+  if (i == strStats.result.cend()) {
+    return Str();
+  }
+  return strStats.result.stat(i).total();
+}
+
+StatRunInfo StatManager::runInfo(void) const {
+  StatRunInfo info;
+  info.uuid = boost::uuids::to_string(getRandUUID());
+
+  char name[256];
+  if (gethostname(name, sizeof(name)) == 0) {
+    name[sizeof(name) - 1] = '\0';
+    info.hostname          = name;
+  }
+
+  // shared-memory apps report the input without a region, distributed ones
+  // under DistBench
+  for (const char* region : {"(NULL)", "DistBench"}) {
+    info.input = internal::statToStr(findParam(region, "Input"));
+    if (!info.input.empty())
+      break;
+  }
+  info.version  = galois::getVersion();
+  info.revision = galois::getRevision();
+  info.threads  = galois::getActiveThreads();
+  return info;
+}
+
 void StatManager::printStats(std::ostream& out) {
   mergeStats();
+
+  StatFormat format = statFormat();
+  if (format != StatFormat::TEXT) {
+    StatWriter w(out, format, runInfo());
+    intStats.write(w);
+    fpStats.write(w);
+    strStats.write(w);
+    return;
+  }
+
   printHeader(out);
   intStats.print(out);
   fpStats.print(out);
@@ -94,6 +163,169 @@ void StatManager::printHeader(std::ostream& out) const {
   out << "\n";
 }
 
+namespace {
+
+void writeCSVField(std::ostream& out, const std::string& s) {
+  if (s.find_first_of(",\"\n") == std::string::npos) {
+    out << s;
+    return;
+  }
+  out << '"';
+  for (char c : s) {
+    if (c == '"') {
+      out << '"';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+void writeJSONString(std::ostream& out, const std::string& s) {
+  out << '"';
+  for (unsigned char c : s) {
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if (c < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out << buf;
+      } else {
+        out << c;
+      }
+    }
+  }
+  out << '"';
+}
+
+//! JSON has no NaN or infinity; an empty aggregate is null as well
+void writeJSONNumber(std::ostream& out, const std::string& s) {
+  char* end = nullptr;
+  double v  = std::strtod(s.c_str(), &end);
+  if (s.empty() || *end != '\0' || !std::isfinite(v)) {
+    out << "null";
+  } else {
+    out << s;
+  }
+}
+
+const char* const CSV_COLUMNS[] = {
+    "schema", "uuid", "hostname", "threads", "hosts", "input", "version",
+    "revision", "kind", "scope", "host", "region", "category", "total_type",
+    "total", "min", "max", "mean", "values"};
+
+} // namespace
+
+StatWriter::StatWriter(std::ostream& o, StatFormat f, const StatRunInfo& i)
+    : out(o), format(f), info(i) {
+  if (format == StatFormat::CSV) {
+    const char* sep = "";
+    for (const char* c : CSV_COLUMNS) {
+      out << sep << c;
+      sep = ",";
+    }
+    out << "\n";
+
+  } else if (format == StatFormat::JSON) {
+    out << "{\"schema\":" << SCHEMA_VERSION;
+    out << ",\"record\":\"run\",\"uuid\":";
+    writeJSONString(out, info.uuid);
+    out << ",\"hostname\":";
+    writeJSONString(out, info.hostname);
+    out << ",\"threads\":" << info.threads << ",\"hosts\":" << info.hosts;
+    out << ",\"input\":";
+    writeJSONString(out, info.input);
+    out << ",\"version\":";
+    writeJSONString(out, info.version);
+    out << ",\"revision\":";
+    writeJSONString(out, info.revision);
+    out << "}\n";
+  }
+}
+
+void StatWriter::write(const StatRecord& r) {
+  const std::string host = r.host < 0 ? "" : std::to_string(r.host);
+
+  if (format == StatFormat::CSV) {
+    out << SCHEMA_VERSION << ",";
+    for (const std::string& f : {info.uuid, info.hostname}) {
+      writeCSVField(out, f);
+      out << ",";
+    }
+    out << info.threads << "," << info.hosts << ",";
+    for (const std::string& f :
+         {info.input, info.version, info.revision, std::string(r.kind),
+          std::string(r.scope), host, r.region, r.category, r.totalTy,
+          r.total, r.min, r.max, r.mean}) {
+      writeCSVField(out, f);
+      out << ",";
+    }
+    std::string values;
+    const char* sep = "";
+    for (const auto& v : r.values) {
+      values += sep + v;
+      sep = StatManager::TSTAT_SEP;
+    }
+    writeCSVField(out, values);
+    out << "\n";
+    return;
+  }
+
+  auto value = [&](const std::string& v) {
+    if (r.numeric) {
+      writeJSONNumber(out, v);
+    } else {
+      writeJSONString(out, v);
+    }
+  };
+
+  out << "{\"schema\":" << SCHEMA_VERSION;
+  out << ",\"record\":\"stat\",\"kind\":";
+  writeJSONString(out, r.kind);
+  out << ",\"uuid\":";
+  writeJSONString(out, info.uuid);
+  out << ",\"scope\":";
+  writeJSONString(out, r.scope);
+  if (r.host >= 0) {
+    out << ",\"host\":" << r.host;
+  }
+  out << ",\"region\":";
+  writeJSONString(out, r.region);
+  out << ",\"category\":";
+  writeJSONString(out, r.category);
+  out << ",\"total_type\":";
+  writeJSONString(out, r.totalTy);
+  out << ",\"total\":";
+  value(r.total);
+  if (r.numeric) {
+    out << ",\"min\":";
+    writeJSONNumber(out, r.min);
+    out << ",\"max\":";
+    writeJSONNumber(out, r.max);
+    out << ",\"mean\":";
+    writeJSONNumber(out, r.mean);
+  }
+  out << ",\"values\":[";
+  const char* sep = "";
+  for (const auto& v : r.values) {
+    out << sep;
+    value(v);
+    sep = ",";
+  }
+  out << "]}\n";
+}
+
 StatManager::int_iterator StatManager::intBegin(void) const {
   return intStats.cbegin();
 }
@@ -131,16 +363,26 @@ void galois::runtime::reportPageAlloc(const char* category) {
         reportStat_Tsum("PageAlloc", category, numPagePoolAllocForThread(tid));
       },
       std::make_tuple());
+
+  using substrate::PageKind;
+  const std::string cat(category);
+  reportStat_Single("PageAlloc", cat + "_HugeTLBBytes",
+                    substrate::numPageAllocBytes(PageKind::HUGETLB));
+  reportStat_Single("PageAlloc", cat + "_THPBytes",
+                    substrate::numPageAllocBytes(PageKind::THP));
+  reportStat_Single("PageAlloc", cat + "_SmallBytes",
+                    substrate::numPageAllocBytes(PageKind::SMALL));
 }
 
-void galois::runtime::reportNumaAlloc(const char*) {
-  galois::gWarn("reportNumaAlloc NOT IMPLEMENTED YET. TBD");
-  int nodes = substrate::getThreadPool().getMaxNumaNodes();
-  for (int x = 0; x < nodes; ++x) {
-    // auto rStat = Stats.getRemote(x);
-    // std::lock_guard<substrate::SimpleLock> lg(rStat->first);
-    //      rStat->second.emplace_back(loop, category, numNumaAllocForNode(x));
-  }
-  //  SC->addNumaAllocToStat(std::string("(NULL)"), std::string(category ?
-  //  category : "(NULL)"));
+void galois::runtime::reportNumaAlloc(const char* category) {
+  // per NUMA node counts are not tracked; report what large (NUMA placed)
+  // allocations got from the OS
+  using substrate::PageKind;
+  const std::string cat(category);
+  reportStat_Single("NumaAlloc", cat + "_HugeTLBBytes",
+                    substrate::numLargeAllocBytes(PageKind::HUGETLB));
+  reportStat_Single("NumaAlloc", cat + "_THPBytes",
+                    substrate::numLargeAllocBytes(PageKind::THP));
+  reportStat_Single("NumaAlloc", cat + "_SmallBytes",
+                    substrate::numLargeAllocBytes(PageKind::SMALL));
 }
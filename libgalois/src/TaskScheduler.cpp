@@ -0,0 +1,142 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/runtime/TaskScheduler.h"
+#include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/ThreadPool.h"
+
+#include <mutex>
+#include <thread>
+
+namespace galois::runtime {
+
+namespace {
+thread_local TaskScheduler* currentScheduler = nullptr;
+
+//! failed attempts to find work before an idle thread starts yielding
+constexpr unsigned IDLE_SPINS = 64;
+} // namespace
+
+TaskScheduler::TaskScheduler(unsigned numThreads) : numThreads(numThreads) {}
+
+TaskScheduler* TaskScheduler::current() { return currentScheduler; }
+
+void TaskScheduler::push(std::shared_ptr<Task> t) {
+  unsigned tid = substrate::ThreadPool::getTID();
+  if (currentScheduler != this) {
+    // submitted before the run; spread tasks so every thread starts busy
+    tid = nextDeque++ % numThreads;
+  }
+  Deque& d = *deques.getRemote(tid);
+  std::lock_guard<substrate::SimpleLock> lg(d.lock);
+  d.tasks.push_back(std::move(t));
+}
+
+std::shared_ptr<Task> TaskScheduler::pop() {
+  Deque& d = *deques.getLocal();
+  std::lock_guard<substrate::SimpleLock> lg(d.lock);
+  if (d.tasks.empty()) {
+    return nullptr;
+  }
+  std::shared_ptr<Task> t = std::move(d.tasks.back());
+  d.tasks.pop_back();
+  return t;
+}
+
+std::shared_ptr<Task> TaskScheduler::steal() {
+  unsigned tid = substrate::ThreadPool::getTID();
+  for (unsigned i = 1; i < numThreads; ++i) {
+    Deque& d = *deques.getRemote((tid + i) % numThreads);
+    if (!d.lock.try_lock()) {
+      continue;
+    }
+    std::shared_ptr<Task> t;
+    if (!d.tasks.empty()) {
+      t = std::move(d.tasks.front());
+      d.tasks.pop_front();
+    }
+    d.lock.unlock();
+    if (t) {
+      return t;
+    }
+  }
+  return nullptr;
+}
+
+void TaskScheduler::runTask(std::shared_ptr<Task> t) {
+  t->execute();
+
+  std::vector<std::shared_ptr<Task>> successors;
+  {
+    std::lock_guard<substrate::SimpleLock> lg(t->lock);
+    t->done.store(true, std::memory_order_release);
+    successors.swap(t->successors);
+  }
+  for (auto& s : successors) {
+    if (--s->pending == 0) {
+      push(std::move(s));
+    }
+  }
+  t->outstanding->fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::submit(std::shared_ptr<Task> t,
+                           std::atomic<size_t>& outstanding,
+                           const std::vector<std::shared_ptr<Task>>& deps) {
+  t->outstanding = &outstanding;
+  ++outstanding;
+  for (auto& d : deps) {
+    std::lock_guard<substrate::SimpleLock> lg(d->lock);
+    if (!d->isDone()) {
+      ++t->pending;
+      d->successors.push_back(t);
+    }
+  }
+  if (--t->pending == 0) {
+    push(std::move(t));
+  }
+}
+
+void TaskScheduler::helpUntil(const std::atomic<size_t>& outstanding) {
+  unsigned idle = 0;
+  while (outstanding.load(std::memory_order_acquire) != 0) {
+    std::shared_ptr<Task> t = pop();
+    if (!t) {
+      t = steal();
+    }
+    if (t) {
+      runTask(std::move(t));
+      idle = 0;
+    } else if (++idle < IDLE_SPINS) {
+      substrate::asmPause();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void TaskScheduler::run(const std::atomic<size_t>& outstanding) {
+  substrate::getThreadPool().run(numThreads, [&] {
+    currentScheduler = this;
+    helpUntil(outstanding);
+    currentScheduler = nullptr;
+  });
+}
+
+} // namespace galois::runtime
@@ -23,8 +23,15 @@
 #include "galois/gIO.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
 namespace galois::substrate {
@@ -37,10 +44,79 @@ using galois::substrate::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+#ifdef __linux__
+
+void ThreadPool::per_signal::park() {
+  int expected = 0;
+  if (release.compare_exchange_strong(expected, PARKED)) {
+    while (release.load() == PARKED) {
+      syscall(SYS_futex, reinterpret_cast<int*>(&release), FUTEX_WAIT_PRIVATE,
+              PARKED, nullptr, nullptr, 0);
+    }
+  }
+  release = 0;
+}
+
+void ThreadPool::per_signal::unpark() {
+  syscall(SYS_futex, reinterpret_cast<int*>(&release), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+}
+
+#else
+
+void ThreadPool::per_signal::park() {
+  std::unique_lock<std::mutex> lg(m);
+  int expected = 0;
+  if (release.compare_exchange_strong(expected, PARKED)) {
+    cv.wait(lg, [this] { return release.load() != PARKED; });
+  }
+  release = 0;
+}
+
+void ThreadPool::per_signal::unpark() {
+  std::lock_guard<std::mutex> lg(m);
+  cv.notify_one();
+}
+
+#endif
+
+/**
+ * Number of pause instructions that take roughly GALOIS_SPIN_US microseconds
+ * (default 50), the time an idle thread spins before parking. The cost of a
+ * pause varies by more than 10x across microarchitectures, so it is measured.
+ */
+static unsigned calibrateSpin() {
+  int us = 50;
+  galois::substrate::EnvCheck("GALOIS_SPIN_US", us);
+  if (us <= 0) {
+    return 0;
+  }
+
+  using namespace std::chrono;
+  const unsigned probe = 1000;
+  auto best            = nanoseconds::max();
+  for (int trial = 0; trial < 5; ++trial) {
+    auto start = steady_clock::now();
+    for (unsigned i = 0; i < probe; ++i) {
+      galois::substrate::asmPause();
+    }
+    best =
+        std::min(best, duration_cast<nanoseconds>(steady_clock::now() - start));
+  }
+  double pausesPerUs = probe * 1000.0 / std::max<int64_t>(best.count(), 1);
+  return static_cast<unsigned>(std::max(1.0, us * pausesPerUs));
+}
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo), reserved(0), masterFastmode(false),
-      running(false) {
+      spinPauses(calibrateSpin()), running(false) {
   signals.resize(mi.maxThreads);
+  auto topo = getHWTopo().threadTopoInfo;
+  for (unsigned t = 1; t < mi.maxThreads; ++t) {
+    if (topo[t].socket != topo[t - 1].socket) {
+      socketStarts.push_back(t);
+    }
+  }
   initThread(0);
 
   for (unsigned i = 1; i < mi.maxThreads; ++i) {
@@ -134,8 +210,8 @@ void ThreadPool::threadLoop(unsigned tid) {
   bool fastmode = false;
   auto& me      = my_box;
   do {
-    me.wait(fastmode);
-    cascade(fastmode);
+    me.wait(fastmode, spinPauses);
+    cascade();
     try {
       work();
     } catch (const shutdown_ty&) {
@@ -157,11 +233,30 @@ void ThreadPool::threadLoop(unsigned tid) {
   } while (true);
 }
 
+unsigned ThreadPool::cascadeSplit(unsigned wbegin, unsigned wend) const {
+  unsigned midpoint = wbegin + (1 + wend - wbegin) / 2;
+  // prefer the socket boundary nearest to the middle so that each subtree
+  // wakes threads on its own socket; on ties the lower boundary wins
+  unsigned best = midpoint;
+  unsigned dist = ~0U;
+  auto above =
+      std::lower_bound(socketStarts.begin(), socketStarts.end(), midpoint);
+  if (above != socketStarts.begin() && *(above - 1) > wbegin) {
+    best = *(above - 1);
+    dist = midpoint - best;
+  }
+  if (above != socketStarts.end() && *above < wend &&
+      *above - midpoint < dist) {
+    best = *above;
+  }
+  return best;
+}
+
 void ThreadPool::decascade() {
   auto& me = my_box;
   // nothing to wake up
   if (me.wbegin != me.wend) {
-    auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
+    auto midpoint = cascadeSplit(me.wbegin, me.wend);
     auto& c1done  = signals[me.wbegin]->done;
     while (!c1done) {
       asmPause();
@@ -176,7 +271,7 @@ void ThreadPool::decascade() {
   me.done = 1;
 }
 
-void ThreadPool::cascade(bool fastmode) {
+void ThreadPool::cascade() {
   auto& me = my_box;
   assert(me.wbegin <= me.wend);
 
@@ -185,18 +280,18 @@ void ThreadPool::cascade(bool fastmode) {
     return;
   }
 
-  auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
+  auto midpoint = cascadeSplit(me.wbegin, me.wend);
 
   auto child1    = signals[me.wbegin];
   child1->wbegin = me.wbegin + 1;
   child1->wend   = midpoint;
-  child1->wakeup(fastmode);
+  child1->wakeup();
 
   if (midpoint < me.wend) {
     auto child2    = signals[midpoint];
     child2->wbegin = midpoint + 1;
     child2->wend   = me.wend;
-    child2->wakeup(fastmode);
+    child2->wakeup();
   }
 }
 
@@ -213,7 +308,7 @@ void ThreadPool::runInternal(unsigned num) {
 
   assert(!masterFastmode || masterFastmode == num);
   // launch threads
-  cascade(masterFastmode);
+  cascade();
   // Do master thread work
   try {
     work();
@@ -242,7 +337,7 @@ void ThreadPool::runDedicated(std::function<void(void)>& f) {
   child->wbegin = 0;
   child->wend   = 0;
   child->done   = 0;
-  child->wakeup(masterFastmode);
+  child->wakeup();
   while (!child->done) {
     asmPause();
   }
@@ -0,0 +1,246 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/substrate/Trace.h"
+
+#ifdef GALOIS_ENABLE_TRACE
+
+#include "galois/gIO.h"
+#include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/EnvCheck.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace galois::substrate;
+
+namespace {
+
+struct Event {
+  uint64_t start;
+  uint64_t end;
+  uint64_t arg;
+  TraceCategory cat;
+  bool instant;
+  //! Copy of the name; the caller's string may not outlive the event
+  char name[32];
+};
+
+struct Ring {
+  std::vector<Event> events;
+  uint64_t count = 0;
+  std::string name;
+  //! Set while the owning thread writes an event, so that traceDump can wait
+  //! for writes that started before recording was stopped
+  std::atomic<bool> recording{false};
+};
+
+struct Registry {
+  SimpleLock lock;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::string file;
+  size_t capacity     = 1 << 16;
+  unsigned pid        = getpid();
+  bool perProcessFile = false;
+  std::chrono::steady_clock::time_point base;
+
+  Registry() : base(std::chrono::steady_clock::now()) {
+    EnvCheck("GALOIS_TRACE_FILE", file);
+    int events = 0;
+    if (EnvCheck("GALOIS_TRACE_EVENTS", events) && events > 0)
+      capacity = events;
+  }
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+thread_local Ring* localRing = nullptr;
+
+Ring& getRing() {
+  if (!localRing) {
+    Registry& r = registry();
+    std::lock_guard<SimpleLock> lg(r.lock);
+    r.rings.emplace_back(std::make_unique<Ring>());
+    localRing = r.rings.back().get();
+    localRing->events.resize(r.capacity);
+    localRing->name = "thread " + std::to_string(ThreadPool::getTID());
+  }
+  return *localRing;
+}
+
+const char* categoryName(TraceCategory cat) {
+  switch (cat) {
+  case TraceCategory::LOOP:
+    return "loop";
+  case TraceCategory::CHUNK:
+    return "chunk";
+  case TraceCategory::STEAL:
+    return "steal";
+  case TraceCategory::BARRIER:
+    return "barrier";
+  case TraceCategory::TERMINATION:
+    return "termination";
+  case TraceCategory::NETWORK:
+    return "network";
+  }
+  return "unknown";
+}
+
+//! Writes s as a JSON string
+void writeString(FILE* out, const char* s) {
+  std::fputc('"', out);
+  for (; s && *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      std::fputc('\\', out);
+    if (static_cast<unsigned char>(*s) >= 0x20)
+      std::fputc(*s, out);
+  }
+  std::fputc('"', out);
+}
+
+} // namespace
+
+std::atomic<bool> galois::substrate::internal::traceActive{
+    !registry().file.empty()};
+
+uint64_t galois::substrate::internal::traceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - registry().base)
+      .count();
+}
+
+void galois::substrate::internal::traceRecord(TraceCategory cat,
+                                              const char* name, uint64_t start,
+                                              uint64_t end, uint64_t arg,
+                                              bool instant) {
+  Ring& ring = getRing();
+  ring.recording.store(true);
+  if (traceActive.load()) {
+    Event& e  = ring.events[ring.count % ring.events.size()];
+    e.start   = start;
+    e.end     = end;
+    e.arg     = arg;
+    e.cat     = cat;
+    e.instant = instant;
+    std::strncpy(e.name, name ? name : "", sizeof(e.name) - 1);
+    e.name[sizeof(e.name) - 1] = '\0';
+    ++ring.count;
+  }
+  ring.recording.store(false, std::memory_order_release);
+}
+
+void galois::substrate::traceThreadName(const char* name) {
+  if (internal::traceEnabled())
+    getRing().name = name;
+}
+
+void galois::substrate::traceProcess(unsigned id) {
+  Registry& r = registry();
+  std::lock_guard<SimpleLock> lg(r.lock);
+  r.pid            = id;
+  r.perProcessFile = true;
+}
+
+void galois::substrate::traceDump() {
+  if (!internal::traceActive.exchange(false))
+    return;
+
+  Registry& r = registry();
+  std::lock_guard<SimpleLock> lg(r.lock);
+
+  // threads outside the pool (e.g., network progress threads) may still be
+  // running; once traceActive is cleared they no longer write to their rings,
+  // so wait for the writes already in progress
+  for (auto& ring : r.rings)
+    while (ring->recording.load(std::memory_order_acquire))
+      asmPause();
+
+  std::string filename = r.file;
+  if (r.perProcessFile)
+    filename += "." + std::to_string(r.pid);
+
+  FILE* out = std::fopen(filename.c_str(), "w");
+  if (!out) {
+    gWarn("unable to write trace to ", filename);
+    return;
+  }
+
+  std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  bool first = true;
+  auto sep   = [&]() {
+    if (!first)
+      std::fprintf(out, ",\n");
+    first = false;
+  };
+
+  uint64_t dropped = 0;
+  for (size_t tid = 0; tid < r.rings.size(); ++tid) {
+    Ring& ring = *r.rings[tid];
+
+    sep();
+    std::fprintf(out,
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,"
+                 "\"tid\":%zu,\"args\":{\"name\":",
+                 r.pid, tid);
+    writeString(out, ring.name.c_str());
+    std::fprintf(out, "}}");
+
+    size_t size     = ring.events.size();
+    uint64_t oldest = ring.count > size ? ring.count - size : 0;
+    dropped += oldest;
+    for (uint64_t i = oldest; i < ring.count; ++i) {
+      const Event& e = ring.events[i % size];
+      sep();
+      std::fprintf(out, "{\"name\":");
+      writeString(out, e.name);
+      std::fprintf(out, ",\"cat\":\"%s\",\"pid\":%u,\"tid\":%zu,\"ts\":%.3f",
+                   categoryName(e.cat), r.pid, tid, e.start / 1000.0);
+      if (e.instant)
+        std::fprintf(out, ",\"ph\":\"i\",\"s\":\"t\"");
+      else
+        std::fprintf(out, ",\"ph\":\"X\",\"dur\":%.3f",
+                     (e.end - e.start) / 1000.0);
+      std::fprintf(out, ",\"args\":{\"arg\":%" PRIu64 "}}", e.arg);
+    }
+  }
+  std::fprintf(out, "\n]}\n");
+  std::fclose(out);
+
+  if (dropped)
+    gWarn("trace rings overflowed; oldest ", dropped,
+          " events were dropped (increase GALOIS_TRACE_EVENTS)");
+  gInfo("wrote trace to ", filename);
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/AdaptiveChunk.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+void checkController() {
+  galois::runtime::AdaptiveChunk chunk(32, 1, 128);
+
+  // fast full chunks grow up to the maximum
+  for (int i = 0; i < 8; ++i) {
+    chunk.begin();
+    chunk.end(true);
+  }
+  GALOIS_ASSERT(chunk.get() == 128, chunk.get());
+
+  // fast partial chunks do not grow
+  chunk.stole();
+  GALOIS_ASSERT(chunk.get() == 64, chunk.get());
+  chunk.begin();
+  chunk.end(false);
+  GALOIS_ASSERT(chunk.get() == 64, chunk.get());
+
+  // slow chunks shrink down to the minimum
+  for (int i = 0; i < 8; ++i) {
+    chunk.begin();
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        2 * galois::runtime::AdaptiveChunk::TARGET_HIGH_NS / 1000));
+    chunk.end(true);
+  }
+  GALOIS_ASSERT(chunk.get() == 1, chunk.get());
+}
+
+void checkDoAll() {
+  const size_t n = 100000;
+  std::vector<int> seen(n);
+  galois::do_all(
+      galois::iterate(size_t{0}, n),
+      [&](size_t i) {
+        // skewed work
+        volatile size_t x = 0;
+        for (size_t j = 0; j < (i % 1024 == 0 ? 1000 : 1); ++j)
+          x = x + j;
+        __sync_fetch_and_add(&seen[i], 1);
+      },
+      galois::adaptive_chunk(), galois::chunk_size<8>(),
+      galois::loopname("AdaptiveDoAll"));
+  for (size_t i = 0; i < n; ++i)
+    GALOIS_ASSERT(seen[i] == 1, "item ", i, " seen ", seen[i], " times");
+}
+
+template <typename WL>
+void checkForEach(const char* loopname) {
+  const unsigned limit = 100000;
+  std::vector<int> seen(limit);
+  std::vector<unsigned> initial{1};
+  galois::for_each(
+      galois::iterate(initial),
+      [&](unsigned x, auto& ctx) {
+        __sync_fetch_and_add(&seen[x], 1);
+        for (unsigned y : {2 * x, 2 * x + 1})
+          if (y < limit)
+            ctx.push(y);
+      },
+      galois::wl<WL>(), galois::adaptive_chunk(),
+      galois::loopname(loopname));
+  for (unsigned x = 1; x < limit; ++x)
+    GALOIS_ASSERT(seen[x] == 1, "item ", x, " seen ", seen[x], " times");
+}
+
+void checkWorklist() {
+  using WL = galois::worklists::PerSocketChunkFIFO<64, int>::
+      with_adaptive_chunk<true>;
+  WL wl;
+  GALOIS_ASSERT(wl.chunkSize() == 64);
+  for (int i = 0; i < 1000; ++i)
+    wl.push(i);
+  for (int i = 0; i < 1000; ++i) {
+    auto item = wl.pop();
+    GALOIS_ASSERT(item && *item == i);
+  }
+  GALOIS_ASSERT(!wl.pop());
+  GALOIS_ASSERT(wl.chunkSize() >= 1 && wl.chunkSize() <= 64);
+
+  // one sample per full chunk taken from the queue
+  auto& samples = wl.chunkSizeSamples();
+  GALOIS_ASSERT(samples.count == 1000 / 64, "samples ", samples.count);
+  GALOIS_ASSERT(samples.min >= 1 && samples.max <= 64);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  checkController();
+  checkDoAll();
+  checkForEach<galois::worklists::PerSocketChunkFIFO<64>>("PerSocketChunkFIFO");
+  checkForEach<galois::worklists::PerSocketChunkLIFO<64>>("PerSocketChunkLIFO");
+  checkForEach<galois::worklists::ChunkFIFO<64>>("ChunkFIFO");
+  checkForEach<galois::worklists::ChunkLIFO<64>>("ChunkLIFO");
+  checkWorklist();
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/BufferedGraph.h"
+#include "galois/graphs/FileGraph.h"
+
+#include <random>
+#include <string>
+#include <unistd.h>
+
+//! Random graph with an odd number of edges so edge data is padded
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 2000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    size_t degree = gen() % 30;
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % numNodes);
+  }
+  if (edges.size() % 2 == 0)
+    edges.emplace_back(0, 1);
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, e.second * 7 + e.first);
+  p.finish();
+  out = std::move(p);
+}
+
+template <typename EdgeTy>
+void check(galois::graphs::FileGraph& f,
+           galois::graphs::BufferedGraph<EdgeTy>& g, uint32_t nodeBegin,
+           uint32_t nodeEnd) {
+  galois::do_all(galois::iterate(nodeBegin, nodeEnd), [&](uint32_t n) {
+    GALOIS_ASSERT(*g.edgeBegin(n) == *f.edge_begin(n));
+    GALOIS_ASSERT(*g.edgeEnd(n) == *f.edge_end(n));
+    for (auto e : f.edges(n)) {
+      GALOIS_ASSERT(g.edgeDestination(*e) == f.getEdgeDst(e));
+      if constexpr (!std::is_void<EdgeTy>::value) {
+        GALOIS_ASSERT(g.edgeData(*e) == f.getEdgeData<uint32_t>(e));
+      }
+    }
+  });
+}
+
+template <typename EdgeTy>
+void testLoad(galois::graphs::FileGraph& f, const std::string& filename,
+              uint32_t nodeBegin, uint32_t nodeEnd, bool async) {
+  galois::graphs::BufferedGraph<EdgeTy> g;
+  uint64_t edgeBegin = *f.edge_begin(nodeBegin);
+  uint64_t edgeEnd   = *f.edge_begin(nodeEnd);
+  if (async) {
+    // tiny windows so readers catch up with the reader thread
+    g.loadPartialGraphAsync(filename, nodeBegin, nodeEnd, edgeBegin, edgeEnd,
+                            f.size(), f.sizeEdges(), 64);
+  } else {
+    g.loadPartialGraph(filename, nodeBegin, nodeEnd, edgeBegin, edgeEnd,
+                       f.size(), f.sizeEdges());
+  }
+  check(f, g, nodeBegin, nodeEnd);
+
+  if (async) {
+    size_t edgeSize = std::is_void<EdgeTy>::value ? 4 : 8;
+    GALOIS_ASSERT(g.getAsyncBytesRead() == (edgeEnd - edgeBegin) * edgeSize);
+  }
+  g.resetAndFree();
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+
+  char filename[] = "buffered-graph-XXXXXX";
+  int fd          = mkstemp(filename);
+  GALOIS_ASSERT(fd != -1);
+  close(fd);
+  f.toFile(filename);
+
+  uint32_t numNodes = f.size();
+  for (bool async : {false, true}) {
+    testLoad<uint32_t>(f, filename, 0, numNodes, async);
+    testLoad<uint32_t>(f, filename, numNodes / 3, 2 * numNodes / 3, async);
+    testLoad<void>(f, filename, numNodes / 2, numNodes, async);
+    testLoad<uint32_t>(f, filename, 5, 5, async);
+  }
+
+  // destroying a graph mid-load must join the reader thread
+  {
+    galois::graphs::BufferedGraph<uint32_t> g;
+    g.loadPartialGraphAsync(filename, 0, numNodes, 0, f.sizeEdges(),
+                            f.size(), f.sizeEdges(), 64);
+  }
+
+  unlink(filename);
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+typedef galois::graphs::LC_CSR_Graph<int, uint32_t>::with_no_lockable<
+    true>::type Graph;
+typedef galois::graphs::LC_Compressed_CSR_Graph<int, uint32_t>::
+    with_no_lockable<true>::type CGraph;
+typedef galois::graphs::LC_Compressed_CSR_Graph<int, void>::with_no_lockable<
+    true>::type UnweightedCGraph;
+
+//! Random graph with a hub, empty nodes and multi-edges
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 1000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    if (n % 7 == 0)
+      continue;
+    size_t degree = n == 500 ? 5000 : gen() % 20;
+    for (size_t i = 0; i < degree; ++i) {
+      // mostly local neighbors, some far away ones
+      uint32_t dst = gen() % 4 ? (n + gen() % 64) % numNodes
+                               : gen() % numNodes;
+      edges.emplace_back(n, dst);
+    }
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, e.second * 3 + e.first);
+  p.finish();
+  out = std::move(p);
+}
+
+template <typename G>
+std::vector<std::pair<uint32_t, uint32_t>> neighbors(G& g,
+                                                     typename G::GraphNode n) {
+  std::vector<std::pair<uint32_t, uint32_t>> ret;
+  for (auto e : g.edges(n))
+    ret.emplace_back(g.getEdgeDst(e), g.getEdgeData(e));
+  return ret;
+}
+
+template <typename G>
+void check(Graph& ref, G& g) {
+  GALOIS_ASSERT(g.size() == ref.size());
+  GALOIS_ASSERT(g.sizeEdges() == ref.sizeEdges());
+  GALOIS_ASSERT(g.sizeEdgeBytes() < g.sizeEdges() * sizeof(uint32_t));
+
+  for (auto n : ref) {
+    auto expected = neighbors(ref, n);
+    std::sort(expected.begin(), expected.end());
+    auto actual = neighbors(g, n);
+    GALOIS_ASSERT(std::is_sorted(actual.begin(), actual.end()));
+    GALOIS_ASSERT(expected == actual, "node ", n);
+    GALOIS_ASSERT(g.getDegree(n) == expected.size());
+
+    // random access must agree with sequential decoding
+    auto ii = g.edge_begin(n);
+    for (size_t i = 0; i < expected.size(); i += 13) {
+      GALOIS_ASSERT(g.getEdgeDst(ii + i) == expected[i].first);
+      GALOIS_ASSERT(g.getEdgeDst(std::next(ii, i)) == expected[i].first);
+    }
+    if (!expected.empty()) {
+      auto last = g.edge_end(n) - 1;
+      GALOIS_ASSERT(g.getEdgeDst(last) == expected.back().first);
+      GALOIS_ASSERT(g.findEdge(n, expected.back().first) != g.edge_end(n));
+    }
+  }
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+
+  Graph ref;
+  galois::graphs::readGraph(ref, f);
+
+  CGraph g;
+  galois::graphs::readGraph(g, f);
+  check(ref, g);
+
+  char filename[] = "compressed-graph-XXXXXX";
+  int fd          = mkstemp(filename);
+  GALOIS_ASSERT(fd != -1);
+  close(fd);
+  std::string zgr = std::string(filename) + ".zgr";
+  g.writeGraphToZGRFile(zgr);
+
+  CGraph h;
+  galois::graphs::readGraph(h, zgr);
+  check(ref, h);
+
+  UnweightedCGraph u;
+  galois::graphs::readGraph(u, zgr);
+  GALOIS_ASSERT(u.sizeEdges() == ref.sizeEdges());
+  for (auto n : ref) {
+    auto jj = h.edge_begin(n);
+    for (auto e : u.edges(n)) {
+      GALOIS_ASSERT(u.getEdgeDst(e) == h.getEdgeDst(jj));
+      ++jj;
+    }
+  }
+
+  unlink(filename);
+  unlink(zgr.c_str());
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Frontier.h"
+#include "galois/graphs/LCGraph.h"
+#include "galois/graphs/LC_CSR_CSC_Graph.h"
+
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+
+constexpr uint32_t INF = std::numeric_limits<uint32_t>::max();
+
+using BiGraph = galois::graphs::LC_CSR_CSC_Graph<uint32_t, void>;
+using Graph   = galois::graphs::LC_CSR_Graph<uint32_t, void>::with_no_lockable<
+    true>::type;
+
+//! Power-law-ish random graph so that BFS frontiers get large
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 4000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    size_t degree = n < 40 ? 400 : gen() % 6;
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % numNodes);
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<void>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor(e.first, e.second);
+  p.finish();
+  out = std::move(p);
+}
+
+std::vector<uint32_t> serialBFS(galois::graphs::FileGraph& f, uint32_t src) {
+  std::vector<uint32_t> dist(f.size(), INF);
+  std::deque<uint32_t> queue{src};
+  dist[src] = 0;
+  while (!queue.empty()) {
+    uint32_t n = queue.front();
+    queue.pop_front();
+    for (auto e : f.edges(n)) {
+      uint32_t dst = f.getEdgeDst(e);
+      if (dist[dst] == INF) {
+        dist[dst] = dist[n] + 1;
+        queue.push_back(dst);
+      }
+    }
+  }
+  return dist;
+}
+
+//! Level-synchronous BFS; returns the number of pull steps
+template <typename G>
+size_t frontierBFS(G& g, uint32_t src, galois::FrontierDirection dir) {
+  galois::do_all(galois::iterate(g), [&](uint32_t n) { g.getData(n) = INF; });
+  g.getData(src) = 0;
+
+  galois::Frontier curr(g.size()), next(g.size());
+  curr.add(src);
+  size_t numPulls = 0;
+  for (uint32_t level = 1; !curr.empty(); ++level) {
+    auto used = galois::edgeMap(
+        g, curr, next,
+        [&](uint32_t, uint32_t dst) {
+          return __sync_bool_compare_and_swap(&g.getData(dst), INF, level);
+        },
+        [&](uint32_t dst) { return g.getData(dst) == INF; }, dir);
+    if (used == galois::FrontierDirection::PULL)
+      ++numPulls;
+    curr.swap(next);
+  }
+  return numPulls;
+}
+
+template <typename G>
+void check(G& g, const std::vector<uint32_t>& expected) {
+  for (auto n : g)
+    GALOIS_ASSERT(g.getData(n) == expected[n], "node ", n);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+  auto expected = serialBFS(f, 0);
+
+  BiGraph bi;
+  galois::graphs::readGraph(bi, f);
+  bi.constructIncomingEdges();
+
+  GALOIS_ASSERT(frontierBFS(bi, 0, galois::FrontierDirection::PUSH) == 0);
+  check(bi, expected);
+  GALOIS_ASSERT(frontierBFS(bi, 0, galois::FrontierDirection::PULL) > 0);
+  check(bi, expected);
+  // the hubs make the middle levels large enough to pull
+  size_t numPulls = frontierBFS(bi, 0, galois::FrontierDirection::AUTO);
+  GALOIS_ASSERT(numPulls > 0);
+  check(bi, expected);
+
+  // without in-edges edgeMap always pushes
+  Graph g;
+  galois::graphs::readGraph(g, f);
+  GALOIS_ASSERT(frontierBFS(g, 0, galois::FrontierDirection::AUTO) == 0);
+  check(g, expected);
+
+  // conversions keep the set of nodes
+  galois::Frontier fr(100);
+  for (uint32_t i = 0; i < 100; i += 3)
+    fr.add(i);
+  fr.toDense();
+  fr.add(3);
+  GALOIS_ASSERT(fr.size() == 34);
+  fr.toSparse();
+  fr.toDense();
+  for (uint32_t i = 0; i < 100; ++i)
+    GALOIS_ASSERT(fr.contains(i) == (i % 3 == 0));
+  galois::GAccumulator<uint32_t> sum;
+  galois::vertexMap(fr, [&](uint32_t n) { sum += n; });
+  GALOIS_ASSERT(sum.reduce() == 3 * 33 * 34 / 2);
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/GatherPrefetch.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<int, void>::with_no_lockable<true>::type
+    Graph;
+typedef Graph::GraphNode GNode;
+
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const uint32_t numNodes = 1000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    // some nodes without edges, including the last one
+    size_t degree = (n % 7 == 0 || n == numNodes - 1) ? 0 : gen() % 40;
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % numNodes);
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<void>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor(e.first, e.second);
+  p.finish();
+  out = std::move(p);
+}
+
+void checkDistance(Graph& g, unsigned distance) {
+  galois::graphs::GatherPrefetch<Graph> gather(g, distance);
+
+  for (GNode n : g) {
+    std::vector<GNode> expected;
+    for (auto e : g.edges(n))
+      expected.push_back(g.getEdgeDst(e));
+
+    std::vector<GNode> actual;
+    bool full = gather.edges(
+        n, [&](GNode dst) { return &g.getData(dst); },
+        [&](GNode dst) { actual.push_back(dst); });
+    GALOIS_ASSERT(full && actual == expected, "node ", n, " distance ",
+                  distance);
+
+    // stop at the first even destination
+    actual.clear();
+    full = gather.edges(
+        n, [&](GNode dst) { return &g.getData(dst); },
+        [&](GNode dst) {
+          actual.push_back(dst);
+          return dst % 2 != 0;
+        });
+    size_t stop = 0;
+    while (stop < expected.size() && expected[stop] % 2 != 0)
+      ++stop;
+    GALOIS_ASSERT(full == (stop == expected.size()), "node ", n);
+    expected.resize(std::min(stop + 1, expected.size()));
+    GALOIS_ASSERT(actual == expected, "node ", n, " distance ", distance);
+  }
+}
+
+int main() {
+  galois::SharedMemSys G;
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+  Graph g;
+  galois::graphs::readGraph(g, f);
+
+  for (unsigned distance : {0, 1, 16, 1000000})
+    checkDistance(g, distance);
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/GraphCache.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using galois::graphs::FileGraph;
+using galois::graphs::GraphTransform;
+
+//! Random graph with self loops and unsorted edges
+void makeFileGraph(FileGraph& out, unsigned seed) {
+  const size_t numNodes = 500;
+  std::mt19937 gen(seed);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    size_t degree = gen() % (n % 10 == 0 ? 60 : 10);
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % 8 == 0 ? n : gen() % numNodes);
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, e.first + e.second);
+  p.finish();
+  out = std::move(p);
+}
+
+std::set<std::pair<uint64_t, uint64_t>> edgeSet(FileGraph& g) {
+  std::set<std::pair<uint64_t, uint64_t>> ret;
+  for (auto n : g)
+    for (auto e : g.edges(n))
+      ret.emplace(n, g.getEdgeDst(e));
+  return ret;
+}
+
+void checkSymmetricSorted(FileGraph& g, FileGraph& orig) {
+  auto edges = edgeSet(g);
+  for (auto n : g) {
+    uint64_t prev = 0;
+    for (auto e : g.edges(n)) {
+      uint64_t dst = g.getEdgeDst(e);
+      GALOIS_ASSERT(dst != n);
+      GALOIS_ASSERT(dst >= prev);
+      GALOIS_ASSERT(edges.count(std::make_pair(dst, n)));
+      GALOIS_ASSERT(g.getEdgeData<uint32_t>(e) == dst + n);
+      prev = dst;
+    }
+  }
+  for (auto& e : edgeSet(orig))
+    GALOIS_ASSERT(e.first == e.second || edges.count(e));
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  char filename[] = "graph-cache-XXXXXX";
+  int fd          = mkstemp(filename);
+  GALOIS_ASSERT(fd != -1);
+  close(fd);
+
+  FileGraph orig;
+  makeFileGraph(orig, 1);
+  orig.toFile(filename);
+
+  std::vector<GraphTransform> pipeline = {GraphTransform::REMOVE_SELF_LOOPS,
+                                          GraphTransform::SYMMETRIZE,
+                                          GraphTransform::SORT_BY_DST};
+  std::string cachePath =
+      galois::graphs::internal::graphCachePath(filename, pipeline);
+
+  // first run builds the cache, second run maps it
+  FileGraph g;
+  GALOIS_ASSERT(!galois::graphs::readCachedGraph<uint32_t>(g, filename,
+                                                           pipeline));
+  checkSymmetricSorted(g, orig);
+  FileGraph h;
+  GALOIS_ASSERT(galois::graphs::readCachedGraph<uint32_t>(h, filename,
+                                                          pipeline));
+  checkSymmetricSorted(h, orig);
+  GALOIS_ASSERT(edgeSet(g) == edgeSet(h));
+
+  // a different edge type or pipeline does not reuse the cache
+  FileGraph v;
+  GALOIS_ASSERT(
+      !galois::graphs::readCachedGraph<void>(v, filename, pipeline));
+  GALOIS_ASSERT(edgeSet(v) == edgeSet(g));
+
+  // rewriting the input invalidates the cache
+  FileGraph changed;
+  makeFileGraph(changed, 2);
+  changed.toFile(filename);
+  GALOIS_ASSERT(!galois::graphs::readCachedGraph<uint32_t>(g, filename,
+                                                           pipeline));
+  checkSymmetricSorted(g, changed);
+
+  // nothing to cache without transforms
+  FileGraph plain;
+  GALOIS_ASSERT(!galois::graphs::readCachedGraph<uint32_t>(plain, filename,
+                                                           {}));
+  GALOIS_ASSERT(edgeSet(plain) == edgeSet(changed));
+
+  // relabeling orders nodes by decreasing degree; transpose reverses edges
+  std::vector<GraphTransform> relabel = {GraphTransform::DEGREE_RELABEL,
+                                         GraphTransform::TRANSPOSE};
+  FileGraph r;
+  galois::graphs::readCachedGraph<uint32_t>(r, filename, relabel);
+  GALOIS_ASSERT(r.sizeEdges() == changed.sizeEdges());
+  FileGraph rt;
+  galois::graphs::transpose<uint32_t>(r, rt);
+  for (size_t n = 1; n < rt.size(); ++n)
+    GALOIS_ASSERT(std::distance(rt.edge_begin(n - 1), rt.edge_end(n - 1)) >=
+                  std::distance(rt.edge_begin(n), rt.edge_end(n)));
+  std::string relabelPath =
+      galois::graphs::internal::graphCachePath(filename, relabel);
+
+  // a cache that cannot be written only warns; a directory in place of the
+  // temporary file makes the write fail
+  std::string failPath = cachePath + ".fail";
+  std::string failTmp  = failPath + ".tmp" + std::to_string(getpid());
+  GALOIS_ASSERT(mkdir(failTmp.c_str(), 0700) == 0);
+  galois::graphs::internal::graphCacheStore(g, failPath, "key");
+  GALOIS_ASSERT(!galois::graphs::internal::graphCacheValid(failPath, "key"));
+  rmdir(failTmp.c_str());
+
+  unlink(filename);
+  unlink(cachePath.c_str());
+  unlink((cachePath + ".key").c_str());
+  unlink(relabelPath.c_str());
+  unlink((relabelPath + ".key").c_str());
+
+  return 0;
+}
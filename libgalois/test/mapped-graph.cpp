@@ -0,0 +1,123 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+typedef galois::graphs::LC_CSR_Graph<int, uint32_t>::with_no_lockable<
+    true>::type Graph;
+typedef galois::graphs::LC_Mapped_CSR_Graph<int, uint32_t>::with_no_lockable<
+    true>::type MGraph;
+typedef galois::graphs::LC_Mapped_CSR_Graph<int, uint32_t>::with_numa_alloc<
+    true>::type NumaMGraph;
+typedef galois::graphs::LC_Mapped_CSR_Graph<int, void> UnweightedMGraph;
+
+//! Random graph with sorted neighbors and some empty nodes
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 1000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    if (n % 7 == 0)
+      continue;
+    size_t degree = gen() % 20;
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % numNodes);
+  }
+  std::sort(edges.begin(), edges.end());
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, e.second * 3 + e.first);
+  p.finish();
+  out = std::move(p);
+}
+
+template <typename G>
+void check(Graph& ref, G& g, bool weighted) {
+  GALOIS_ASSERT(g.size() == ref.size());
+  GALOIS_ASSERT(g.sizeEdges() == ref.sizeEdges());
+
+  galois::do_all(galois::iterate(ref), [&](auto n) {
+    g.getData(n) = n;
+    GALOIS_ASSERT(g.getDegree(n) == (uint64_t)std::distance(
+                                        ref.edge_begin(n), ref.edge_end(n)));
+    auto jj = ref.edge_begin(n);
+    for (auto e : g.edges(n)) {
+      GALOIS_ASSERT(g.getEdgeDst(e) == ref.getEdgeDst(jj));
+      if (weighted)
+        GALOIS_ASSERT(g.getEdgeData(e) == ref.getEdgeData(jj));
+      else
+        GALOIS_ASSERT(g.getEdgeData(e) == 0);
+      GALOIS_ASSERT(g.findEdgeSortedByDst(n, g.getEdgeDst(e)) != g.edge_end(n));
+      ++jj;
+    }
+  });
+  for (auto n : g)
+    GALOIS_ASSERT(g.getData(n) == (int)n);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+
+  Graph ref;
+  galois::graphs::readGraph(ref, f);
+
+  // aliasing an in-memory FileGraph
+  MGraph m;
+  galois::graphs::readGraph(m, f);
+  check(ref, m, true);
+
+  char filename[] = "mapped-graph-XXXXXX";
+  int fd          = mkstemp(filename);
+  GALOIS_ASSERT(fd != -1);
+  close(fd);
+  f.toFile(filename);
+
+  NumaMGraph g;
+  galois::graphs::readGraph(g, filename);
+  check(ref, g, true);
+
+  MGraph u;
+  galois::graphs::readGraph(u, filename, true);
+  check(ref, u, false);
+
+  UnweightedMGraph v;
+  galois::graphs::readGraph(v, filename);
+  GALOIS_ASSERT(v.sizeEdges() == ref.sizeEdges());
+
+  unlink(filename);
+
+  return 0;
+}
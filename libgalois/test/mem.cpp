@@ -20,6 +20,7 @@
 #include "galois/Galois.h"
 #include "galois/gIO.h"
 #include "galois/runtime/Mem.h"
+#include "galois/LargeArray.h"
 
 using namespace galois::runtime;
 using namespace galois::substrate;
@@ -68,5 +69,46 @@ int main() {
     GALOIS_ASSERT(allocated);
   }
 
+  // large allocations account for the pages they get under each policy
+  size_t before = numLargeAllocBytes(PageKind::SMALL);
+  galois::LargeArray<unsigned> small;
+  small.allocateBlocked(1 << 20, PagePolicy::SMALL);
+  GALOIS_ASSERT(numLargeAllocBytes(PageKind::SMALL) - before >=
+                small.size() * sizeof(unsigned));
+  before           = numLargeAllocBytes(PageKind::SMALL);
+  size_t thpBefore = numLargeAllocBytes(PageKind::THP);
+  galois::LargeArray<unsigned> thp;
+  thp.allocateInterleaved(1 << 20, PagePolicy::THP);
+  if (numLargeAllocBytes(PageKind::THP) != thpBefore) {
+    // THP regions are aligned so the kernel can actually use huge pages
+    GALOIS_ASSERT(reinterpret_cast<uintptr_t>(thp.data()) % allocSize() == 0);
+  } else {
+    // no THP support: falls back to small pages
+    GALOIS_ASSERT(numLargeAllocBytes(PageKind::SMALL) != before);
+  }
+  for (size_t i = 0; i < small.size(); ++i) {
+    small[i] = i;
+    thp[i]   = i;
+  }
+  GALOIS_ASSERT(small[small.size() - 1] == thp[thp.size() - 1]);
+
+  // DEFAULT restores the policy chosen by the environment
+  PagePolicy initial = getPagePolicy();
+  setPagePolicy(PagePolicy::SMALL);
+  GALOIS_ASSERT(getPagePolicy() == PagePolicy::SMALL);
+  setPagePolicy(PagePolicy::DEFAULT);
+  GALOIS_ASSERT(getPagePolicy() == initial);
+
+  // whichever kind of pages backs an allocation, it counts its length once
+  size_t total = 0;
+  for (PageKind k : {PageKind::HUGETLB, PageKind::THP, PageKind::SMALL})
+    total += numPageAllocBytes(k);
+  void* pages  = allocPages(3, false, PagePolicy::HUGETLB_1G);
+  size_t after = 0;
+  for (PageKind k : {PageKind::HUGETLB, PageKind::THP, PageKind::SMALL})
+    after += numPageAllocBytes(k);
+  GALOIS_ASSERT(after - total == 3 * allocSize());
+  freePages(pages, 3);
+
   return 0;
 }
@@ -0,0 +1,88 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/runtime/Range.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+struct Indexer {
+  unsigned operator()(unsigned x) const { return x / 4; }
+};
+
+namespace gwl = galois::worklists;
+using MQ      = gwl::MultiQueue<Indexer>::retype<unsigned>;
+
+//! With a single heap and no batching, pops follow the exact priority order
+void checkOrder() {
+  using Exact = MQ::with_queues_per_thread<1>::type::with_batch_size<1>::type;
+  galois::setActiveThreads(1);
+  Exact wl;
+
+  std::vector<unsigned> items(1000);
+  std::iota(items.begin(), items.end(), 0);
+  std::shuffle(items.begin(), items.end(), std::mt19937(7));
+  wl.push_initial(galois::runtime::makeStandardRange(items.begin(),
+                                                     items.end()));
+
+  unsigned last = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    auto item = wl.pop();
+    GALOIS_ASSERT(item, "missing item ", i);
+    GALOIS_ASSERT(Indexer()(*item) >= last, "out of order at ", i);
+    last = Indexer()(*item);
+  }
+  GALOIS_ASSERT(!wl.pop());
+}
+
+//! Every pushed item is processed exactly once, including buffered pushes
+void checkForEach() {
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  const unsigned limit = 100000;
+  std::vector<unsigned> seen(limit);
+  galois::GAccumulator<size_t> count;
+
+  std::vector<unsigned> initial{1};
+  galois::for_each(
+      galois::iterate(initial),
+      [&](unsigned x, auto& ctx) {
+        __sync_fetch_and_add(&seen[x], 1);
+        count += 1;
+        for (unsigned y : {2 * x, 2 * x + 1})
+          if (y < limit)
+            ctx.push(y);
+      },
+      galois::wl<MQ>(Indexer()), galois::loopname("MultiQueue"));
+
+  GALOIS_ASSERT(count.reduce() == limit - 1);
+  for (unsigned x = 1; x < limit; ++x)
+    GALOIS_ASSERT(seen[x] == 1, "item ", x, " seen ", seen[x], " times");
+}
+
+int main() {
+  galois::SharedMemSys G;
+  checkOrder();
+  checkForEach();
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/runtime/PerfCounters.h"
+
+#include <vector>
+
+using namespace galois::runtime;
+
+// Counters may legitimately be unavailable (no PMU, perf_event_paranoid > 2),
+// so only check consistency when they can be read.
+void checkRead() {
+  unsigned mask            = perfCountersAvailable();
+  PerfCounterSample before = {};
+  PerfCounterSample after  = {};
+
+  GALOIS_ASSERT(perfCountersRead(before) == (mask != 0));
+
+  volatile uint64_t x = 0;
+  for (uint64_t i = 0; i < 1000000; ++i)
+    x = x + i;
+
+  GALOIS_ASSERT(perfCountersRead(after) == (mask != 0));
+
+  if (mask) {
+    GALOIS_ASSERT(after.enabled >= after.running);
+    GALOIS_ASSERT(after.enabled >= before.enabled);
+  }
+  for (unsigned i = 0; i < NUM_PERF_COUNTERS; ++i) {
+    if (mask & (1u << i))
+      GALOIS_ASSERT(after.vals[i] >= before.vals[i], perfCounterNames[i]);
+  }
+  if (mask & (1u << PERF_INSTRUCTIONS))
+    GALOIS_ASSERT(perfCounterDelta(before, after, PERF_INSTRUCTIONS) >=
+                  1000000);
+}
+
+//! Counts of multiplexed counters are scaled by the time they ran
+void checkScaling() {
+  PerfCounterSample start = {};
+  PerfCounterSample end   = {};
+  start.vals[PERF_CYCLES] = 100;
+  start.enabled           = 1000;
+  start.running           = 1000;
+  end.vals[PERF_CYCLES]   = 400;
+  end.enabled             = 1600;
+  end.running             = 1200;
+  GALOIS_ASSERT(perfCounterDelta(start, end, PERF_CYCLES) == 900);
+
+  end.running = 1600;
+  GALOIS_ASSERT(perfCounterDelta(start, end, PERF_CYCLES) == 300);
+
+  end.running = 1000;
+  GALOIS_ASSERT(perfCounterDelta(start, end, PERF_CYCLES) == 0);
+}
+
+void checkLoops() {
+  const size_t n = 100000;
+  std::vector<size_t> v(n);
+
+  galois::do_all(
+      galois::iterate(size_t{0}, n), [&](size_t i) { v[i] = i; },
+      galois::steal(), galois::loopname("PerfDoAll"));
+
+  std::vector<unsigned> initial{1};
+  galois::for_each(
+      galois::iterate(initial),
+      [&](unsigned x, auto& ctx) {
+        v[x] += 1;
+        for (unsigned y : {2 * x, 2 * x + 1})
+          if (y < n)
+            ctx.push(y);
+      },
+      galois::loopname("PerfForEach"));
+
+  for (size_t i = 1; i < n; ++i)
+    GALOIS_ASSERT(v[i] == i + 1, i);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  checkRead();
+  checkScaling();
+  checkLoops();
+
+  return 0;
+}
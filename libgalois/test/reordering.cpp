@@ -0,0 +1,133 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+#include "galois/graphs/Reordering.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<uint32_t, uint32_t>::with_no_lockable<
+    true>::type Graph;
+
+using galois::graphs::ReorderAlgo;
+
+//! Random graph with hubs, several components and multi-edges
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 3000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < numNodes; ++n) {
+    size_t degree = n % 100 == 0 ? 300 : gen() % 8;
+    for (size_t i = 0; i < degree; ++i) {
+      // two halves that are not connected to each other
+      uint32_t half = n < numNodes / 2 ? 0 : numNodes / 2;
+      edges.emplace_back(n, half + gen() % (numNodes / 2));
+    }
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, e.first * 5 + e.second);
+  p.finish();
+  out = std::move(p);
+}
+
+size_t degree(Graph& g, uint32_t n) {
+  return std::distance(g.edge_begin(n), g.edge_end(n));
+}
+
+void check(Graph& ref, Graph& g, const std::vector<uint32_t>& oldToNew) {
+  GALOIS_ASSERT(g.size() == ref.size());
+  GALOIS_ASSERT(g.sizeEdges() == ref.sizeEdges());
+
+  std::vector<bool> seen(ref.size());
+  for (uint32_t n : oldToNew) {
+    GALOIS_ASSERT(n < ref.size() && !seen[n]);
+    seen[n] = true;
+  }
+
+  for (auto n : ref) {
+    uint32_t m = oldToNew[n];
+
+    std::vector<std::pair<uint32_t, uint32_t>> expected, actual;
+    for (auto e : ref.edges(n))
+      expected.emplace_back(oldToNew[ref.getEdgeDst(e)], ref.getEdgeData(e));
+    for (auto e : g.edges(m))
+      actual.emplace_back(g.getEdgeDst(e), g.getEdgeData(e));
+    GALOIS_ASSERT(std::is_sorted(actual.begin(), actual.end(),
+                                 [](auto& a, auto& b) {
+                                   return a.first < b.first;
+                                 }));
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    GALOIS_ASSERT(expected == actual, "node ", n);
+  }
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+
+  Graph ref;
+  galois::graphs::readGraph(ref, f);
+
+  for (ReorderAlgo algo :
+       {ReorderAlgo::NONE, ReorderAlgo::DEGREE_SORT, ReorderAlgo::HUB_SORT,
+        ReorderAlgo::HUB_CLUSTER, ReorderAlgo::RCM, ReorderAlgo::GORDER}) {
+    Graph g;
+    galois::graphs::readGraph(g, f);
+
+    auto oldToNew = galois::graphs::reorderGraph(g, algo);
+    check(ref, g, oldToNew);
+
+    if (algo == ReorderAlgo::DEGREE_SORT) {
+      for (uint32_t n = 1; n < g.size(); ++n)
+        GALOIS_ASSERT(degree(g, n - 1) >= degree(g, n));
+    }
+    if (algo == ReorderAlgo::HUB_CLUSTER) {
+      // hubs come first, and both groups keep their relative order
+      size_t avgDegree = ref.sizeEdges() / ref.size();
+      uint32_t numHubs = 0;
+      for (auto n : ref)
+        numHubs += degree(ref, n) > avgDegree;
+      uint32_t nextHub = 0, nextOther = numHubs;
+      for (auto n : ref) {
+        if (degree(ref, n) > avgDegree)
+          GALOIS_ASSERT(oldToNew[n] == nextHub++);
+        else
+          GALOIS_ASSERT(oldToNew[n] == nextOther++);
+      }
+    }
+  }
+
+  return 0;
+}
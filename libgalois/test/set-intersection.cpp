@@ -0,0 +1,89 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/SetIntersection.h"
+#include "galois/gIO.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+std::vector<uint32_t> randomSet(std::mt19937& gen, size_t size,
+                                uint32_t universe) {
+  std::vector<uint32_t> ret;
+  for (size_t i = 0; i < size; ++i)
+    ret.push_back(gen() % universe);
+  std::sort(ret.begin(), ret.end());
+  ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+  return ret;
+}
+
+void check(galois::IntersectKernel kernel, const std::vector<uint32_t>& lhs,
+           const std::vector<uint32_t>& rhs) {
+  std::vector<uint32_t> expected;
+  std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                        std::back_inserter(expected));
+
+  size_t count = galois::intersectCount(kernel, lhs.data(), lhs.size(),
+                                        rhs.data(), rhs.size());
+  GALOIS_ASSERT(count == expected.size(), galois::intersectKernelName(kernel),
+                " ", lhs.size(), " ", rhs.size());
+
+  std::vector<uint32_t> out(std::min(lhs.size(), rhs.size()));
+  size_t n = galois::intersect(kernel, lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size(), out.data());
+  out.resize(n);
+  GALOIS_ASSERT(out == expected, galois::intersectKernelName(kernel));
+}
+
+int main() {
+  std::mt19937 gen(12345);
+  std::vector<size_t> sizes{0, 1, 7, 8, 9, 15, 16, 17, 33, 100, 1000, 5000};
+
+  for (auto kernel :
+       {galois::IntersectKernel::SCALAR, galois::IntersectKernel::AVX2,
+        galois::IntersectKernel::AVX512}) {
+    if (!galois::intersectKernelSupported(kernel))
+      continue;
+    for (size_t na : sizes) {
+      for (size_t nb : sizes) {
+        // dense and sparse overlaps, including skewed pairs that gallop
+        for (uint32_t universe : {64u, 1024u, 100000u}) {
+          check(kernel, randomSet(gen, na, universe),
+                randomSet(gen, nb, universe));
+        }
+      }
+    }
+
+    // identical lists and disjoint interleaved lists
+    std::vector<uint32_t> a, b;
+    for (uint32_t i = 0; i < 1000; ++i) {
+      a.push_back(2 * i);
+      b.push_back(2 * i + 1);
+    }
+    check(kernel, a, a);
+    check(kernel, a, b);
+    // extreme values
+    check(kernel, {0, 1, 0xFFFFFFFE, 0xFFFFFFFF}, {0, 0xFFFFFFFF});
+  }
+
+  GALOIS_ASSERT(galois::intersectKernelSupported(galois::intersectKernel()));
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/graphs/LCGraph.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+typedef galois::graphs::LC_CSR_Graph<int, uint32_t>::with_no_lockable<
+    true>::type Graph;
+
+//! Random graph with one hub large enough to be sorted by all threads
+void makeFileGraph(galois::graphs::FileGraph& out) {
+  const size_t numNodes = 1000000;
+  std::mt19937 gen(12345);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < 1000; ++n) {
+    size_t degree = n == 7 ? 300000 : gen() % 50;
+    for (size_t i = 0; i < degree; ++i)
+      edges.emplace_back(n, gen() % numNodes);
+  }
+
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<uint32_t>(edges.size());
+  p.phase1();
+  for (auto& e : edges)
+    p.incrementDegree(e.first);
+  p.phase2();
+  for (auto& e : edges)
+    p.addNeighbor<uint32_t>(e.first, e.second, gen() % 1000);
+  p.finish();
+  out = std::move(p);
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> neighbors(Graph& g,
+                                                     Graph::GraphNode n) {
+  std::vector<std::pair<uint32_t, uint32_t>> ret;
+  for (auto e : g.edges(n))
+    ret.emplace_back(g.getEdgeDst(e), g.getEdgeData(e));
+  return ret;
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  galois::graphs::FileGraph f;
+  makeFileGraph(f);
+
+  Graph g;
+  galois::graphs::readGraph(g, f);
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> before;
+  for (uint32_t n = 0; n < 1000; ++n)
+    before.push_back(neighbors(g, n));
+
+  // radix sort is stable, so equal destinations keep their file order
+  g.sortAllEdgesByDst();
+  for (uint32_t n = 0; n < 1000; ++n) {
+    auto expected = before[n];
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.first < b.first;
+                     });
+    auto actual = neighbors(g, n);
+    if (n == 7)
+      GALOIS_ASSERT(expected == actual);
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    GALOIS_ASSERT(expected == actual, "node ", n);
+    GALOIS_ASSERT(std::is_sorted(g.edge_begin(n), g.edge_end(n),
+                                 [&](auto a, auto b) {
+                                   return g.getEdgeDst(a) < g.getEdgeDst(b);
+                                 }));
+  }
+
+  // descending by edge data
+  typedef galois::graphs::EdgeSortValue<Graph::GraphNode, uint32_t> EdgeSortVal;
+  g.sortAllEdges([](const EdgeSortVal& a, const EdgeSortVal& b) {
+    return a.get() > b.get();
+  });
+  for (uint32_t n = 0; n < 1000; ++n) {
+    auto expected = before[n];
+    std::sort(expected.begin(), expected.end());
+    auto actual = neighbors(g, n);
+    GALOIS_ASSERT(std::is_sorted(actual.begin(), actual.end(),
+                                 [](const auto& a, const auto& b) {
+                                   return a.second > b.second;
+                                 }));
+    std::sort(actual.begin(), actual.end());
+    GALOIS_ASSERT(expected == actual, "node ", n);
+  }
+
+  return 0;
+}
@@ -24,6 +24,8 @@
 #include <iostream>
 #include <cstdlib>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 int RandomNumber() { return (rand() % 1000000); }
 bool IsOdd(int i) { return ((i % 2) == 1); }
@@ -160,6 +162,102 @@ int do_accumulate() {
   return 0;
 }
 
+int do_sample_sort() {
+
+  unsigned M = galois::substrate::getThreadPool().getMaxThreads();
+  std::cout << "sample_sort:\n";
+
+  while (M) {
+    galois::setActiveThreads(M);
+    std::cout << "Using " << M << " threads\n";
+
+    std::vector<unsigned> V(vectorSize);
+    std::generate(V.begin(), V.end(), RandomNumber);
+    std::vector<unsigned> C = V;
+
+    galois::Timer t;
+    t.start();
+    galois::ParallelSTL::sample_sort(V.begin(), V.end());
+    t.stop();
+
+    galois::Timer t2;
+    t2.start();
+    std::sort(C.begin(), C.end());
+    t2.stop();
+
+    bool eq = V == C;
+    std::cout << "Galois: " << t.get() << " STL: " << t2.get()
+              << " Equal: " << eq << "\n";
+    if (!eq)
+      return 1;
+
+    // many duplicates and a descending comparator
+    std::vector<unsigned> D(vectorSize);
+    for (auto& x : D)
+      x = RandomNumber() % 8;
+    std::vector<unsigned> E = D;
+    galois::ParallelSTL::sample_sort(D.begin(), D.end(),
+                                     std::greater<unsigned>());
+    std::sort(E.begin(), E.end(), std::greater<unsigned>());
+    if (D != E)
+      return 1;
+
+    M >>= 1;
+  }
+
+  return 0;
+}
+
+int do_radix_sort() {
+
+  unsigned M = galois::substrate::getThreadPool().getMaxThreads();
+  std::cout << "radix_sort:\n";
+
+  while (M) {
+    galois::setActiveThreads(M);
+    std::cout << "Using " << M << " threads\n";
+
+    std::vector<uint64_t> V(vectorSize);
+    for (auto& x : V)
+      x = (uint64_t(rand()) << 32) ^ rand();
+    std::vector<uint64_t> C = V;
+
+    galois::Timer t;
+    t.start();
+    galois::ParallelSTL::radix_sort(V.begin(), V.end());
+    t.stop();
+
+    galois::Timer t2;
+    t2.start();
+    std::sort(C.begin(), C.end());
+    t2.stop();
+
+    bool eq = V == C;
+    std::cout << "Galois: " << t.get() << " STL: " << t2.get()
+              << " Equal: " << eq << "\n";
+    if (!eq)
+      return 1;
+
+    // sorting by key only must be stable
+    std::vector<std::pair<uint32_t, uint32_t>> P(vectorSize);
+    for (size_t i = 0; i < P.size(); ++i)
+      P[i] = std::make_pair(RandomNumber() % 1000, i);
+    std::vector<std::pair<uint32_t, uint32_t>> Q = P;
+    galois::ParallelSTL::radix_sort(
+        P.begin(), P.end(),
+        [](const std::pair<uint32_t, uint32_t>& p) { return p.first; });
+    std::stable_sort(Q.begin(), Q.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    if (P != Q)
+      return 1;
+
+    M >>= 1;
+  }
+
+  return 0;
+}
+
 int main(int argc, char** argv) {
   galois::SharedMemSys Galois_runtime;
   if (argc > 1)
@@ -171,5 +269,7 @@ int main(int argc, char** argv) {
   //  ret |= do_sort();
   //  ret |= do_count_if();
   ret |= do_accumulate();
+  ret |= do_sample_sort();
+  ret |= do_radix_sort();
   return ret;
 }
@@ -0,0 +1,120 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+unsigned numThreads;
+
+std::vector<std::string> runAndRead(const std::string& file,
+                                    const std::string& inputRegion = "(NULL)",
+                                    bool nonFinite                 = false) {
+  {
+    galois::SharedMemSys G;
+    numThreads = galois::setActiveThreads(2);
+    galois::runtime::setStatFile(file);
+    galois::runtime::reportParam(inputRegion, "Input", "in,put.gr");
+    galois::on_each([](unsigned tid, unsigned) {
+      galois::runtime::reportStat_Tsum("Loop", "Iterations", tid + 1);
+    });
+    galois::runtime::reportStat_Single("Loop", "Ratio", 0.5);
+    if (nonFinite) {
+      galois::runtime::reportStat_Single("Loop", "NaN", std::nan(""));
+      galois::runtime::reportStat_Single("Loop", "Inf", HUGE_VAL);
+    }
+  }
+
+  std::ifstream in(file);
+  GALOIS_ASSERT(in.good(), "missing ", file);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(in, line);)
+    lines.push_back(line);
+  return lines;
+}
+
+//! total, min, max and mean of Iterations: thread i reports i + 1
+std::vector<std::string> expectedIterations() {
+  std::ostringstream mean;
+  mean << (numThreads + 1) / 2.0;
+  return {std::to_string(numThreads * (numThreads + 1) / 2), "1",
+          std::to_string(numThreads), mean.str()};
+}
+
+bool contains(const std::vector<std::string>& lines, const std::string& s) {
+  for (const auto& l : lines)
+    if (l.find(s) != std::string::npos)
+      return true;
+  return false;
+}
+
+void checkCSV() {
+  auto lines = runAndRead("stats.csv");
+  GALOIS_ASSERT(lines.size() == 4, lines.size());
+  GALOIS_ASSERT(lines[0].find("schema,uuid,hostname,threads") == 0, lines[0]);
+  auto e = expectedIterations();
+  GALOIS_ASSERT(contains(lines, ",STAT,total,,Loop,Iterations,TSUM," + e[0] +
+                                    "," + e[1] + "," + e[2] + "," + e[3] +
+                                    ","),
+                "no Iterations row");
+  GALOIS_ASSERT(contains(lines, "\"in,put.gr\""), "input not quoted");
+}
+
+void checkJSON() {
+  auto lines = runAndRead("stats.json");
+  GALOIS_ASSERT(lines.size() == 4, lines.size());
+  GALOIS_ASSERT(lines[0].find("{\"schema\":1,\"record\":\"run\"") == 0,
+                lines[0]);
+  GALOIS_ASSERT(contains(lines, "\"input\":\"in,put.gr\""), "no input");
+  auto e = expectedIterations();
+  GALOIS_ASSERT(contains(lines, "\"category\":\"Iterations\",\"total_type\":"
+                                "\"TSUM\",\"total\":" +
+                                    e[0] + ",\"min\":" + e[1] +
+                                    ",\"max\":" + e[2] + ",\"mean\":" + e[3] +
+                                    ",\"values\":["),
+                "no Iterations record");
+  GALOIS_ASSERT(contains(lines, "\"kind\":\"PARAM\""), "no param record");
+}
+
+//! Distributed benches report the input under DistBench; values JSON cannot
+//! represent are null
+void checkDistJSON() {
+  auto lines = runAndRead("dist.json", "DistBench", true);
+  GALOIS_ASSERT(contains(lines, "\"input\":\"in,put.gr\""), "no input");
+  GALOIS_ASSERT(contains(lines, "\"category\":\"NaN\",\"total_type\":"
+                                "\"SINGLE\",\"total\":null"),
+                "NaN not null");
+  GALOIS_ASSERT(contains(lines, "\"category\":\"Inf\",\"total_type\":"
+                                "\"SINGLE\",\"total\":null"),
+                "Inf not null");
+  GALOIS_ASSERT(contains(lines, "\"category\":\"Ratio\",\"total_type\":"
+                                "\"SINGLE\",\"total\":0.5"),
+                "no Ratio record");
+}
+
+int main() {
+  checkCSV();
+  checkJSON();
+  checkDistJSON();
+  return 0;
+}
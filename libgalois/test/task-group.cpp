@@ -0,0 +1,162 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+#include "galois/TaskGroup.h"
+#include "galois/gIO.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+void testDependencies() {
+  // diamond: a -> {b, c} -> d
+  std::atomic<int> step{0};
+  galois::TaskGroup tg;
+  auto ta = tg.spawn([&] { return step++; });
+  auto tb = tg.spawn(
+      [&] {
+        GALOIS_ASSERT(ta.isDone());
+        return ta.get() + 1;
+      },
+      ta);
+  auto tc = tg.spawn(
+      [&] {
+        GALOIS_ASSERT(ta.isDone());
+        ++step;
+      },
+      ta);
+  auto td = tg.spawn(
+      [&] {
+        GALOIS_ASSERT(tb.isDone() && tc.isDone());
+        return tb.get() + step.load();
+      },
+      tb, tc);
+  tg.wait();
+  GALOIS_ASSERT(td.isDone() && td.get() == 3);
+
+  // waiting again without new tasks does nothing
+  tg.wait();
+}
+
+void testChain(unsigned length) {
+  std::vector<unsigned> order;
+  galois::TaskGroup tg;
+  galois::TaskHandle<void> prev;
+  for (unsigned i = 0; i < length; ++i) {
+    if (i == 0)
+      prev = tg.spawn([&, i] { order.push_back(i); });
+    else
+      prev = tg.spawn([&, i] { order.push_back(i); }, prev);
+  }
+  tg.wait();
+
+  std::vector<unsigned> expected(length);
+  std::iota(expected.begin(), expected.end(), 0);
+  GALOIS_ASSERT(order == expected);
+}
+
+void testNestedLoops() {
+  const size_t n = 10000;
+  galois::GAccumulator<size_t> sum1;
+  galois::GAccumulator<size_t> sum2;
+  galois::GAccumulator<size_t> each;
+
+  galois::TaskGroup tg;
+  tg.spawn([&] {
+    galois::do_all(galois::iterate(size_t{0}, n),
+                   [&](size_t i) { sum1 += i; });
+  });
+  tg.spawn([&] {
+    galois::do_all(galois::iterate(size_t{0}, n), [&](size_t i) {
+      galois::do_all(galois::iterate(size_t{0}, i % 3),
+                     [&](size_t) { sum2 += 1; });
+    });
+  });
+  tg.spawn([&] {
+    galois::on_each([&](unsigned tid, unsigned nthreads) {
+      GALOIS_ASSERT(tid == 0 && nthreads == 1);
+      each += 1;
+    });
+  });
+  tg.wait();
+
+  GALOIS_ASSERT(sum1.reduce() == n * (n - 1) / 2);
+  size_t expected2 = 0;
+  for (size_t i = 0; i < n; ++i)
+    expected2 += i % 3;
+  GALOIS_ASSERT(sum2.reduce() == expected2);
+  GALOIS_ASSERT(each.reduce() == 1);
+
+  // loops outside of tasks run on the thread pool again
+  galois::GAccumulator<size_t> sum3;
+  galois::do_all(galois::iterate(size_t{0}, n), [&](size_t i) { sum3 += i; });
+  GALOIS_ASSERT(sum3.reduce() == n * (n - 1) / 2);
+}
+
+void testAllocation() {
+  // outside of tasks, allocation pages in memory with a pool run of its own
+  const size_t n = 1 << 20;
+  galois::LargeArray<size_t> arr;
+  galois::TaskGroup tg;
+  auto fill = tg.spawn([&] {
+    arr.allocateBlocked(n);
+    galois::do_all(galois::iterate(size_t{0}, n),
+                   [&](size_t i) { arr[i] = i; });
+  });
+  tg.spawn(
+      [&] {
+        for (size_t i = 0; i < n; ++i)
+          GALOIS_ASSERT(arr[i] == i);
+      },
+      fill);
+  tg.wait();
+}
+
+void testNestedGroups() {
+  std::atomic<unsigned> count{0};
+  galois::TaskGroup outer;
+  for (unsigned i = 0; i < 8; ++i) {
+    outer.spawn([&] {
+      galois::TaskGroup inner;
+      for (unsigned j = 0; j < 8; ++j)
+        inner.spawn([&] { ++count; });
+      inner.wait();
+      ++count;
+    });
+  }
+  outer.wait();
+  GALOIS_ASSERT(count == 72);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(4);
+
+  testDependencies();
+  testChain(1);
+  testChain(100);
+  testNestedLoops();
+  testAllocation();
+  testNestedGroups();
+
+  return 0;
+}
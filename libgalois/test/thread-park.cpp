@@ -0,0 +1,100 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/gIO.h"
+#include "galois/substrate/ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// exposes the mailbox of a pool thread
+struct Harness : public galois::substrate::ThreadPool {
+  using ThreadPool::per_signal;
+};
+
+/**
+ * One thread waits on a mailbox and the other wakes it, as the pool does
+ * between loops. The waker sometimes pauses so that the waiter parks, and
+ * sometimes wakes right away so that it is caught spinning or in the middle
+ * of parking. A lost wakeup hangs the test.
+ */
+void testPingPong(unsigned spin, unsigned rounds) {
+  Harness::per_signal box;
+  box.done    = 1;
+  box.release = 0;
+  std::atomic<unsigned> seen{0};
+
+  std::thread waiter([&] {
+    for (unsigned r = 0; r < rounds; ++r) {
+      box.wait(false, spin);
+      seen.store(r + 1, std::memory_order_relaxed);
+      box.done = 1;
+    }
+  });
+
+  for (unsigned r = 0; r < rounds; ++r) {
+    while (!box.done) {
+      std::this_thread::yield();
+    }
+    GALOIS_ASSERT(seen.load(std::memory_order_relaxed) == r);
+    if (r % 7 == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    } else if (r % 3 == 0) {
+      std::this_thread::yield();
+    }
+    box.wakeup();
+  }
+  waiter.join();
+  GALOIS_ASSERT(seen == rounds);
+  GALOIS_ASSERT(box.release == 0);
+}
+
+int main() {
+  galois::SharedMemSys Galois_runtime;
+  // always park, park after a short spin, and mostly spin
+  testPingPong(0, 2000);
+  testPingPong(10, 2000);
+  testPingPong(100000, 2000);
+
+  // the pool itself, with threads parked between loops
+  galois::setActiveThreads(2);
+  std::atomic<unsigned> ran{0};
+  for (unsigned r = 0; r < 100; ++r) {
+    galois::on_each([&](unsigned, unsigned) { ++ran; });
+    if (r % 10 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  GALOIS_ASSERT(ran == 100 * galois::getActiveThreads());
+
+  // threads outside the pool report tid 0 like the master thread
+  auto& pool = galois::substrate::getThreadPool();
+  GALOIS_ASSERT(pool.isPoolThread());
+  galois::on_each([&](unsigned, unsigned) {
+    GALOIS_ASSERT(pool.isPoolThread());
+  });
+  std::thread outside([&] {
+    GALOIS_ASSERT(galois::substrate::ThreadPool::getTID() == 0);
+    GALOIS_ASSERT(!pool.isPoolThread());
+  });
+  outside.join();
+  return 0;
+}
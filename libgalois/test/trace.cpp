@@ -0,0 +1,81 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/substrate/Trace.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//! Runs loops that touch every traced event kind
+void run() {
+  galois::SharedMemSys G;
+  galois::setActiveThreads(galois::substrate::getThreadPool().getMaxThreads());
+
+  std::vector<int> v(10000);
+  galois::do_all(
+      galois::iterate(v), [](int& x) { x += 1; }, galois::steal(),
+      galois::loopname("TraceDoAll"));
+  galois::for_each(
+      galois::iterate(v),
+      [](int& x, auto&) { x += 1; }, galois::loopname("TraceForEach"));
+  {
+    // names are copied when recorded, so the string may be gone by the dump
+    std::string name = "TraceTemporaryName";
+    galois::do_all(
+        galois::iterate(v), [](int& x) { x += 1; },
+        galois::loopname(name.c_str()));
+    name.assign(name.size(), 'x');
+  }
+  galois::substrate::traceInstant(galois::substrate::TraceCategory::NETWORK,
+                                  "TraceInstant", 42);
+}
+
+int main() {
+  run();
+  // recording has stopped once the trace is written
+  galois::substrate::traceInstant(galois::substrate::TraceCategory::NETWORK,
+                                  "TraceAfterDump");
+
+#ifdef GALOIS_ENABLE_TRACE
+  const char* file = getenv("GALOIS_TRACE_FILE");
+  GALOIS_ASSERT(file, "run with GALOIS_TRACE_FILE set");
+  std::ifstream in(file);
+  GALOIS_ASSERT(in.good(), "trace file ", file, " was not written");
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string trace = ss.str();
+
+  GALOIS_ASSERT(trace.find("\"traceEvents\"") != std::string::npos);
+  for (const char* expected :
+       {"\"TraceDoAll\"", "\"TraceForEach\"", "\"cat\":\"loop\"",
+        "\"cat\":\"chunk\"", "\"cat\":\"steal\"", "\"cat\":\"termination\"",
+        "\"TraceTemporaryName\"", "\"TraceInstant\"", "\"arg\":42",
+        "\"thread_name\""}) {
+    GALOIS_ASSERT(trace.find(expected) != std::string::npos, "missing ",
+                  expected);
+  }
+  GALOIS_ASSERT(trace.find("xxxxxx") == std::string::npos);
+  GALOIS_ASSERT(trace.rfind("]}") != std::string::npos);
+#endif
+
+  return 0;
+}
@@ -28,12 +28,20 @@
 
 #include <unordered_map>
 #include <fstream>
+#include <cstring>
+#include <chrono>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "galois/runtime/GlobalObj.h"
 #include "galois/runtime/DistStats.h"
 #include "galois/runtime/SyncStructures.h"
 #include "galois/runtime/DataCommMode.h"
+#include "galois/runtime/SyncCompression.h"
 #include "galois/DynamicBitset.h"
+#include "galois/DReducible.h"
 
 #ifdef GALOIS_ENABLE_GPU
 #include "galois/cuda/HostDecls.h"
@@ -129,6 +137,10 @@ private:
   // Used for efficient comms
   galois::DynamicBitSet syncBitset;
   galois::PODResizeableArray<unsigned int> syncOffsets;
+  //! Decides when sync messages are compressed
+  galois::runtime::SyncCompressionModel compressionModel;
+  //! Holds the encoded parts of a compressed message
+  galois::PODResizeableArray<uint8_t> compressBuffer;
 
   /**
    * Reset a provided bitset given the type of synchronization performed
@@ -768,7 +780,8 @@ private:
    * @tparam VecType type of val_vec, which stores the data to send
    *
    * @param loopName loop name used for timers
-   * @param data_mode the way that the data should be communicated
+   * @param data_mode the way that the data should be communicated; becomes
+   * its compressed variant if the message is compressed
    * @param bit_set_count the number of items we are sending in this message
    * @param indices list of all nodes that we are potentially interested in
    * sending things to
@@ -778,7 +791,7 @@ private:
    * to
    */
   template <bool async, SyncType syncType, typename VecType>
-  void serializeMessage(std::string loopName, DataCommMode data_mode,
+  void serializeMessage(std::string loopName, DataCommMode& data_mode,
                         size_t bit_set_count, std::vector<size_t>& indices,
                         galois::PODResizeableArray<unsigned int>& offsets,
                         galois::DynamicBitSet& bit_set_comm, VecType& val_vec,
@@ -799,26 +812,131 @@ private:
       convertLIDToGID<syncType>(loopName, indices, offsets);
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      }
       Tserialize.stop();
     } else if (data_mode == offsetsData) {
       offsets.resize(bit_set_count);
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, offsets, val_vec);
+      }
       Tserialize.stop();
     } else if (data_mode == bitsetData) {
       val_vec.resize(bit_set_count);
       Tserialize.start();
-      gSerialize(b, data_mode, bit_set_count, bit_set_comm, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, bit_set_count,
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, bit_set_count, bit_set_comm, val_vec);
+      }
       Tserialize.stop();
     } else { // onlyData
       Tserialize.start();
-      gSerialize(b, data_mode, val_vec);
+      if (!serializeCompressed<syncType>(loopName, data_mode, val_vec.size(),
+                                         offsets, bit_set_comm, val_vec, b)) {
+        gSerialize(b, data_mode, val_vec);
+      }
       Tserialize.stop();
     }
   }
 
+  /**
+   * Serializes a message with compressed metadata and values if the
+   * compression model expects that to pay off. A compressed message holds
+   * the compressed data mode, the number of values, the length and bytes of
+   * the encoded metadata (none for onlyData), and the value codec with the
+   * length and bytes of the encoded values.
+   *
+   * @param loopName loop name used for stats
+   * @param data_mode bitsetData, offsetsData, gidsData or onlyData; becomes
+   * its compressed variant if the message is compressed
+   * @param bit_set_count number of values to send
+   * @param offsets indices (or global IDs) of the values for offsetsData
+   * (gidsData)
+   * @param bit_set_comm bitset of the values for bitsetData
+   * @param val_vec values to send
+   * @param b buffer to serialize into
+   * @returns true if the message was serialized
+   */
+  template <SyncType syncType, typename VecType>
+  bool serializeCompressed(const std::string& loopName,
+                           DataCommMode& data_mode, size_t bit_set_count,
+                           galois::PODResizeableArray<unsigned int>& offsets,
+                           galois::DynamicBitSet& bit_set_comm,
+                           VecType& val_vec, galois::runtime::SendBuffer& b) {
+    using ValTy = typename VecType::value_type;
+    if constexpr (!galois::runtime::is_memory_copyable<ValTy>::value) {
+      return false;
+    } else {
+      size_t metaBytes = 0;
+      if (data_mode == bitsetData) {
+        metaBytes = bit_set_comm.get_vec().size() * sizeof(uint64_t);
+      } else if (data_mode != onlyData) {
+        metaBytes = bit_set_count * sizeof(unsigned int);
+      }
+      size_t valBytes = bit_set_count * sizeof(ValTy);
+      if (!compressionModel.shouldTry(data_mode, metaBytes + valBytes)) {
+        return false;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      compressBuffer.resize(metaBytes + valBytes +
+                            galois::runtime::internal::MAX_VARINT_BYTES);
+      uint8_t* meta  = compressBuffer.data();
+      size_t metaLen = 0;
+      if (data_mode == bitsetData) {
+        metaLen =
+            galois::runtime::encodeBitsetRuns(bit_set_comm, meta, metaBytes);
+      } else if (data_mode != onlyData) {
+        metaLen = galois::runtime::encodeIndices(offsets.data(), bit_set_count,
+                                                 meta, metaBytes);
+      }
+      size_t compressed = 0;
+      galois::runtime::ValueCodec codec;
+      uint8_t* values = meta + metaLen;
+      size_t valLen   = 0;
+      if (metaLen || data_mode == onlyData) {
+        valLen = galois::runtime::encodeValues(val_vec.data(), bit_set_count,
+                                               values, valBytes, codec);
+        if (!valLen) {
+          codec  = galois::runtime::rawValues;
+          valLen = valBytes;
+        }
+        compressed = metaLen + valLen;
+      }
+      double micros = std::chrono::duration<double, std::micro>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+      if (!compressionModel.shouldSend(data_mode, metaBytes + valBytes,
+                                       compressed, micros)) {
+        return false;
+      }
+
+      data_mode = compressedMode(data_mode);
+      gSerialize(b, data_mode, bit_set_count, metaLen);
+      b.insert(meta, metaLen);
+      gSerialize(b, codec, valLen);
+      if (codec == galois::runtime::rawValues) {
+        b.insert(reinterpret_cast<const uint8_t*>(val_vec.data()), valLen);
+      } else {
+        b.insert(values, valLen);
+      }
+
+      std::string syncTypeStr =
+          (syncType == syncReduce) ? "Reduce" : "Broadcast";
+      galois::runtime::reportStat_Tsum(
+          RNAME,
+          syncTypeStr + "CompressionSavedBytes_" +
+              get_run_identifier(loopName),
+          metaBytes + valBytes - compressed);
+      return true;
+    }
+  }
+
   /**
    * Given the data mode, deserialize the rest of a message in a Receive Buffer.
    *
@@ -827,7 +945,8 @@ private:
    *
    * @param loopName used to name timers for statistics
    * @param data_mode data mode with which the original message was sent;
-   * determines how to deserialize the rest of the message
+   * determines how to deserialize the rest of the message. A compressed data
+   * mode is replaced by the data mode it is a variant of.
    * @param buf buffer which contains the received message to deserialize
    *
    * The rest of the arguments are output arguments (they are passed by
@@ -844,7 +963,7 @@ private:
    * @param val_vec The data proper will be deserialized into this vector
    */
   template <SyncType syncType, typename VecType>
-  void deserializeMessage(std::string loopName, DataCommMode data_mode,
+  void deserializeMessage(std::string loopName, DataCommMode& data_mode,
                           uint32_t num, galois::runtime::RecvBuffer& buf,
                           size_t& bit_set_count,
                           galois::PODResizeableArray<unsigned int>& offsets,
@@ -857,6 +976,15 @@ private:
         serialize_timer_str.c_str(), RNAME);
     Tdeserialize.start();
 
+    if (isCompressedMode(data_mode)) {
+      data_mode = uncompressedMode(data_mode);
+      deserializeCompressed<syncType>(loopName, data_mode, num, buf,
+                                      bit_set_count, offsets, bit_set_comm,
+                                      val_vec);
+      Tdeserialize.stop();
+      return;
+    }
+
     // get other metadata associated with message if mode isn't OnlyData
     if (data_mode != onlyData) {
       galois::runtime::gDeserialize(buf, bit_set_count);
@@ -882,6 +1010,53 @@ private:
     Tdeserialize.stop();
   }
 
+  /**
+   * Deserializes a message written by serializeCompressed.
+   *
+   * @param data_mode data mode the message is a compressed variant of
+   * @see deserializeMessage for the other arguments
+   */
+  template <SyncType syncType, typename VecType>
+  void deserializeCompressed(const std::string& loopName,
+                             DataCommMode data_mode, uint32_t num,
+                             galois::runtime::RecvBuffer& buf,
+                             size_t& bit_set_count,
+                             galois::PODResizeableArray<unsigned int>& offsets,
+                             galois::DynamicBitSet& bit_set_comm,
+                             VecType& val_vec) {
+    using ValTy = typename VecType::value_type;
+    if constexpr (!galois::runtime::is_memory_copyable<ValTy>::value) {
+      GALOIS_DIE("compressed message of values that cannot be compressed");
+    } else {
+      size_t metaLen;
+      galois::runtime::gDeserialize(buf, bit_set_count, metaLen);
+      GALOIS_ASSERT(metaLen <= buf.r_size(), "truncated sync message");
+      const uint8_t* meta = metaLen ? buf.r_linearData() : nullptr;
+      if (data_mode == bitsetData) {
+        bit_set_comm.resize(num);
+        galois::runtime::decodeBitsetRuns(meta, metaLen, bit_set_comm);
+      } else if (data_mode != onlyData) {
+        offsets.resize(bit_set_count);
+        galois::runtime::decodeIndices(meta, metaLen, offsets.data(),
+                                       bit_set_count);
+        if (data_mode == gidsData) {
+          convertGIDToLID<syncType>(loopName, offsets);
+        }
+      }
+      buf.setOffset(buf.getOffset() + metaLen);
+
+      galois::runtime::ValueCodec codec;
+      size_t valLen;
+      galois::runtime::gDeserialize(buf, codec, valLen);
+      GALOIS_ASSERT(valLen <= buf.r_size(), "truncated sync message");
+      val_vec.resize(bit_set_count);
+      galois::runtime::decodeValues(codec,
+                                    valLen ? buf.r_linearData() : nullptr,
+                                    valLen, val_vec.data(), bit_set_count);
+      buf.setOffset(buf.getOffset() + valLen);
+    }
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   // Other helper functions
   ////////////////////////////////////////////////////////////////////////////////
@@ -3453,6 +3628,20 @@ public:
    */
   inline void set_num_round(const uint32_t round) { num_round = round; }
 
+  /**
+   * Set when synchronization messages this host sends are compressed. Any
+   * CPU host decodes compressed messages, but GPU hosts do not, so none may
+   * take part when compression is on.
+   *
+   * @param mode when to compress
+   * @param bandwidthMBps network bandwidth of a host in MB/s, used by the
+   * cost model of autoCompression
+   */
+  void setSyncCompression(galois::runtime::SyncCompression mode,
+                          double bandwidthMBps) {
+    compressionModel.configure(mode, bandwidthMBps);
+  }
+
   /**
    * Get a run identifier using the set run and set round.
    *
@@ -3542,89 +3731,200 @@ public:
 // Checkpointing code for graph
 ////////////////////////////////////////////////////////////////////////////////
 
-// @todo Checkpointing code needs updates to make it work.
-#ifdef GALOIS_CHECKPOINT
-///*
-// * Headers for boost serialization
-// */
-//#include <boost/archive/binary_oarchive.hpp>
-//#include <boost/archive/binary_iarchive.hpp>
-//#include <boost/serialization/split_member.hpp>
-//#include <boost/serialization/binary_object.hpp>
-//#include <boost/serialization/serialization.hpp>
-//#include <boost/serialization/vector.hpp>
-//#include <boost/serialization/unordered_map.hpp>
-//
-// public:
-//  /**
-//   * Checkpoint the complete structure on the node to disk
-//   */
-//  void checkpointSaveNodeData(std::string checkpointFileName = "checkpoint") {
-//    using namespace boost::archive;
-//    galois::StatTimer TimerSaveCheckPoint(
-//        get_run_identifier("TimerSaveCheckpoint").c_str(), RNAME);
-//
-//    TimerSaveCheckPoint.start();
-//    std::string checkpointFileName_local =
-//        checkpointFileName + "_" + std::to_string(id);
-//
-//    std::ofstream outputStream(checkpointFileName_local, std::ios::binary);
-//    if (!outputStream.is_open()) {
-//      galois::gPrint("ERROR: Could not open ", checkpointFileName_local,
-//                     " to save checkpoint!!!\n");
-//    }
-//    galois::gPrint("[", id,
-//                   "] Saving local checkpoint to :", checkpointFileName_local,
-//                   "\n");
-//
-//    boost::archive::binary_oarchive ar(outputStream,
-//    boost::archive::no_header);
-//
-//    // TODO handle this with CuSP
-//    userGraph.serializeNodeData(ar);
-//
-//    std::string statSendBytes_str("CheckpointBytesTotal");
-//    constexpr static const char* const RREGION = "RECOVERY";
-//    size_t cp_size                             = outputStream.tellp();
-//    galois::runtime::reportStat_Tsum(RREGION, statSendBytes_str, cp_size);
-//
-//    outputStream.flush();
-//    outputStream.close();
-//    TimerSaveCheckPoint.stop();
-//  }
-//
-//  /**
-//   * Load checkpointed data from disk.
-//   */
-//  void checkpointApplyNodeData(std::string checkpointFileName = "checkpoint")
-//  {
-//    using namespace boost::archive;
-//    galois::StatTimer TimerApplyCheckPoint(
-//        get_run_identifier("TimerApplyCheckpoint").c_str(), RNAME);
-//
-//    TimerApplyCheckPoint.start();
-//    std::string checkpointFileName_local =
-//        checkpointFileName + "_" + std::to_string(id);
-//
-//    std::ifstream inputStream(checkpointFileName_local, std::ios::binary);
-//
-//    if (!inputStream.is_open()) {
-//      galois::gPrint("ERROR: Could not open ", checkpointFileName_local,
-//                     " to read checkpoint!!!\n");
-//    }
-//    galois::gPrint("[", id, "] reading local checkpoint from: ",
-//                   checkpointFileName_local, "\n");
-//
-//    boost::archive::binary_iarchive ar(inputStream,
-//    boost::archive::no_header);
-//
-//    // TODO handle this with CuSP
-//    userGraph.deSerializeNodeData(ar);
-//
-//    inputStream.close();
-//    TimerApplyCheckPoint.stop();
-//  }
-#endif
+private:
+  //! Identifies checkpoint files; bump the version when the layout changes
+  constexpr static uint64_t CHECKPOINT_MAGIC   = 0x54504b43544c4447;
+  constexpr static uint64_t CHECKPOINT_VERSION = 1;
+  //! Node data starts at this offset so the file can be mapped page-aligned
+  constexpr static size_t CHECKPOINT_DATA_OFFSET = 4096;
+
+  //! Header at the start of a checkpoint file
+  struct CheckpointHeader {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t host;
+    uint64_t numHosts;
+    uint64_t numNodes;
+    uint64_t nodeDataSize;
+    //! round the checkpoint resumes from
+    uint64_t round;
+  };
+
+  //! Checkpoints alternate between two files so a failure while writing
+  //! one leaves the previous checkpoint intact
+  std::string checkpointFile(const std::string& prefix,
+                             unsigned generation) const {
+    return prefix + "_" + std::to_string(id) + "_" +
+           std::to_string(generation);
+  }
+
+  /**
+   * Returns the round saved in a checkpoint file or -1 if the file does not
+   * exist or does not hold a checkpoint of this partition.
+   */
+  template <typename NodeData>
+  int64_t checkpointRound(const std::string& fileName) const {
+    CheckpointHeader header;
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+      return -1;
+    }
+    if (header.magic != CHECKPOINT_MAGIC ||
+        header.version != CHECKPOINT_VERSION || header.host != id ||
+        header.numHosts != numHosts || header.numNodes != userGraph.size() ||
+        header.nodeDataSize != sizeof(NodeData)) {
+      galois::gWarn("[", id, "] ignoring checkpoint ", fileName,
+                    ": it does not match this partition");
+      return -1;
+    }
+    return header.round;
+  }
+
+public:
+  /**
+   * Saves the node data of all proxies on this host to disk along with the
+   * round to resume from. The file is a small header followed by the raw
+   * node data at a page-aligned offset, so it is written and read back
+   * through mmap. Of the two checkpoint files of a host, the one with the
+   * older checkpoint is replaced; it is written under a temporary name and
+   * renamed once synced to disk, so the newest complete checkpoint is never
+   * lost.
+   *
+   * Node data is copied bytewise, so it must not hold pointers or own
+   * memory. Call this at a point where all hosts are in the same round
+   * (e.g., at the end of a BSP round).
+   *
+   * @param round Round to resume from when restarting from this checkpoint
+   * @param prefix Prefix of the checkpoint file names
+   */
+  void checkpointSaveNodeData(uint32_t round,
+                              const std::string& prefix = "checkpoint") {
+    using NodeData = std::remove_reference_t<decltype(userGraph.getData(0))>;
+    static_assert(std::is_standard_layout<NodeData>::value,
+                  "checkpointed node data must have a standard layout");
+    static_assert(std::is_trivially_destructible<NodeData>::value,
+                  "checkpointed node data must not own memory");
+
+    galois::StatTimer saveTimer("CheckpointSaveTime", RNAME);
+    saveTimer.start();
+
+    unsigned generation =
+        checkpointRound<NodeData>(checkpointFile(prefix, 0)) <=
+                checkpointRound<NodeData>(checkpointFile(prefix, 1))
+            ? 0
+            : 1;
+    std::string fileName = checkpointFile(prefix, generation);
+    std::string tmpName  = fileName + ".tmp";
+
+    size_t numNodes = userGraph.size();
+    size_t fileSize = CHECKPOINT_DATA_OFFSET + numNodes * sizeof(NodeData);
+
+    int fd = open(tmpName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+      GALOIS_SYS_DIE("failed to create checkpoint ", tmpName);
+    }
+    if (ftruncate(fd, fileSize) == -1) {
+      GALOIS_SYS_DIE("failed to size checkpoint ", tmpName);
+    }
+    void* base =
+        mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+      GALOIS_SYS_DIE("failed to map checkpoint ", tmpName);
+    }
+
+    CheckpointHeader header{CHECKPOINT_MAGIC, CHECKPOINT_VERSION, id,
+                            numHosts,         numNodes,
+                            sizeof(NodeData), round};
+    std::memcpy(base, &header, sizeof(header));
+    char* data = static_cast<char*>(base) + CHECKPOINT_DATA_OFFSET;
+    galois::do_all(
+        galois::iterate(size_t{0}, numNodes),
+        [&](size_t n) {
+          std::memcpy(data + n * sizeof(NodeData), &userGraph.getData(n),
+                      sizeof(NodeData));
+        },
+        galois::no_stats());
+
+    if (msync(base, fileSize, MS_SYNC) == -1 || munmap(base, fileSize) == -1 ||
+        fsync(fd) == -1 || close(fd) == -1) {
+      GALOIS_SYS_DIE("failed to write checkpoint ", tmpName);
+    }
+    if (rename(tmpName.c_str(), fileName.c_str()) == -1) {
+      GALOIS_SYS_DIE("failed to rename checkpoint ", tmpName);
+    }
+
+    saveTimer.stop();
+    galois::runtime::reportStat_Tsum(RNAME, "CheckpointBytes", fileSize);
+    galois::gPrint("[", id, "] Saved checkpoint of round ", round, " to ",
+                   fileName, " in ", saveTimer.get(), " ms\n");
+  }
+
+  /**
+   * Restores node data from the newest checkpoint that every host has
+   * saved. Must be called by all hosts.
+   *
+   * @param round Set to the round to resume from if a checkpoint is restored
+   * @param prefix Prefix of the checkpoint file names
+   * @returns true if node data was restored; false if no checkpoint common
+   * to all hosts exists, in which case node data is untouched
+   */
+  bool checkpointApplyNodeData(uint32_t& round,
+                               const std::string& prefix = "checkpoint") {
+    using NodeData = std::remove_reference_t<decltype(userGraph.getData(0))>;
+    static_assert(std::is_standard_layout<NodeData>::value,
+                  "checkpointed node data must have a standard layout");
+    static_assert(std::is_trivially_destructible<NodeData>::value,
+                  "checkpointed node data must not own memory");
+
+    galois::StatTimer applyTimer("CheckpointApplyTime", RNAME);
+    applyTimer.start();
+
+    // all hosts must resume from the same round; a host that failed while
+    // writing its newest checkpoint still has the one before it
+    int64_t rounds[2] = {checkpointRound<NodeData>(checkpointFile(prefix, 0)),
+                         checkpointRound<NodeData>(checkpointFile(prefix, 1))};
+    galois::DGReduceMin<int64_t> newestCommon;
+    newestCommon.update(std::max(rounds[0], rounds[1]));
+    int64_t resumeRound = newestCommon.reduce();
+    if (resumeRound < 0) {
+      applyTimer.stop();
+      return false;
+    }
+    if (rounds[0] != resumeRound && rounds[1] != resumeRound) {
+      GALOIS_DIE("host ", id, " has no checkpoint of round ", resumeRound);
+    }
+    std::string fileName =
+        checkpointFile(prefix, rounds[0] == resumeRound ? 0 : 1);
+    galois::gPrint("[", id, "] Restoring checkpoint of round ", resumeRound,
+                   " from ", fileName, "\n");
+
+    size_t numNodes = userGraph.size();
+    size_t fileSize = CHECKPOINT_DATA_OFFSET + numNodes * sizeof(NodeData);
+
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+      GALOIS_SYS_DIE("failed to open checkpoint ", fileName);
+    }
+    void* base = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+      GALOIS_SYS_DIE("failed to map checkpoint ", fileName);
+    }
+    const char* data = static_cast<const char*>(base) + CHECKPOINT_DATA_OFFSET;
+    galois::do_all(
+        galois::iterate(size_t{0}, numNodes),
+        [&](size_t n) {
+          // node data is restored bytewise; see checkpointSaveNodeData
+          std::memcpy(static_cast<void*>(&userGraph.getData(n)),
+                      data + n * sizeof(NodeData), sizeof(NodeData));
+        },
+        galois::no_stats());
+    munmap(base, fileSize);
+    close(fd);
+
+    round = resumeRound;
+    applyTimer.stop();
+    return true;
+  }
 };
 
 template <typename GraphTy>
@@ -37,9 +37,31 @@ enum DataCommMode {
   gidsData,
   onlyData,
   dataSplitFirst, // NOT USED
-  dataSplit       // NOT USED
+  dataSplit,      // NOT USED
+  //! the modes above with compressed metadata and values; see
+  //! SyncCompression.h
+  bitsetDataCompressed,
+  offsetsDataCompressed,
+  gidsDataCompressed,
+  onlyDataCompressed
 };
 
+//! Returns true if a data mode carries compressed metadata and values
+inline bool isCompressedMode(DataCommMode mode) {
+  return mode >= bitsetDataCompressed && mode <= onlyDataCompressed;
+}
+
+//! Returns the compressed variant of bitsetData, offsetsData, gidsData or
+//! onlyData
+inline DataCommMode compressedMode(DataCommMode mode) {
+  return static_cast<DataCommMode>(mode - bitsetData + bitsetDataCompressed);
+}
+
+//! Returns the data mode a compressed data mode is a variant of
+inline DataCommMode uncompressedMode(DataCommMode mode) {
+  return static_cast<DataCommMode>(mode - bitsetDataCompressed + bitsetData);
+}
+
 //! If some mode is to be enforced, set this variable
 //! @todo using a global is not great, but current problem is that GPU code
 //! assumes variable and would take some reorg to fix
@@ -0,0 +1,432 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file SyncCompression.h
+ *
+ * Contains the encodings Gluon can use to compress the metadata and values
+ * of synchronization messages, and the cost model that decides when they are
+ * used.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "galois/DynamicBitset.h"
+#include "galois/gIO.h"
+#include "galois/runtime/DataCommMode.h"
+
+namespace galois {
+namespace runtime {
+
+//! When Gluon compresses synchronization messages
+enum SyncCompression {
+  noCompression,    //!< never
+  autoCompression,  //!< when the cost model expects it to save time
+  alwaysCompression //!< whenever it makes a message smaller
+};
+
+//! Encodings of the values of a compressed message
+enum ValueCodec : uint8_t {
+  rawValues,    //!< values as they are in memory
+  varintValues, //!< integers as (zigzag) varints
+  runValues     //!< (varint run length, value) pairs of equal values
+};
+
+namespace internal {
+
+//! Most bytes a 64-bit varint takes
+constexpr size_t MAX_VARINT_BYTES = 10;
+
+//! Number of bytes v takes as a varint
+inline size_t varintSize(uint64_t v) {
+  size_t n = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+//! Writes v as a little-endian base-128 varint; returns the end of it
+inline uint8_t* encodeVarint(uint64_t v, uint8_t* out) {
+  while (v >= 0x80) {
+    *out++ = static_cast<uint8_t>(v) | 0x80;
+    v >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(v);
+  return out;
+}
+
+//! Reads a varint, advancing in; dies if it runs past end
+inline uint64_t decodeVarint(const uint8_t*& in, const uint8_t* end) {
+  uint64_t v     = 0;
+  unsigned shift = 0;
+  while (true) {
+    if (in == end || shift > 63) {
+      GALOIS_DIE("corrupt varint in compressed sync message");
+    }
+    uint8_t byte = *in++;
+    v |= uint64_t(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return v;
+    }
+    shift += 7;
+  }
+}
+
+inline uint64_t zigzag(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+//! Integer value type as an unsigned 64-bit integer to varint encode
+template <typename T>
+uint64_t toVarint(T v) {
+  if constexpr (std::is_signed<T>::value) {
+    return zigzag(static_cast<int64_t>(v));
+  } else {
+    return static_cast<uint64_t>(v);
+  }
+}
+
+template <typename T>
+T fromVarint(uint64_t v) {
+  if constexpr (std::is_signed<T>::value) {
+    return static_cast<T>(unzigzag(v));
+  } else {
+    return static_cast<T>(v);
+  }
+}
+
+} // namespace internal
+
+/**
+ * Encodes indices as zigzag varints of the difference to the previous index,
+ * which takes a byte or two for the sorted, dense offsets of a bitset and
+ * does not break down for unsorted global IDs.
+ *
+ * @param v indices to encode
+ * @param n number of indices
+ * @param out buffer with room for limit + MAX_VARINT_BYTES bytes
+ * @param limit give up once the encoding is longer than this
+ * @returns bytes written, or 0 if the encoding is longer than limit
+ */
+inline size_t encodeIndices(const unsigned* v, size_t n, uint8_t* out,
+                            size_t limit) {
+  uint8_t* p    = out;
+  uint8_t* stop = out + limit;
+  int64_t prev  = 0;
+  for (size_t i = 0; i < n; ++i) {
+    p    = internal::encodeVarint(internal::zigzag(int64_t(v[i]) - prev), p);
+    prev = v[i];
+    if (p > stop) {
+      return 0;
+    }
+  }
+  return p - out;
+}
+
+//! Decodes n indices written by encodeIndices from len bytes at in into v
+inline void decodeIndices(const uint8_t* in, size_t len, unsigned* v,
+                          size_t n) {
+  const uint8_t* end = in + len;
+  int64_t prev       = 0;
+  for (size_t i = 0; i < n; ++i) {
+    prev += internal::unzigzag(internal::decodeVarint(in, end));
+    v[i] = static_cast<unsigned>(prev);
+  }
+}
+
+/**
+ * Encodes a bitset as the varint lengths of its alternating runs of unset
+ * and set bits, starting with unset ones. Sparse and clustered bitsets take
+ * far less than their bit vector.
+ *
+ * @param bs bitset to encode
+ * @param out buffer with room for limit + MAX_VARINT_BYTES bytes
+ * @param limit give up once the encoding is longer than this
+ * @returns bytes written, or 0 if the encoding is longer than limit
+ */
+inline size_t encodeBitsetRuns(const galois::DynamicBitSet& bs, uint8_t* out,
+                               size_t limit) {
+  const auto& words = bs.get_vec();
+  size_t num        = bs.size();
+  uint8_t* p        = out;
+  uint8_t* stop     = out + limit;
+  size_t pos        = 0;
+  bool bit          = false;
+  while (pos < num) {
+    // find the first bit at or after pos that differs from the current run
+    size_t next = num;
+    for (size_t w = pos / 64; w < words.size(); ++w) {
+      uint64_t word = words[w].load(std::memory_order_relaxed);
+      if (bit) {
+        word = ~word;
+      }
+      if (w == pos / 64) {
+        word &= ~uint64_t(0) << (pos % 64);
+      }
+      if (word) {
+        next = std::min(num, w * 64 + __builtin_ctzll(word));
+        break;
+      }
+    }
+    p   = internal::encodeVarint(next - pos, p);
+    pos = next;
+    bit = !bit;
+    if (p > stop) {
+      return 0;
+    }
+  }
+  return p - out;
+}
+
+//! Sets the bits of a bitset, already sized and reset, from the runs written
+//! by encodeBitsetRuns in len bytes at in
+inline void decodeBitsetRuns(const uint8_t* in, size_t len,
+                             galois::DynamicBitSet& bs) {
+  const uint8_t* end = in + len;
+  auto& words        = bs.get_vec();
+  size_t num         = bs.size();
+  size_t pos         = 0;
+  bool bit           = false;
+  while (pos < num) {
+    size_t run = internal::decodeVarint(in, end);
+    if (run > num - pos) {
+      GALOIS_DIE("corrupt bitset in compressed sync message");
+    }
+    // set the run a word at a time
+    for (size_t i = pos; bit && i < pos + run;) {
+      size_t w      = i / 64;
+      size_t first  = i % 64;
+      size_t last   = std::min<size_t>(64, first + (pos + run - i));
+      uint64_t mask = (last == 64 ? ~uint64_t(0) : (uint64_t(1) << last) - 1) &
+                      (~uint64_t(0) << first);
+      words[w].store(words[w].load(std::memory_order_relaxed) | mask,
+                     std::memory_order_relaxed);
+      i += last - first;
+    }
+    pos += run;
+    bit = !bit;
+  }
+}
+
+/**
+ * Encodes values with whichever of varints (integers only) and runs of equal
+ * values is shorter.
+ *
+ * @param v values to encode
+ * @param n number of values
+ * @param out buffer with room for limit bytes
+ * @param limit give up if the shorter encoding is longer than this
+ * @param [out] codec encoding used; rawValues if none is short enough
+ * @returns bytes written, or 0 if no encoding is short enough
+ */
+template <typename T>
+size_t encodeValues(const T* v, size_t n, uint8_t* out, size_t limit,
+                    ValueCodec& codec) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "values must be trivially copyable");
+  codec = rawValues;
+  if (n == 0) {
+    return 0;
+  }
+
+  size_t runBytes = 0;
+  for (size_t i = 0; i < n && runBytes <= limit;) {
+    size_t j = i + 1;
+    while (j < n && std::memcmp(&v[j], &v[i], sizeof(T)) == 0) {
+      ++j;
+    }
+    runBytes += internal::varintSize(j - i) + sizeof(T);
+    i = j;
+  }
+  size_t varintBytes = limit + 1;
+  if constexpr (std::is_integral<T>::value) {
+    varintBytes = 0;
+    for (size_t i = 0; i < n && varintBytes <= limit; ++i) {
+      varintBytes += internal::varintSize(internal::toVarint(v[i]));
+    }
+  }
+  if (std::min(runBytes, varintBytes) > limit) {
+    return 0;
+  }
+
+  uint8_t* p = out;
+  if (varintBytes < runBytes) {
+    if constexpr (std::is_integral<T>::value) {
+      codec = varintValues;
+      for (size_t i = 0; i < n; ++i) {
+        p = internal::encodeVarint(internal::toVarint(v[i]), p);
+      }
+    }
+  } else {
+    codec = runValues;
+    for (size_t i = 0; i < n;) {
+      size_t j = i + 1;
+      while (j < n && std::memcmp(&v[j], &v[i], sizeof(T)) == 0) {
+        ++j;
+      }
+      p = internal::encodeVarint(j - i, p);
+      std::memcpy(p, &v[i], sizeof(T));
+      p += sizeof(T);
+      i = j;
+    }
+  }
+  return p - out;
+}
+
+//! Decodes n values written with codec in len bytes at in into v
+template <typename T>
+void decodeValues(ValueCodec codec, const uint8_t* in, size_t len, T* v,
+                  size_t n) {
+  const uint8_t* end = in + len;
+  switch (codec) {
+  case rawValues:
+    if (len != n * sizeof(T)) {
+      GALOIS_DIE("corrupt values in compressed sync message");
+    }
+    std::memcpy(static_cast<void*>(v), in, len);
+    break;
+  case varintValues:
+    if constexpr (std::is_integral<T>::value) {
+      for (size_t i = 0; i < n; ++i) {
+        v[i] = internal::fromVarint<T>(internal::decodeVarint(in, end));
+      }
+    } else {
+      GALOIS_DIE("varint values of a non-integer type");
+    }
+    break;
+  case runValues:
+    for (size_t i = 0; i < n;) {
+      size_t run = internal::decodeVarint(in, end);
+      if (run == 0 || run > n - i || end - in < ptrdiff_t(sizeof(T))) {
+        GALOIS_DIE("corrupt values in compressed sync message");
+      }
+      T value;
+      std::memcpy(static_cast<void*>(&value), in, sizeof(T));
+      in += sizeof(T);
+      std::fill(v + i, v + i + run, value);
+      i += run;
+    }
+    break;
+  default:
+    GALOIS_DIE("unknown value codec in compressed sync message");
+  }
+}
+
+/**
+ * Decides when compressing a synchronization message pays off. Compression
+ * saves the time to move the bytes it removes over the network and costs
+ * the time to encode the message and decode it on the receiver, so it is
+ * worth it when sync is bandwidth bound: slow networks, large messages, and
+ * data that compresses well. The compression ratio of each data mode and the
+ * codec throughput are learned from the messages compressed so far; data
+ * modes that did not pay off are retried now and then in case the data
+ * changed.
+ */
+class SyncCompressionModel {
+  //! messages smaller than this are latency bound; never compressed in auto
+  constexpr static size_t MIN_BYTES = 4096;
+  //! messages skipped between retries of a data mode that did not pay off
+  constexpr static unsigned RETRY_INTERVAL = 64;
+
+  SyncCompression mode = noCompression;
+  //! network bandwidth of a host in bytes per microsecond (i.e., MB/s)
+  double bandwidth = 1250;
+  //! encode throughput in bytes per microsecond; decoding is assumed to be
+  //! as fast
+  double codecRate = 1000;
+  //! compressed to raw size of each (uncompressed) data mode
+  std::array<double, onlyData + 1> ratio;
+  std::array<unsigned, onlyData + 1> skipped;
+
+public:
+  SyncCompressionModel() {
+    ratio.fill(0.5);
+    skipped.fill(0);
+  }
+
+  /**
+   * @param m when to compress
+   * @param bandwidthMBps network bandwidth of a host in MB/s
+   */
+  void configure(SyncCompression m, double bandwidthMBps) {
+    mode      = m;
+    bandwidth = std::max(bandwidthMBps, 1.0);
+  }
+
+  bool enabled() const { return mode != noCompression; }
+
+  //! @returns true if a message of rawBytes in data mode dm should be
+  //! encoded
+  bool shouldTry(DataCommMode dm, size_t rawBytes) {
+    if (mode != autoCompression) {
+      return mode == alwaysCompression;
+    }
+    if (rawBytes < MIN_BYTES) {
+      return false;
+    }
+    double saved = rawBytes * (1 - ratio[dm]) / bandwidth;
+    double cost  = 2 * rawBytes / codecRate;
+    if (saved > cost) {
+      return true;
+    }
+    if (++skipped[dm] >= RETRY_INTERVAL) {
+      skipped[dm] = 0;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Learns from an encoded message and decides whether to send it.
+   *
+   * @param dm data mode of the message
+   * @param rawBytes size of the message uncompressed
+   * @param compressedBytes size of the message compressed; 0 if the encoding
+   * gave up
+   * @param micros time spent encoding
+   * @returns true if the compressed message should be sent
+   */
+  bool shouldSend(DataCommMode dm, size_t rawBytes, size_t compressedBytes,
+                  double micros) {
+    if (micros > 0) {
+      codecRate = (3 * codecRate + rawBytes / micros) / 4;
+    }
+    bool smaller = compressedBytes && compressedBytes < rawBytes;
+    double r     = smaller ? double(compressedBytes) / rawBytes : 1.0;
+    ratio[dm]    = (3 * ratio[dm] + r) / 4;
+    if (!smaller || mode == alwaysCompression) {
+      return smaller;
+    }
+    // encoding is done; only the receiver's decoding is left to pay for
+    return (rawBytes - compressedBytes) / bandwidth > rawBytes / codecRate;
+  }
+};
+
+} // namespace runtime
+} // namespace galois
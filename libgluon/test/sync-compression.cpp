@@ -0,0 +1,206 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/Galois.h"
+#include "galois/gIO.h"
+#include "galois/runtime/SyncCompression.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace galois::runtime;
+
+//! Encodes bs, decodes it into a fresh bitset and compares every word
+void checkBitset(const galois::DynamicBitSet& bs) {
+  std::vector<uint8_t> buf(bs.size() * internal::MAX_VARINT_BYTES + 64);
+  size_t len = encodeBitsetRuns(bs, buf.data(), buf.size() - 16);
+  GALOIS_ASSERT(len || bs.size() == 0, "bitset of ", bs.size(), " bits");
+
+  galois::DynamicBitSet out;
+  out.resize(bs.size());
+  out.reset();
+  decodeBitsetRuns(buf.data(), len, out);
+  const auto& want = bs.get_vec();
+  const auto& got  = out.get_vec();
+  GALOIS_ASSERT(want.size() == got.size());
+  for (size_t w = 0; w < want.size(); ++w) {
+    GALOIS_ASSERT(want[w] == got[w], "bitset of ", bs.size(), " bits, word ",
+                  w);
+  }
+}
+
+void testBitsets() {
+  std::mt19937 gen(7);
+  for (size_t num : {1, 2, 63, 64, 65, 127, 128, 129, 200, 1000}) {
+    galois::DynamicBitSet bs;
+    bs.resize(num);
+
+    // empty and all set; the last word is partial for most sizes
+    bs.reset();
+    checkBitset(bs);
+    for (size_t i = 0; i < num; ++i)
+      bs.set(i);
+    checkBitset(bs);
+
+    // only the first, only the last, and both ends
+    bs.reset();
+    bs.set(0);
+    checkBitset(bs);
+    bs.reset();
+    bs.set(num - 1);
+    checkBitset(bs);
+    bs.set(0);
+    checkBitset(bs);
+
+    // alternating bits and runs that start and end at word boundaries
+    bs.reset();
+    for (size_t i = 0; i < num; i += 2)
+      bs.set(i);
+    checkBitset(bs);
+    bs.reset();
+    for (size_t i = 0; i < num; ++i)
+      if ((i / 64) % 2)
+        bs.set(i);
+    checkBitset(bs);
+
+    // random runs
+    bs.reset();
+    std::uniform_int_distribution<size_t> runLength(1, 100);
+    bool bit = false;
+    for (size_t i = 0; i < num; bit = !bit) {
+      size_t end = std::min(num, i + runLength(gen));
+      for (; i < end; ++i)
+        if (bit)
+          bs.set(i);
+    }
+    checkBitset(bs);
+  }
+
+  // a run that does not fit in the limit gives up
+  galois::DynamicBitSet bs;
+  bs.resize(1000);
+  bs.reset();
+  for (size_t i = 0; i < 1000; i += 2)
+    bs.set(i);
+  std::vector<uint8_t> buf(16 + internal::MAX_VARINT_BYTES);
+  GALOIS_ASSERT(encodeBitsetRuns(bs, buf.data(), 16) == 0);
+}
+
+void checkIndices(const std::vector<unsigned>& v) {
+  std::vector<uint8_t> buf(v.size() * internal::MAX_VARINT_BYTES + 16);
+  size_t len = encodeIndices(v.data(), v.size(), buf.data(), buf.size() - 16);
+  GALOIS_ASSERT(len || v.empty());
+
+  std::vector<unsigned> out(v.size());
+  decodeIndices(buf.data(), len, out.data(), out.size());
+  GALOIS_ASSERT(out == v);
+}
+
+void testIndices() {
+  checkIndices({});
+  checkIndices({0});
+  checkIndices({std::numeric_limits<unsigned>::max()});
+
+  // sorted offsets of a bitset
+  std::vector<unsigned> sorted;
+  for (unsigned i = 0; i < 5000; i += 3)
+    sorted.push_back(i);
+  checkIndices(sorted);
+
+  // unsorted global IDs, including jumps between the extremes
+  const unsigned maxID       = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> gids = {17, 3, maxID, 0, 42, maxID - 1, 1, 1, 100000};
+  std::mt19937 gen(11);
+  for (unsigned i = 0; i < 1000; ++i)
+    gids.push_back(gen());
+  checkIndices(gids);
+
+  // too long for the limit
+  std::vector<uint8_t> buf(4 + internal::MAX_VARINT_BYTES);
+  GALOIS_ASSERT(encodeIndices(gids.data(), gids.size(), buf.data(), 4) == 0);
+}
+
+//! Round trips v and checks that encodeValues picked the expected codec;
+//! values left raw are decoded from their raw bytes
+template <typename T>
+void checkValues(const std::vector<T>& v, ValueCodec expected) {
+  size_t limit = v.size() * sizeof(T);
+  std::vector<uint8_t> buf(limit + internal::MAX_VARINT_BYTES);
+  ValueCodec codec;
+  size_t len = encodeValues(v.data(), v.size(), buf.data(), limit, codec);
+  GALOIS_ASSERT(codec == expected, "codec ", int(codec), " expected ",
+                int(expected));
+  if (codec == rawValues) {
+    GALOIS_ASSERT(len == 0);
+    std::memcpy(buf.data(), v.data(), limit);
+    len = limit;
+  }
+
+  std::vector<T> out(v.size());
+  decodeValues(codec, buf.data(), len, out.data(), out.size());
+  GALOIS_ASSERT(std::memcmp(out.data(), v.data(), limit) == 0);
+}
+
+void testValues() {
+  // n = 1
+  checkValues<uint32_t>({5}, varintValues);
+  checkValues<int64_t>({-5}, varintValues);
+  checkValues<float>({1.5f}, rawValues);
+  checkValues<double>({2.5}, rawValues);
+
+  // small signed integers, including the extremes
+  std::vector<int32_t> ints;
+  for (int32_t i = -500; i < 500; ++i)
+    ints.push_back(i);
+  checkValues(ints, varintValues);
+  ints.push_back(std::numeric_limits<int32_t>::min());
+  ints.push_back(std::numeric_limits<int32_t>::max());
+  checkValues(ints, varintValues);
+
+  // large unsigned values do not fit in fewer varint bytes
+  std::vector<uint64_t> big(100, std::numeric_limits<uint64_t>::max());
+  checkValues(big, runValues);
+  for (size_t i = 0; i < big.size(); ++i)
+    big[i] -= i * 0x0101010101010101ULL;
+  checkValues(big, rawValues);
+
+  // floats compress only as runs, including runs ending at the last value
+  std::vector<float> floats(1000, 0.25f);
+  floats[10]  = -1.0f;
+  floats[999] = std::numeric_limits<float>::infinity();
+  checkValues(floats, runValues);
+  std::vector<double> distinct;
+  for (int i = 0; i < 100; ++i)
+    distinct.push_back(i * 0.1 - 3);
+  checkValues(distinct, rawValues);
+
+  // equal integers prefer runs over varints
+  std::vector<int16_t> shorts(300, -7);
+  checkValues(shorts, runValues);
+}
+
+int main() {
+  galois::SharedMemSys G;
+  testBitsets();
+  testIndices();
+  testValues();
+  return 0;
+}
@@ -1,5 +1,6 @@
 #ifndef MINER_HPP_
 #define MINER_HPP_
+#include "galois/SetIntersection.h"
 #include "pangolin/scan.h"
 #include "pangolin/util.h"
 #include "pangolin/embedding_queue.h"
@@ -188,43 +189,14 @@ protected:
     return std::distance(g->edge_begin(vid), g->edge_end(vid));
   }
   inline unsigned intersect_merge(unsigned src, unsigned dst) {
-    unsigned count = 0;
-    for (auto e : graph.edges(dst)) {
-      GNode dst_dst = graph.getEdgeDst(e);
-      for (auto e1 : graph.edges(src)) {
-        GNode to = graph.getEdgeDst(e1);
-        if (dst_dst == to) {
-          count += 1;
-          break;
-        }
-        if (to > dst_dst)
-          break;
-      }
-    }
-    return count;
+    return galois::intersectCount(
+        graph.getEdgeDstPtr(graph.edge_begin(src)), graph.getDegree(src),
+        graph.getEdgeDstPtr(graph.edge_begin(dst)), graph.getDegree(dst));
   }
   inline unsigned intersect_dag_merge(unsigned p, unsigned q) {
-    unsigned count = 0;
-    auto p_start   = graph.edge_begin(p);
-    auto p_end     = graph.edge_end(p);
-    auto q_start   = graph.edge_begin(q);
-    auto q_end     = graph.edge_end(q);
-    auto p_it      = p_start;
-    auto q_it      = q_start;
-    int a;
-    int b;
-    while (p_it < p_end && q_it < q_end) {
-      a     = graph.getEdgeDst(p_it);
-      b     = graph.getEdgeDst(q_it);
-      int d = a - b;
-      if (d <= 0)
-        p_it++;
-      if (d >= 0)
-        q_it++;
-      if (d == 0)
-        count++;
-    }
-    return count;
+    return galois::intersectCount(
+        graph.getEdgeDstPtr(graph.edge_begin(p)), graph.getDegree(p),
+        graph.getEdgeDstPtr(graph.edge_begin(q)), graph.getDegree(q));
   }
   inline unsigned intersect_search(unsigned a, unsigned b) {
     if (degrees[a] == 0 || degrees[b] == 0)
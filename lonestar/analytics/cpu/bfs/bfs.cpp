@@ -22,6 +22,7 @@
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
 #include "galois/graphs/LCGraph.h"
+#include "galois/graphs/LC_Compressed_CSR_Graph.h"
 #include "galois/graphs/TypeTraits.h"
 #include "Lonestar/BoilerPlate.h"
 #include "Lonestar/BFS_SSSP.h"
@@ -59,9 +60,10 @@ static cll::opt<unsigned int>
 
 enum Exec { SERIAL, PARALLEL };
 
-enum Algo { AsyncTile = 0, Async, SyncTile, Sync };
+enum Algo { AsyncTile = 0, Async, AsyncMQTile, AsyncMQ, SyncTile, Sync };
 
-const char* const ALGO_NAMES[] = {"AsyncTile", "Async", "SyncTile", "Sync"};
+const char* const ALGO_NAMES[] = {"AsyncTile", "Async",    "AsyncMQTile",
+                                  "AsyncMQ",   "SyncTile", "Sync"};
 
 static cll::opt<Exec> execution(
     "exec",
@@ -72,39 +74,47 @@ static cll::opt<Exec> execution(
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value SyncTile):"),
     cll::values(clEnumVal(AsyncTile, "AsyncTile"), clEnumVal(Async, "Async"),
+                clEnumVal(AsyncMQTile, "AsyncMQTile"),
+                clEnumVal(AsyncMQ, "AsyncMQ: Async ordered by level with a "
+                                   "MultiQueue"),
                 clEnumVal(SyncTile, "SyncTile"), clEnumVal(Sync, "Sync")),
     cll::init(SyncTile));
 
+static cll::opt<bool> compressed(
+    "compressed",
+    cll::desc("Store neighbor lists gap-encoded to reduce memory traffic "
+              "(default value false)"),
+    cll::init(false));
+
 using Graph =
     galois::graphs::LC_CSR_Graph<unsigned, void>::with_no_lockable<true>::type;
 //::with_numa_alloc<true>::type;
+using CompressedGraph = galois::graphs::LC_Compressed_CSR_Graph<
+    unsigned, void>::with_no_lockable<true>::type;
 
+// both graph types number nodes with uint32_t
 using GNode = Graph::GraphNode;
 
 constexpr static const bool TRACK_WORK          = false;
 constexpr static const unsigned CHUNK_SIZE      = 256U;
 constexpr static const ptrdiff_t EDGE_TILE_SIZE = 256;
 
+template <typename Graph>
 using BFS = BFS_SSSP<Graph, unsigned int, false, EDGE_TILE_SIZE>;
 
-using UpdateRequest       = BFS::UpdateRequest;
-using Dist                = BFS::Dist;
-using SrcEdgeTile         = BFS::SrcEdgeTile;
-using SrcEdgeTileMaker    = BFS::SrcEdgeTileMaker;
-using SrcEdgeTilePushWrap = BFS::SrcEdgeTilePushWrap;
-using ReqPushWrap         = BFS::ReqPushWrap;
-using OutEdgeRangeFn      = BFS::OutEdgeRangeFn;
-using TileRangeFn         = BFS::TileRangeFn;
+using Dist = BFS<Graph>::Dist;
 
+template <typename Graph>
 struct EdgeTile {
-  Graph::edge_iterator beg;
-  Graph::edge_iterator end;
+  typename Graph::edge_iterator beg;
+  typename Graph::edge_iterator end;
 };
 
+template <typename Graph>
 struct EdgeTileMaker {
-  EdgeTile operator()(Graph::edge_iterator beg,
-                      Graph::edge_iterator end) const {
-    return EdgeTile{beg, end};
+  EdgeTile<Graph> operator()(typename Graph::edge_iterator beg,
+                             typename Graph::edge_iterator end) const {
+    return EdgeTile<Graph>{beg, end};
   }
 };
 
@@ -121,20 +131,22 @@ struct NodePushWrap {
   }
 };
 
+template <typename Graph>
 struct EdgeTilePushWrap {
   Graph& graph;
 
   template <typename C>
   void operator()(C& cont, const GNode& n, const char* const) const {
-    BFS::pushEdgeTilesParallel(cont, graph, n, EdgeTileMaker{});
+    BFS<Graph>::pushEdgeTilesParallel(cont, graph, n, EdgeTileMaker<Graph>{});
   }
 
   template <typename C>
   void operator()(C& cont, const GNode& n) const {
-    BFS::pushEdgeTiles(cont, graph, n, EdgeTileMaker{});
+    BFS<Graph>::pushEdgeTiles(cont, graph, n, EdgeTileMaker<Graph>{});
   }
 };
 
+template <typename Graph>
 struct OneTilePushWrap {
   Graph& graph;
 
@@ -145,22 +157,24 @@ struct OneTilePushWrap {
 
   template <typename C>
   void operator()(C& cont, const GNode& n) const {
-    EdgeTile t{graph.edge_begin(n, galois::MethodFlag::UNPROTECTED),
-               graph.edge_end(n, galois::MethodFlag::UNPROTECTED)};
+    EdgeTile<Graph> t{graph.edge_begin(n, galois::MethodFlag::UNPROTECTED),
+                      graph.edge_end(n, galois::MethodFlag::UNPROTECTED)};
 
     cont.push(t);
   }
 };
 
-template <bool CONCURRENT, typename T, typename P, typename R>
+namespace gwl = galois::worklists;
+using FIFO    = gwl::PerSocketChunkFIFO<CHUNK_SIZE>;
+// the indexer reads only the distance of an item, whatever the graph type
+using MQ      = gwl::MultiQueue<BFS<Graph>::UpdateRequestIndexer>;
+
+template <bool CONCURRENT, typename T, typename WL = FIFO, typename Graph,
+          typename P, typename R>
 void asyncAlgo(Graph& graph, GNode source, const P& pushWrap,
                const R& edgeRange) {
 
-  namespace gwl = galois::worklists;
-  // typedef PerSocketChunkFIFO<CHUNK_SIZE> dFIFO;
-  using FIFO = gwl::PerSocketChunkFIFO<CHUNK_SIZE>;
   using BSWL = gwl::BulkSynchronous<gwl::PerSocketChunkLIFO<CHUNK_SIZE>>;
-  using WL   = FIFO;
 
   using Loop =
       typename std::conditional<CONCURRENT, galois::ForEach,
@@ -220,7 +234,7 @@ void asyncAlgo(Graph& graph, GNode source, const P& pushWrap,
               }
 
               if (TRACK_WORK) {
-                if (oldDist != BFS::DIST_INFINITY) {
+                if (oldDist != BFS<Graph>::DIST_INFINITY) {
                   BadWork += 1;
                 }
               }
@@ -241,7 +255,8 @@ void asyncAlgo(Graph& graph, GNode source, const P& pushWrap,
   }
 }
 
-template <bool CONCURRENT, typename T, typename P, typename R>
+template <bool CONCURRENT, typename T, typename Graph, typename P,
+          typename R>
 void syncAlgo(Graph& graph, GNode source, const P& pushWrap,
               const R& edgeRange) {
 
@@ -281,7 +296,7 @@ void syncAlgo(Graph& graph, GNode source, const P& pushWrap,
             auto dst      = graph.getEdgeDst(e);
             auto& dstData = graph.getData(dst, flag);
 
-            if (dstData == BFS::DIST_INFINITY) {
+            if (dstData == BFS<Graph>::DIST_INFINITY) {
               dstData = nextLevel;
               pushWrap(*next, dst);
             }
@@ -292,8 +307,14 @@ void syncAlgo(Graph& graph, GNode source, const P& pushWrap,
   }
 }
 
-template <bool CONCURRENT>
+template <bool CONCURRENT, typename Graph>
 void runAlgo(Graph& graph, const GNode& source) {
+  using UpdateRequest       = typename BFS<Graph>::UpdateRequest;
+  using SrcEdgeTile         = typename BFS<Graph>::SrcEdgeTile;
+  using SrcEdgeTilePushWrap = typename BFS<Graph>::SrcEdgeTilePushWrap;
+  using ReqPushWrap         = typename BFS<Graph>::ReqPushWrap;
+  using OutEdgeRangeFn      = typename BFS<Graph>::OutEdgeRangeFn;
+  using TileRangeFn         = typename BFS<Graph>::TileRangeFn;
 
   switch (algo) {
   case AsyncTile:
@@ -304,9 +325,17 @@ void runAlgo(Graph& graph, const GNode& source) {
     asyncAlgo<CONCURRENT, UpdateRequest>(graph, source, ReqPushWrap(),
                                          OutEdgeRangeFn{graph});
     break;
+  case AsyncMQTile:
+    asyncAlgo<CONCURRENT, SrcEdgeTile, MQ>(
+        graph, source, SrcEdgeTilePushWrap{graph}, TileRangeFn());
+    break;
+  case AsyncMQ:
+    asyncAlgo<CONCURRENT, UpdateRequest, MQ>(graph, source, ReqPushWrap(),
+                                             OutEdgeRangeFn{graph});
+    break;
   case SyncTile:
-    syncAlgo<CONCURRENT, EdgeTile>(graph, source, EdgeTilePushWrap{graph},
-                                   TileRangeFn());
+    syncAlgo<CONCURRENT, EdgeTile<Graph>>(
+        graph, source, EdgeTilePushWrap<Graph>{graph}, TileRangeFn());
     break;
   case Sync:
     syncAlgo<CONCURRENT, GNode>(graph, source, NodePushWrap(),
@@ -317,13 +346,8 @@ void runAlgo(Graph& graph, const GNode& source) {
   }
 }
 
-int main(int argc, char** argv) {
-  galois::SharedMemSys G;
-  LonestarStart(argc, argv, name, desc, url, &inputFile);
-
-  galois::StatTimer totalTime("TimerTotal");
-  totalTime.start();
-
+template <typename Graph>
+void run() {
   Graph graph;
   GNode source;
   GNode report;
@@ -352,8 +376,9 @@ int main(int argc, char** argv) {
 
   galois::reportPageAlloc("MeminfoPre");
 
-  galois::do_all(galois::iterate(graph),
-                 [&graph](GNode n) { graph.getData(n) = BFS::DIST_INFINITY; });
+  galois::do_all(galois::iterate(graph), [&graph](GNode n) {
+    graph.getData(n) = BFS<Graph>::DIST_INFINITY;
+  });
   graph.getData(source) = 0;
 
   std::cout << "Running " << ALGO_NAMES[algo] << " algorithm with "
@@ -390,7 +415,7 @@ int main(int argc, char** argv) {
       [&](uint64_t i) {
         uint32_t myDistance = graph.getData(i);
 
-        if (myDistance != BFS::DIST_INFINITY) {
+        if (myDistance != BFS<Graph>::DIST_INFINITY) {
           maxDistance.update(myDistance);
           distanceSum += myDistance;
           visitedNode += 1;
@@ -407,12 +432,26 @@ int main(int argc, char** argv) {
   galois::gInfo("Sum of visited distances is ", rDistanceSum);
 
   if (!skipVerify) {
-    if (BFS::verify(graph, source)) {
+    if (BFS<Graph>::verify(graph, source)) {
       std::cout << "Verification successful.\n";
     } else {
       GALOIS_DIE("verification failed");
     }
   }
+}
+
+int main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  galois::StatTimer totalTime("TimerTotal");
+  totalTime.start();
+
+  if (compressed) {
+    run<CompressedGraph>();
+  } else {
+    run<Graph>();
+  }
 
   totalTime.stop();
 
@@ -20,9 +20,11 @@
 #include "galois/Galois.h"
 #include "galois/AtomicHelpers.h"
 #include "galois/DynamicBitset.h"
+#include "galois/Frontier.h"
 #include "galois/gstl.h"
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
+#include "galois/graphs/GatherPrefetch.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/TypeTraits.h"
 #include "galois/graphs/LC_CSR_CSC_Graph.h"
@@ -87,11 +89,17 @@ static cll::opt<unsigned int>
                        "verification if verification is on (default value 10)"),
              cll::init(10));
 
+static cll::opt<unsigned int> prefetchDistance(
+    "prefetchDistance",
+    cll::desc("In-edges ahead to prefetch frontier bits in the pull phase; "
+              "0 disables prefetching (default value 16)"),
+    cll::init(16));
+
 enum Exec { SERIAL, PARALLEL };
 
-enum Algo { SyncDO = 0, Async, AutoAlgo };
+enum Algo { SyncDO = 0, Async, SyncFrontier, AutoAlgo };
 
-const char* const ALGO_NAMES[] = {"SyncDO", "Async", "Auto"};
+const char* const ALGO_NAMES[] = {"SyncDO", "Async", "SyncFrontier", "Auto"};
 
 static cll::opt<Exec> execution(
     "exec",
@@ -103,6 +111,8 @@ static cll::opt<Algo>
     algo("algo", cll::desc("Choose an algorithm (default value Auto):"),
          cll::values(
              clEnumVal(SyncDO, "SyncDO"), clEnumVal(Async, "Async"),
+             clEnumVal(SyncFrontier,
+                       "SyncFrontier: direction-optimizing galois::Frontier"),
              clEnumVal(AutoAlgo,
                        "Auto: choose between SyncDO and Async automatically")),
          cll::init(AutoAlgo));
@@ -215,6 +225,8 @@ void syncDOAlgo(Graph& graph, GNode source, const P& pushWrap,
 
   Loop loop;
 
+  galois::graphs::GatherPrefetch<Graph> gather(graph, prefetchDistance);
+
   galois::DynamicBitSet front_bitset, next_bitset;
   front_bitset.resize(graph.size());
   next_bitset.resize(graph.size());
@@ -273,21 +285,25 @@ void syncDOAlgo(Graph& graph, GNode source, const P& pushWrap,
             [&](const T& dst) {
               auto& ddata = graph.getData(dst, flag);
               if (ddata == BFS::DIST_INFINITY) {
-                for (auto e : graph.in_edges(dst)) {
-                  auto src = graph.getInEdgeDst(e);
-
-                  if (front_bitset.test(src)) {
-                    /*
-                     * Currently assigning parents on the bfs path.
-                     * Assign nextLevel (uncomment below)
-                     */
-                    // ddata = nextLevel;
-                    ddata = src;
-                    next_bitset.set(dst);
-                    work_items += 1;
-                    break;
-                  }
-                }
+                gather.in_edges(
+                    dst,
+                    [&](GNode src) {
+                      return &front_bitset.get_vec()[src / 64];
+                    },
+                    [&](GNode src) {
+                      if (front_bitset.test(src)) {
+                        /*
+                         * Currently assigning parents on the bfs path.
+                         * Assign nextLevel (uncomment below)
+                         */
+                        // ddata = nextLevel;
+                        ddata = src;
+                        next_bitset.set(dst);
+                        work_items += 1;
+                        return false;
+                      }
+                      return true;
+                    });
               }
             },
             galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
@@ -389,6 +405,28 @@ void asyncAlgo(Graph& graph, GNode source, const P& pushWrap,
       galois::disable_conflict_detection());
 }
 
+void syncFrontierAlgo(Graph& graph, GNode source) {
+  constexpr galois::MethodFlag flag = galois::MethodFlag::UNPROTECTED;
+  graph.getData(source, flag)       = 0u;
+
+  galois::Frontier curr(graph.size()), next(graph.size());
+  curr.add(source);
+
+  while (!curr.empty()) {
+    galois::edgeMap(
+        graph, curr, next,
+        [&](GNode src, GNode dst) {
+          // assigns parents on the bfs path like syncDOAlgo
+          return __sync_bool_compare_and_swap(&graph.getData(dst, flag),
+                                              BFS::DIST_INFINITY, src);
+        },
+        [&](GNode dst) {
+          return graph.getData(dst, flag) == BFS::DIST_INFINITY;
+        });
+    curr.swap(next);
+  }
+}
+
 template <bool CONCURRENT>
 void runAlgo(Graph& graph, const GNode& source, const uint32_t runID) {
   switch (algo) {
@@ -400,6 +438,9 @@ void runAlgo(Graph& graph, const GNode& source, const uint32_t runID) {
     asyncAlgo<CONCURRENT, GNode>(graph, source, NodePushWrap(),
                                  OutEdgeRangeFn{graph});
     break;
+  case SyncFrontier:
+    syncFrontierAlgo(graph, source);
+    break;
 
   default:
     std::cerr << "ERROR: unkown algo type\n";
@@ -1180,6 +1180,7 @@ void run() {
 
   algo.readGraph(graph);
   std::cout << "Read " << graph.size() << " nodes\n";
+  LonestarReorder(graph);
 
   initialize(graph);
 
@@ -21,6 +21,7 @@
 #define LONESTAR_PAGERANK_CONSTANTS_H
 
 #include <iostream>
+#include <vector>
 
 #define DEBUG 0
 
@@ -75,8 +76,10 @@ PRTy atomicAdd(std::atomic<PRTy>& v, PRTy delta) {
   return old;
 }
 
+//! originalIds maps node ids of a reordered graph back to input ids
 template <typename Graph>
-void printTop(Graph& graph, unsigned topn = PRINT_TOP) {
+void printTop(Graph& graph, const std::vector<uint32_t>& originalIds = {},
+              unsigned topn = PRINT_TOP) {
 
   using GNode = typename Graph::GraphNode;
   typedef TopPair<GNode> Pair;
@@ -88,7 +91,7 @@ void printTop(Graph& graph, unsigned topn = PRINT_TOP) {
     GNode src  = *ii;
     auto& n    = graph.getData(src);
     PRTy value = n.value;
-    Pair key(value, src);
+    Pair key(value, originalIds.empty() ? src : originalIds[src]);
 
     if (top.size() < topn) {
       top.insert(std::make_pair(key, src));
@@ -22,6 +22,7 @@
 #include "galois/Galois.h"
 #include "galois/LargeArray.h"
 #include "galois/Timer.h"
+#include "galois/graphs/GatherPrefetch.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/TypeTraits.h"
 #include "galois/gstl.h"
@@ -43,6 +44,12 @@ static cll::opt<bool>
                     cll::desc("Specify that the input graph is transposed"),
                     cll::init(false));
 
+static cll::opt<unsigned> prefetchDistance(
+    "prefetchDistance",
+    cll::desc("Edges ahead to prefetch neighbor data in the pull loops; "
+              "0 disables prefetching (default value 16)"),
+    cll::init(16));
+
 constexpr static const unsigned CHUNK_SIZE = 32;
 
 struct LNode {
@@ -133,6 +140,7 @@ void computePRResidual(Graph& graph, DeltaArray& delta,
                        ResidualArray& residual) {
   unsigned int iterations = 0;
   galois::GAccumulator<unsigned int> accum;
+  galois::graphs::GatherPrefetch<Graph> gather(graph, prefetchDistance);
 
   while (true) {
     galois::do_all(
@@ -159,12 +167,13 @@ void computePRResidual(Graph& graph, DeltaArray& delta,
         galois::iterate(graph),
         [&](const GNode& src) {
           float sum = 0;
-          for (auto nbr : graph.edges(src)) {
-            GNode dst = graph.getEdgeDst(nbr);
-            if (delta[dst] > 0) {
-              sum += delta[dst];
-            }
-          }
+          gather.edges(
+              src, [&](GNode dst) { return &delta[dst]; },
+              [&](GNode dst) {
+                if (delta[dst] > 0) {
+                  sum += delta[dst];
+                }
+              });
           if (sum > 0) {
             residual[src] = sum;
           }
@@ -198,6 +207,7 @@ void computePRTopological(Graph& graph) {
   galois::GAccumulator<float> accum;
 
   float base_score = (1.0f - ALPHA) / graph.size();
+  galois::graphs::GatherPrefetch<Graph> gather(graph, prefetchDistance);
   while (true) {
     galois::do_all(
         galois::iterate(graph),
@@ -208,14 +218,12 @@ void computePRTopological(Graph& graph) {
           LNode& sdata = graph.getData(src, flag);
           float sum    = 0.0;
 
-          for (auto jj = graph.edge_begin(src, flag),
-                    ej = graph.edge_end(src, flag);
-               jj != ej; ++jj) {
-            GNode dst = graph.getEdgeDst(jj);
-
-            LNode& ddata = graph.getData(dst, flag);
-            sum += ddata.value / ddata.nout;
-          }
+          gather.edges(
+              src, [&](GNode dst) { return &graph.getData(dst, flag); },
+              [&](GNode dst) {
+                LNode& ddata = graph.getData(dst, flag);
+                sum += ddata.value / ddata.nout;
+              });
 
           //! New value of pagerank after computing contributions from
           //! incoming edges in the original graph.
@@ -298,6 +306,13 @@ int main(int argc, char** argv) {
   std::cout << "Read " << transposeGraph.size() << " nodes, "
             << transposeGraph.sizeEdges() << " edges\n";
 
+  // relabeling the transpose relabels the graph it represents
+  std::vector<uint32_t> oldToNew = LonestarReorder(transposeGraph);
+  std::vector<uint32_t> originalIds(oldToNew.size());
+  for (size_t n = 0; n < oldToNew.size(); ++n) {
+    originalIds[oldToNew[n]] = n;
+  }
+
   galois::preAlloc(2 * numThreads + (3 * transposeGraph.size() *
                                      sizeof(typename Graph::node_data_type)) /
                                         galois::runtime::pagePoolSize());
@@ -349,7 +364,7 @@ int main(int argc, char** argv) {
   galois::gInfo("Sum is ", rSum);
 
   if (!skipVerify) {
-    printTop(transposeGraph);
+    printTop(transposeGraph, originalIds);
   }
 
 #if DEBUG
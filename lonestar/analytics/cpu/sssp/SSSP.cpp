@@ -65,13 +65,15 @@ enum Algo {
   dijkstra,
   topo,
   topoTile,
+  multiQueueTile,
+  multiQueue,
   AutoAlgo
 };
 
 const char* const ALGO_NAMES[] = {
-    "deltaTile", "deltaStep",    "deltaStepBarrier", "serDeltaTile",
-    "serDelta",  "dijkstraTile", "dijkstra",         "topo",
-    "topoTile",  "Auto"};
+    "deltaTile", "deltaStep",      "deltaStepBarrier", "serDeltaTile",
+    "serDelta",  "dijkstraTile",   "dijkstra",         "topo",
+    "topoTile",  "multiQueueTile", "multiQueue",       "Auto"};
 
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value auto):"),
@@ -83,6 +85,9 @@ static cll::opt<Algo> algo(
                 clEnumVal(dijkstraTile, "dijkstraTile"),
                 clEnumVal(dijkstra, "dijkstra"), clEnumVal(topo, "topo"),
                 clEnumVal(topoTile, "topoTile"),
+                clEnumVal(multiQueueTile, "multiQueueTile"),
+                clEnumVal(multiQueue, "multiQueue: relaxed priority queue "
+                                      "without a delta parameter"),
                 clEnumVal(AutoAlgo,
                           "auto: choose among the algorithms automatically")),
     cll::init(AutoAlgo));
@@ -114,10 +119,11 @@ using OBIM    = gwl::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
 using OBIM_Barrier =
     gwl::OrderedByIntegerMetric<UpdateRequestIndexer,
                                 PSchunk>::with_barrier<true>::type;
+using MQ = gwl::MultiQueue<UpdateRequestIndexer>;
 
 template <typename T, typename OBIMTy = OBIM, typename P, typename R>
 void deltaStepAlgo(Graph& graph, GNode source, const P& pushWrap,
-                   const R& edgeRange) {
+                   const R& edgeRange, unsigned shift = stepShift) {
 
   //! [reducible for self-defined stats]
   galois::GAccumulator<size_t> BadWork;
@@ -160,7 +166,7 @@ void deltaStepAlgo(Graph& graph, GNode source, const P& pushWrap,
           }
         }
       },
-      galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift}),
+      galois::wl<OBIMTy>(UpdateRequestIndexer{shift}),
       galois::disable_conflict_detection(), galois::loopname("SSSP"));
 
   if (TRACK_WORK) {
@@ -455,6 +461,16 @@ int main(int argc, char** argv) {
                                                OutEdgeRangeFn{graph});
     break;
 
+  case multiQueueTile:
+    // priorities are exact distances, so there is no delta to tune
+    deltaStepAlgo<SrcEdgeTile, MQ>(graph, source, SrcEdgeTilePushWrap{graph},
+                                   TileRangeFn(), 0);
+    break;
+  case multiQueue:
+    deltaStepAlgo<UpdateRequest, MQ>(graph, source, ReqPushWrap(),
+                                     OutEdgeRangeFn{graph}, 0);
+    break;
+
   default:
     std::abort();
   }
@@ -21,9 +21,11 @@
 #include "galois/Bag.h"
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
+#include "galois/SetIntersection.h"
 #include "galois/Timer.h"
 #include "galois/graphs/LCGraph.h"
 #include "galois/graphs/BufferedGraph.h"
+#include "galois/graphs/GraphCache.h"
 #include "galois/runtime/Profile.h"
 #include "llvm/Support/CommandLine.h"
 #include "Lonestar/Utils.h"
@@ -61,6 +63,12 @@ static cll::opt<bool>
                       "choose automatically)"),
             cll::init(false));
 
+static cll::opt<bool>
+    graphCache("graphCache",
+               cll::desc("Cache the relabeled/sorted graph next to the input "
+                         "and reuse it in later runs (default false)"),
+               cll::init(false));
+
 typedef galois::graphs::LC_CSR_Graph<void, void>::with_numa_alloc<
     true>::type ::with_no_lockable<true>::type Graph;
 
@@ -95,27 +103,15 @@ Iterator lowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Number of common destinations of two sorted edge ranges. Assumes the graph
+ * has no duplicate edges.
  */
 template <typename G>
 size_t countEqual(G& g, typename G::edge_iterator aa,
                   typename G::edge_iterator ea, typename G::edge_iterator bb,
                   typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::GraphNode a = g.getEdgeDst(aa);
-    typename G::GraphNode b = g.getEdgeDst(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+  return galois::intersectCount(g.getEdgeDstPtr(aa), std::distance(aa, ea),
+                                g.getEdgeDstPtr(bb), std::distance(bb, eb));
 }
 
 template <typename G>
@@ -475,7 +471,24 @@ void readGraph(Graph& graph) {
     relabel = isApproximateDegreeDistributionPowerLaw(degreeGraph);
     autoAlgoTimer.stop();
   }
-  if (relabel) {
+  if (graphCache) {
+    using galois::graphs::GraphTransform;
+    std::vector<GraphTransform> pipeline;
+    if (relabel) {
+      pipeline.push_back(GraphTransform::DEGREE_RELABEL);
+    }
+    // algorithm correctness requires sorting edges by destination
+    pipeline.push_back(GraphTransform::SORT_BY_DST);
+
+    galois::StatTimer Trelabel("GraphRelabelTimer");
+    Trelabel.start();
+    galois::graphs::FileGraph cached;
+    if (galois::graphs::readCachedGraph<void>(cached, inputFile, pipeline)) {
+      galois::gInfo("Using cached preprocessed graph");
+    }
+    galois::graphs::readGraph(graph, cached);
+    Trelabel.stop();
+  } else if (relabel) {
     galois::gInfo("Relabeling and sorting graph...");
     makeSortedGraph(graph);
   } else {
@@ -245,8 +245,12 @@ struct PageRank {
 
   PageRank(Graph* _graph) : graph(_graph) {}
 
-  void static go(Graph& _graph) {
-    unsigned _num_iterations   = 0;
+  /**
+   * @param startRound Round to start from; non-zero when resuming from a
+   * checkpoint
+   */
+  void static go(Graph& _graph, unsigned startRound = 0) {
+    unsigned _num_iterations   = startRound;
     const auto& nodesWithEdges = _graph.allNodesWithEdgesRange();
     DGTerminatorDetector dga;
 
@@ -286,6 +290,10 @@ struct PageRank {
           (unsigned long)_graph.sizeEdges());
 
       ++_num_iterations;
+      // hosts are only in the same round under BSP
+      if (!async) {
+        checkpointRound(syncSubstrate, _num_iterations);
+      }
     } while ((async || (_num_iterations < maxIterations)) &&
              dga.reduce(syncSubstrate->get_run_identifier()));
 
@@ -510,9 +518,17 @@ int main(int argc, char** argv) {
   bitset_residual.resize(hg->size());
   bitset_nout.resize(hg->size());
 
-  galois::gPrint("[", net.ID, "] InitializeGraph::go called\n");
+  if (execution == Async && (checkpointInterval || restartFromCheckpoint)) {
+    GALOIS_DIE("checkpointing requires -exec=Sync");
+  }
 
-  InitializeGraph::go(*hg);
+  // resuming from a checkpoint restores the node data InitializeGraph sets
+  unsigned startRound = 0;
+  if (!restoreCheckpoint(syncSubstrate, startRound)) {
+    galois::gPrint("[", net.ID, "] InitializeGraph::go called\n");
+
+    InitializeGraph::go(*hg);
+  }
   galois::runtime::getHostBarrier().wait();
 
   galois::DGAccumulator<float> DGA_sum;
@@ -532,9 +548,10 @@ int main(int argc, char** argv) {
     if (execution == Async) {
       PageRank<true>::go(*hg);
     } else {
-      PageRank<false>::go(*hg);
+      PageRank<false>::go(*hg, startRound);
     }
     StatTimer_main.stop();
+    startRound = 0;
 
     // sanity check
     PageRankSanity::go(*hg, DGA_sum, DGA_sum_residual,
@@ -120,6 +120,29 @@ template <typename NodeData, typename EdgeData>
 using DistGraphPtr =
     std::unique_ptr<galois::graphs::DistGraph<NodeData, EdgeData>>;
 
+/**
+ * Partitions the input graph with the given policy using the command line
+ * options, or reads this host's partition saved by an earlier run if
+ * -readFromFile is set.
+ *
+ * @tparam PartitionPolicy CuSP policy used to partition the graph; a saved
+ * partition must be read with the policy it was created with
+ * @param inputType Input format (CSR or CSC) to give the partitioner
+ * @param outputType Output format (CSR or CSC) of the partition
+ * @param symmetric true if the input is a symmetric graph
+ * @param masterBlockFile File specifying blocking of masters
+ */
+template <typename PartitionPolicy, typename NodeData, typename EdgeData>
+DistGraphPtr<NodeData, EdgeData>
+partitionGraph(galois::CUSP_GRAPH_TYPE inputType,
+               galois::CUSP_GRAPH_TYPE outputType, bool symmetric,
+               std::string masterBlockFile = "") {
+  return galois::cuspPartitionGraph<PartitionPolicy, NodeData, EdgeData>(
+      inputFile, inputType, outputType, symmetric, inputFileTranspose,
+      masterBlockFile, true, 100, galois::graphs::BALANCED_EDGES_OF_MASTERS,
+      0, 0, readFromFile, localGraphFileName);
+}
+
 /**
  * Loads a symmetric graph file (i.e. directed graph with edges in both
  * directions)
@@ -142,20 +165,17 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   switch (partitionScheme) {
   case OEC:
   case IEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true, inputFileTranspose,
-        mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true, mastersFile);
   case HOVC:
   case HIVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case CART_VCUT:
   case CART_VCUT_IEC:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
     // case CEC:
     //  return new Graph_customEdgeCut(inputFile, "", net.ID, net.Num,
@@ -163,20 +183,17 @@ constructSymmetricGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
 
   case GINGER_O:
   case GINGER_I:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case FENNEL_O:
   case FENNEL_I:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, true,
-        inputFileTranspose);
+    return partitionGraph<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, true);
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
     return DistGraphPtr<NodeData, EdgeData>(nullptr);
@@ -203,50 +220,43 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
   // 1 host = no concept of cut; just load from edgeCut, no transpose
   auto& net = galois::runtime::getSystemNetworkInterface();
   if (net.Num == 1) {
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose, mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose, mastersFile);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false, mastersFile);
     } else {
       GALOIS_DIE("incoming edge cut requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("incoming hybrid cut requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GenericCVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericCVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GenericCVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("cvc incoming cut requires transpose graph");
       break;
@@ -257,37 +267,32 @@ constructGraph(std::vector<unsigned>& GALOIS_UNUSED(scaleFactor)) {
     //                                 scaleFactor, vertexIDMapFileName, false);
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSR, false,
-          inputFileTranspose);
+      return partitionGraph<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSR, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSR, false,
-        inputFileTranspose);
+    return partitionGraph<SugarP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSR, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
@@ -317,96 +322,82 @@ DistGraphPtr<NodeData, EdgeData> constructGraph(std::vector<unsigned>&) {
   // 1 host = no concept of cut; just load from edgeCut
   if (net.Num == 1) {
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       fprintf(stderr, "WARNING: Loading transpose graph through in-memory "
                       "transpose to iterate over in-edges: pass in transpose "
                       "graph with -graphTranspose to avoid unnecessary "
                       "overhead.\n");
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSR, galois::CUSP_CSC, false);
     }
   }
 
   switch (partitionScheme) {
   case OEC:
-    return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose, mastersFile);
+    return partitionGraph<NoCommunication, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false, mastersFile);
   case IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<NoCommunication, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose, mastersFile);
+      return partitionGraph<NoCommunication, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false, mastersFile);
     } else {
       GALOIS_DIE("iec requires transpose graph");
       break;
     }
 
   case HOVC:
-    return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GenericHVC, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case HIVC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericHVC, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<GenericHVC, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("hivc requires transpose graph");
       break;
     }
 
   case CART_VCUT:
-    return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case CART_VCUT_IEC:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GenericCVCColumnFlip, NodeData,
-                                        EdgeData>(inputFile, galois::CUSP_CSC,
-                                                  galois::CUSP_CSC, false,
-                                                  inputFileTranspose);
+      return partitionGraph<GenericCVCColumnFlip, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("cvc requires transpose graph");
       break;
     }
 
   case GINGER_O:
-    return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<GingerP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case GINGER_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<GingerP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<GingerP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Ginger requires transpose graph");
       break;
     }
 
   case FENNEL_O:
-    return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<FennelP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
   case FENNEL_I:
     if (inputFileTranspose.size()) {
-      return galois::cuspPartitionGraph<FennelP, NodeData, EdgeData>(
-          inputFile, galois::CUSP_CSC, galois::CUSP_CSC, false,
-          inputFileTranspose);
+      return partitionGraph<FennelP, NodeData, EdgeData>(
+          galois::CUSP_CSC, galois::CUSP_CSC, false);
     } else {
       GALOIS_DIE("Fennel requires transpose graph");
       break;
     }
 
   case SUGAR_O:
-    return galois::cuspPartitionGraph<SugarColumnFlipP, NodeData, EdgeData>(
-        inputFile, galois::CUSP_CSR, galois::CUSP_CSC, false,
-        inputFileTranspose);
+    return partitionGraph<SugarColumnFlipP, NodeData, EdgeData>(
+        galois::CUSP_CSR, galois::CUSP_CSC, false);
 
   default:
     GALOIS_DIE("partition scheme specified is invalid: ", partitionScheme);
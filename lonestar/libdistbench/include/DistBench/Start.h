@@ -45,9 +45,19 @@ extern cll::opt<std::string> statFile;
 extern cll::opt<bool> partitionAgnostic;
 //! Set method for metadata sends
 extern cll::opt<DataCommMode> commMetadata;
+//! When to compress sync messages
+extern cll::opt<galois::runtime::SyncCompression> syncCompression;
+//! Network bandwidth assumed by the sync compression cost model
+extern cll::opt<double> syncBandwidth;
 //! Where to write output if output is set
 extern cll::opt<std::string> outputLocation;
 extern cll::opt<bool> output;
+//! Rounds between checkpoints; 0 disables checkpointing
+extern cll::opt<unsigned> checkpointInterval;
+//! Prefix of the checkpoint files
+extern cll::opt<std::string> checkpointFile;
+//! If set, resume from the newest checkpoint
+extern cll::opt<bool> restartFromCheckpoint;
 
 #ifdef GALOIS_ENABLE_GPU
 enum Personality { CPU, GPU_CUDA };
@@ -152,8 +162,9 @@ loadDistGraph(std::vector<unsigned>& scaleFactor) {
   dGraphTimer.stop();
 
   // Save local graph structure
-  // if (saveLocalGraph)
-  //  (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  if (saveLocalGraph && !readFromFile) {
+    (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  }
 
   return loadedGraph;
 }
@@ -194,8 +205,9 @@ loadSymmetricDistGraph(std::vector<unsigned>& scaleFactor) {
   dGraphTimer.stop();
 
   // Save local graph structure
-  // if (saveLocalGraph)
-  //  (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  if (saveLocalGraph && !readFromFile) {
+    (*loadedGraph).save_local_graph_to_file(localGraphFileName);
+  }
 
   return loadedGraph;
 }
@@ -238,6 +250,7 @@ distGraphInitialization() {
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
                                   commMetadata);
+  s->setSyncCompression(syncCompression, syncBandwidth);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
@@ -283,6 +296,7 @@ symmetricDistGraphInitialization() {
   s = std::make_unique<Substrate>(*g, net.ID, net.Num, g->isTransposed(),
                                   g->cartesianGrid(), partitionAgnostic,
                                   commMetadata);
+  s->setSyncCompression(syncCompression, syncBandwidth);
 
 // marshal graph to GPU as necessary
 #ifdef GALOIS_ENABLE_GPU
@@ -292,4 +306,54 @@ symmetricDistGraphInitialization() {
   return std::make_pair(std::move(g), std::move(s));
 }
 
+/**
+ * Checkpoints node data at the end of a round if checkpointing is enabled
+ * and the round is a multiple of the checkpoint interval. Call it from all
+ * hosts at the end of a BSP round.
+ *
+ * @param gluonSubstrate Gluon substrate of the graph to checkpoint
+ * @param round Number of rounds completed; a restart resumes from it
+ */
+template <typename NodeData, typename EdgeData>
+void checkpointRound(DistSubstratePtr<NodeData, EdgeData>& gluonSubstrate,
+                     uint32_t round) {
+  if (!checkpointInterval || round == 0 || round % checkpointInterval) {
+    return;
+  }
+#ifdef GALOIS_ENABLE_GPU
+  if (personality == GPU_CUDA) {
+    galois::gWarn("checkpointing node data on GPUs is not supported");
+    return;
+  }
+#endif
+  gluonSubstrate->checkpointSaveNodeData(round, checkpointFile);
+}
+
+/**
+ * Restores node data from the newest checkpoint if restarting from one.
+ * Must be called by all hosts.
+ *
+ * @param gluonSubstrate Gluon substrate of the graph to restore
+ * @param round Set to the round to resume from if a checkpoint is restored
+ * @returns true if node data was restored from a checkpoint
+ */
+template <typename NodeData, typename EdgeData>
+bool restoreCheckpoint(DistSubstratePtr<NodeData, EdgeData>& gluonSubstrate,
+                       uint32_t& round) {
+  if (!restartFromCheckpoint) {
+    return false;
+  }
+#ifdef GALOIS_ENABLE_GPU
+  if (personality == GPU_CUDA) {
+    galois::gWarn("checkpointing node data on GPUs is not supported");
+    return false;
+  }
+#endif
+  if (!gluonSubstrate->checkpointApplyNodeData(round, checkpointFile)) {
+    galois::gWarn("no checkpoint common to all hosts; starting from scratch");
+    return false;
+  }
+  return true;
+}
+
 #endif
@@ -62,15 +62,14 @@ cll::opt<PARTITIONING_SCHEME> partitionScheme(
 
 cll::opt<bool> readFromFile("readFromFile",
                             cll::desc("Set this flag if graph is to be "
-                                      "constructed from file (file must be "
-                                      "created by Abelian CSR)"),
+                                      "constructed from the files saved "
+                                      "by -saveLocalGraph"),
                             cll::init(false), cll::Hidden);
 
 cll::opt<std::string>
     localGraphFileName("localGraphFileName",
-                       cll::desc("Name of the local file to construct "
-                                 "local graph (file must be created by "
-                                 "Abelian CSR)"),
+                       cll::desc("Prefix of the local graph files to "
+                                 "save or read (default local_graph)"),
                        cll::init("local_graph"), cll::Hidden);
 
 cll::opt<bool> saveLocalGraph("saveLocalGraph",
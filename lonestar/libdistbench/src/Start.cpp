@@ -22,6 +22,7 @@
 #include "galois/runtime/Network.h"
 #include "galois/runtime/DistStats.h"
 #include "galois/runtime/DataCommMode.h"
+#include "galois/runtime/SyncCompression.h"
 
 #include <sstream>
 
@@ -34,7 +35,9 @@ cll::opt<int> numThreads("t", cll::desc("Number of threads (default 1)"),
 cll::opt<int> numRuns("runs", cll::desc("Number of runs (default 3)"),
                       cll::init(3));
 cll::opt<std::string>
-    statFile("statFile", cll::desc("Optional output file to print stats to"));
+    statFile("statFile",
+             cll::desc("Optional output file to print stats to; a .csv or "
+                       ".json extension selects structured output"));
 
 cll::opt<bool>
     partitionAgnostic("partitionAgnostic",
@@ -54,6 +57,23 @@ cll::opt<DataCommMode> commMetadata(
                            "non-updated values)")),
     cll::init(noData), cll::Hidden);
 
+cll::opt<galois::runtime::SyncCompression> syncCompression(
+    "syncCompression", cll::desc("Compression of synchronization messages"),
+    cll::values(clEnumValN(galois::runtime::noCompression, "off",
+                           "Do not compress (default)"),
+                clEnumValN(galois::runtime::autoCompression, "auto",
+                           "Compress when the cost model expects it to "
+                           "save time"),
+                clEnumValN(galois::runtime::alwaysCompression, "on",
+                           "Compress whenever it makes a message smaller")),
+    cll::init(galois::runtime::noCompression));
+
+cll::opt<double> syncBandwidth(
+    "syncBandwidth",
+    cll::desc("Network bandwidth of a host in MB/s assumed by "
+              "-syncCompression=auto (default 1250, i.e., 10 Gb/s)"),
+    cll::init(1250));
+
 cll::opt<std::string> outputLocation(
     "outputLocation",
     cll::desc("Location (directory) to write results to when output is true"));
@@ -61,6 +81,24 @@ cll::opt<std::string> outputLocation(
 cll::opt<bool> output("output", cll::desc("Write result (default false)"),
                       cll::init(false));
 
+cll::opt<unsigned> checkpointInterval(
+    "checkpointInterval",
+    cll::desc("Checkpoint node data every N rounds in benchmarks that "
+              "support it; also saves the local graph (default 0, off)"),
+    cll::init(0));
+
+cll::opt<std::string>
+    checkpointFile("checkpointFile",
+                   cll::desc("Prefix of the checkpoint files of each host "
+                             "(default checkpoint)"),
+                   cll::init("checkpoint"));
+
+cll::opt<bool> restartFromCheckpoint(
+    "restartFromCheckpoint",
+    cll::desc("Read the local graph saved by a checkpointing run instead of "
+              "partitioning and resume from its newest checkpoint"),
+    cll::init(false));
+
 #ifdef GALOIS_ENABLE_GPU
 std::string personality_str(Personality p) {
   switch (p) {
@@ -116,6 +154,23 @@ void DistBenchStart(int argc, char** argv, const char* app, const char* desc,
   numThreads = galois::setActiveThreads(numThreads);
   galois::runtime::setStatFile(statFile);
 
+#ifdef GALOIS_ENABLE_GPU
+  // GPUs read sync messages with their own code, which does not decompress
+  if (syncCompression != galois::runtime::noCompression &&
+      personality_set.find('g') != std::string::npos) {
+    galois::gWarn("sync compression is not supported with GPUs; disabling");
+    syncCompression = galois::runtime::noCompression;
+  }
+#endif
+
+  // a restart reads the partitions saved by the run that took the
+  // checkpoints instead of partitioning again
+  if (restartFromCheckpoint) {
+    readFromFile = true;
+  } else if (checkpointInterval) {
+    saveLocalGraph = true;
+  }
+
   auto& net = galois::runtime::getSystemNetworkInterface();
 
   if (net.ID == 0) {
@@ -22,6 +22,7 @@
 
 #include "galois/Galois.h"
 #include "galois/Version.h"
+#include "galois/graphs/Reordering.h"
 #include "llvm/Support/CommandLine.h"
 
 //! standard global options to the benchmarks
@@ -29,6 +30,25 @@ extern llvm::cl::opt<bool> skipVerify;
 extern llvm::cl::opt<int> numThreads;
 extern llvm::cl::opt<std::string> statFile;
 extern llvm::cl::opt<bool> symmetricGraph;
+extern llvm::cl::opt<galois::graphs::ReorderAlgo> reorderAlgo;
+
+/**
+ * Reorders the nodes of an LC_CSR_Graph as requested by -reorder. Call it
+ * before initializing node data, which is not moved.
+ *
+ * @returns mapping from old to new node ids, or an empty vector if the graph
+ * was left as is
+ */
+template <typename Graph>
+std::vector<uint32_t> LonestarReorder(Graph& graph) {
+  if (reorderAlgo == galois::graphs::ReorderAlgo::NONE) {
+    return {};
+  }
+  const char* name = galois::graphs::reorderAlgoName(reorderAlgo);
+  galois::runtime::reportParam("(NULL)", "Reorder", name);
+  galois::gInfo("Reordering graph with ", name);
+  return galois::graphs::reorderGraph(graph, reorderAlgo);
+}
 
 //! initialize lonestar benchmark
 void LonestarStart(int argc, char** argv, const char* app, const char* desc,
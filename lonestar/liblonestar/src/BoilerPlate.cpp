@@ -31,7 +31,8 @@ llvm::cl::opt<int>
                llvm::cl::init(1));
 llvm::cl::opt<std::string> statFile(
     "statFile",
-    llvm::cl::desc("ouput file to print stats to (default value empty)"),
+    llvm::cl::desc("ouput file to print stats to; a .csv or .json extension "
+                   "selects structured output (default value empty)"),
     llvm::cl::init(""));
 
 //! Flag that forces user to be aware that they should be passing in a
@@ -41,6 +42,26 @@ llvm::cl::opt<bool>
                    llvm::cl::desc("Specify that the input graph is symmetric"),
                    llvm::cl::init(false));
 
+//! In-memory node reordering applied by apps that call LonestarReorder
+llvm::cl::opt<galois::graphs::ReorderAlgo> reorderAlgo(
+    "reorder",
+    llvm::cl::desc("Reorder nodes after reading the graph, for apps that "
+                   "support it (default value none):"),
+    llvm::cl::values(
+        clEnumValN(galois::graphs::ReorderAlgo::NONE, "none",
+                   "keep the input order"),
+        clEnumValN(galois::graphs::ReorderAlgo::DEGREE_SORT, "degree",
+                   "decreasing degree"),
+        clEnumValN(galois::graphs::ReorderAlgo::HUB_SORT, "hubsort",
+                   "hubs by decreasing degree first"),
+        clEnumValN(galois::graphs::ReorderAlgo::HUB_CLUSTER, "hubcluster",
+                   "hubs first"),
+        clEnumValN(galois::graphs::ReorderAlgo::RCM, "rcm",
+                   "reverse Cuthill-McKee"),
+        clEnumValN(galois::graphs::ReorderAlgo::GORDER, "gorder",
+                   "windowed Gorder")),
+    llvm::cl::init(galois::graphs::ReorderAlgo::NONE));
+
 static void LonestarPrintVersion(llvm::raw_ostream& out) {
   out << "LoneStar Benchmark Suite v" << galois::getVersion() << " ("
       << galois::getRevision() << ")\n";
@@ -20,15 +20,29 @@
 #include "galois/Galois.h"
 #include "galois/LargeArray.h"
 #include "galois/graphs/FileGraph.h"
+#include "galois/graphs/LC_Compressed_CSR_Graph.h"
+#include "galois/graphs/ReadGraph.h"
+#include "galois/substrate/ThreadPool.h"
 
 #include <llvm/Support/CommandLine.h>
 
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <deque>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <cstdint>
 #include <vector>
 #include <random>
@@ -36,6 +50,9 @@
 
 #include <fcntl.h>
 #include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // TODO: move these enums to a common location for all graph convert tools
 enum ConvertMode {
@@ -78,6 +95,7 @@ enum ConvertMode {
   gr2trigr,
   gr2totem,
   gr2neo4j,
+  gr2zgr,
   mtx2gr,
   nodelist2gr,
   pbbs2gr,
@@ -176,6 +194,7 @@ static cll::opt<ConvertMode> convertMode(
                             "removing reverse edges"),
         clEnumVal(gr2totem, "Convert binary gr totem input format"),
         clEnumVal(gr2neo4j, "Convert binary gr to a vertex/edge csv for neo4j"),
+        clEnumVal(gr2zgr, "Convert binary gr to compressed binary gr (zgr)"),
         clEnumVal(mtx2gr, "Convert matrix market format to binary gr"),
         clEnumVal(nodelist2gr, "Convert node list to binary gr"),
         clEnumVal(pbbs2gr, "Convert pbbs graph to binary gr"),
@@ -200,6 +219,11 @@ static cll::opt<int>
              cll::init(1));
 static cll::opt<int> maxDegree("maxDegree", cll::desc("maximum degree to keep"),
                                cll::init(2 * 1024));
+static cll::opt<unsigned int>
+    numThreads("t",
+               cll::desc("Number of threads used to parse text inputs "
+                         "(default value 0 means all usable threads)"),
+               cll::init(0));
 
 struct Conversion {};
 struct HasOnlyVoidSpecialization {};
@@ -337,192 +361,384 @@ void skipLine(std::ifstream& infile) {
   infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
-/**
- * Common parsing for edgelist style text files.
- *
- * src dst [weight]
- * ...
- *
- * If delim is set, this function expects that each entry is separated by delim
- * surrounded by optional whitespace.
- */
+//! One line of an edge list
 template <typename EdgeTy>
-void convertEdgelist(const std::string& infilename,
-                     const std::string& outfilename, const bool skipFirstLine,
-                     std::optional<char> delim) {
-  typedef galois::graphs::FileGraphWriter Writer;
-
-  Writer p;
-  std::ifstream infile(infilename.c_str());
-
-  size_t numNodes   = 0;
-  size_t numEdges   = 0;
-  size_t lineNumber = 0;
+struct TextEdge {
+  uint64_t src;
+  uint64_t dst;
+  EdgeTy data;
+};
 
-  if (skipFirstLine) {
-    galois::gWarn(
-        "first line is assumed to contain labels and will be ignored\n");
-    skipLine(infile);
-    ++lineNumber;
-  }
+template <>
+struct TextEdge<void> {
+  uint64_t src;
+  uint64_t dst;
+};
 
-  const bool hasDelim = static_cast<bool>(delim);
+/**
+ * Edges parsed from a block of text that starts and ends at line boundaries.
+ * Blocks are kept in file order so that the output does not depend on the
+ * number of threads.
+ */
+template <typename EdgeTy>
+struct TextBlock {
+  std::vector<TextEdge<EdgeTy>> edges;
+  uint64_t maxNode = 0;
+  size_t numLines  = 0;
+  //! Line of the first line that did not parse, relative to the block
   std::optional<size_t> skippedLine;
-  std::string line;
-  char readDelim;
+  //! Start of each node range in edges after partitionByRange
+  std::vector<size_t> rangeStarts;
+};
 
-  for (; std::getline(infile, line); ++lineNumber) {
-    std::stringstream iss(line);
+static const char* skipBlanks(const char* p, const char* end) {
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' ||
+                      *p == '\f'))
+    ++p;
+  return p;
+}
 
-    size_t src;
-    if (!(iss >> src)) {
-      skippedLine = lineNumber;
-      continue;
-    }
+//! Parses a decimal integer after optional blanks like istream >> uint64_t
+static bool parseNode(const char*& p, const char* end, uint64_t& ret) {
+  p = skipBlanks(p, end);
+  if (p != end && *p == '+')
+    ++p;
+  if (p == end || *p < '0' || *p > '9')
+    return false;
+  uint64_t value = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+    uint64_t digit = *p - '0';
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+      return false;
+    value = value * 10 + digit;
+  }
+  ret = value;
+  return true;
+}
 
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        skippedLine = lineNumber;
-        continue;
-      }
-    }
+static bool parseDelim(const char*& p, const char* end,
+                       std::optional<char> delim) {
+  if (!delim)
+    return true;
+  p = skipBlanks(p, end);
+  return p != end && *p++ == *delim;
+}
 
-    size_t dst;
-    if (!(iss >> dst)) {
-      skippedLine = lineNumber;
-      continue;
-    }
+template <typename T>
+static bool parseValue(const char*& p, const char* end, T& ret) {
+  p = skipBlanks(p, end);
+  if (p != end && *p == '+')
+    ++p;
+  auto result = std::from_chars(p, end, ret);
+  p           = result.ptr;
+  return result.ec == std::errc();
+}
 
+/**
+ * Parses src [delim] dst [[delim] weight] from each line of [begin, end).
+ * Lines that do not match are counted as skipped like the stream based
+ * parser did; trailing text after the last field is ignored.
+ */
+template <typename EdgeTy>
+static void parseBlock(const char* begin, const char* end,
+                       std::optional<char> delim, TextBlock<EdgeTy>& block) {
+  for (const char* line = begin; line != end; ++block.numLines) {
+    const char* eol =
+        static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (!eol)
+      eol = end;
+    const char* p = line;
+    line          = eol == end ? end : eol + 1;
+
+    TextEdge<EdgeTy> edge;
+    bool ok = parseNode(p, eol, edge.src) && parseDelim(p, eol, delim) &&
+              parseNode(p, eol, edge.dst);
     if constexpr (!std::is_void<EdgeTy>::value) {
-      EdgeTy data{};
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
-          skippedLine = lineNumber;
-          continue;
-        }
-      }
-
-      if (!(iss >> data)) {
-        skippedLine = lineNumber;
-        continue;
-      }
+      ok = ok && parseDelim(p, eol, delim) && parseValue(p, eol, edge.data);
     }
-
-    if (infile) {
-      ++numEdges;
-      if (src > numNodes)
-        numNodes = src;
-      if (dst > numNodes)
-        numNodes = dst;
+    if (!ok) {
+      if (!block.skippedLine)
+        block.skippedLine = block.numLines;
+      continue;
     }
+    block.maxNode = std::max(block.maxNode, std::max(edge.src, edge.dst));
+    block.edges.push_back(edge);
   }
+}
 
-  if (skippedLine) {
-    galois::gWarn("ignored at least one line (line ", *skippedLine,
-                  ") because it did not match the expected format\n");
-  }
-
-  numNodes++;
-  p.setNumNodes(numNodes);
-  p.setNumEdges<EdgeTy>(numEdges);
-
-  infile.clear();
-  infile.seekg(0, std::ios::beg);
-  p.phase1();
-
-  if (skipFirstLine) {
-    skipLine(infile);
+/**
+ * Splits [begin, end) at line boundaries into about numBlocks pieces and
+ * parses them in parallel, appending the results to blocks.
+ */
+template <typename EdgeTy>
+static void parseText(const char* begin, const char* end,
+                      std::optional<char> delim,
+                      std::deque<TextBlock<EdgeTy>>& blocks) {
+  size_t numBlocks =
+      std::max<size_t>(1, std::min<size_t>(galois::getActiveThreads() * 8,
+                                           (end - begin) / (1 << 20) + 1));
+  std::vector<const char*> starts{begin};
+  for (size_t i = 1; i < numBlocks; ++i) {
+    const char* p =
+        std::max(starts.back(), begin + (end - begin) * i / numBlocks);
+    // a block starts right after a newline
+    if (p != begin && p[-1] != '\n') {
+      p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      p = p ? p + 1 : end;
+    }
+    starts.push_back(p);
   }
+  starts.push_back(end);
+
+  size_t first = blocks.size();
+  blocks.resize(first + numBlocks);
+  galois::do_all(
+      galois::iterate(size_t{0}, numBlocks),
+      [&](size_t i) {
+        parseBlock(starts[i], starts[i + 1], delim, blocks[first + i]);
+      },
+      galois::steal(), galois::chunk_size<1>(),
+      galois::loopname("ParseEdgelist"));
+}
 
-  while (std::getline(infile, line)) {
-    std::stringstream iss(line);
-
-    size_t src;
-    if (!(iss >> src)) {
-      continue;
-    }
-
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        continue;
-      }
-    }
-
-    size_t dst;
-    if (!(iss >> dst)) {
-      continue;
-    }
+/**
+ * Reads a text edge list with all threads. Plain files are mapped and split
+ * directly; gzip and zstd files are decompressed as a stream and parsed one
+ * batch of lines at a time, so they never have to be inflated on disk.
+ */
+template <typename EdgeTy>
+static std::deque<TextBlock<EdgeTy>>
+readEdgelistText(const std::string& infilename, const bool skipFirstLine,
+                 std::optional<char> delim) {
+  std::deque<TextBlock<EdgeTy>> blocks;
+
+  int fd = open(infilename.c_str(), O_RDONLY);
+  if (fd == -1)
+    GALOIS_SYS_DIE("failed opening ", "'", infilename, "'");
+  struct stat buf;
+  if (fstat(fd, &buf) == -1)
+    GALOIS_SYS_DIE("failed reading ", "'", infilename, "'");
+  size_t size = buf.st_size;
+
+  unsigned char magic[4] = {0, 0, 0, 0};
+  if (pread(fd, magic, sizeof(magic), 0) == -1)
+    GALOIS_SYS_DIE("failed reading ", "'", infilename, "'");
+  bool isGzip = magic[0] == 0x1f && magic[1] == 0x8b;
+  bool isZstd = magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f &&
+                magic[3] == 0xfd;
+
+  auto skipHeader = [&](const char* begin, const char* end) {
+    galois::gWarn(
+        "first line is assumed to contain labels and will be ignored\n");
+    const char* p =
+        static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    return p ? p + 1 : end;
+  };
 
-    if constexpr (!std::is_void<EdgeTy>::value) {
-      EdgeTy data{};
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
+  if (!isGzip && !isZstd) {
+    if (size > 0) {
+      void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (base == MAP_FAILED)
+        GALOIS_SYS_DIE("failed mapping ", "'", infilename, "'");
+      madvise(base, size, MADV_WILLNEED);
+      const char* begin = static_cast<const char*>(base);
+      const char* end   = begin + size;
+      if (skipFirstLine)
+        begin = skipHeader(begin, end);
+      parseText(begin, end, delim, blocks);
+      munmap(base, size);
+    }
+    close(fd);
+  } else {
+    close(fd);
+    std::ifstream infile(infilename, std::ios::binary);
+    boost::iostreams::filtering_istream in;
+    if (isGzip) {
+      in.push(boost::iostreams::gzip_decompressor());
+    } else {
+#if BOOST_VERSION >= 107000
+      in.push(boost::iostreams::zstd_decompressor());
+#else
+      GALOIS_DIE("zstd input needs Boost 1.70 or newer");
+#endif
+    }
+    in.push(infile);
+
+    const size_t batchSize = size_t{256} << 20;
+    std::vector<char> batch(batchSize);
+    size_t filled = 0;
+    bool first    = true;
+    while (true) {
+      in.read(batch.data() + filled, batch.size() - filled);
+      filled += in.gcount();
+      bool done = !in;
+      if (in.bad())
+        GALOIS_DIE("failed decompressing ", "'", infilename, "'");
+
+      // parse whole lines only; keep the partial last line for next batch
+      const char* begin = batch.data();
+      const char* end   = begin + filled;
+      if (!done) {
+        while (end != begin && end[-1] != '\n')
+          --end;
+        if (end == begin) {
+          batch.resize(batch.size() * 2);
           continue;
         }
       }
+      if (first && skipFirstLine)
+        begin = skipHeader(begin, end);
+      first = false;
+      parseText(begin, end, delim, blocks);
 
-      if (!(iss >> data)) {
-        continue;
-      }
-    }
-
-    if (infile) {
-      p.incrementDegree(src);
+      if (done)
+        break;
+      size_t rest = batch.data() + filled - end;
+      std::memmove(batch.data(), end, rest);
+      filled = rest;
     }
   }
 
-  infile.clear();
-  infile.seekg(0, std::ios::beg);
-  p.phase2();
+  return blocks;
+}
 
-  if (skipFirstLine) {
-    skipLine(infile);
+/**
+ * Line number (counting from zero and including a skipped header) of the first
+ * line that did not parse, for the warning of the old sequential parser.
+ */
+template <typename EdgeTy>
+static std::optional<size_t>
+firstSkippedLine(const std::deque<TextBlock<EdgeTy>>& blocks,
+                 const bool skipFirstLine) {
+  size_t lines = skipFirstLine ? 1 : 0;
+  for (auto& block : blocks) {
+    if (block.skippedLine)
+      return lines + *block.skippedLine;
+    lines += block.numLines;
   }
+  return std::nullopt;
+}
 
-  while (std::getline(infile, line)) {
-    std::stringstream iss(line);
-
-    size_t src;
-    if (!(iss >> src)) {
-      continue;
+/**
+ * Builds a gr from parsed blocks without another copy of the edge list: each
+ * block is stably partitioned into ranges of source nodes, and each range is
+ * then filled in by a single thread visiting the blocks in file order, which
+ * keeps the edges of a node in file order like the sequential writer did.
+ * A block's edges are freed once every range has added its neighbors, so the
+ * parsed edges shrink while the gr arrays are filled in.
+ */
+template <typename EdgeTy>
+static void writeEdgelistGraph(std::deque<TextBlock<EdgeTy>>& blocks,
+                               size_t numNodes, size_t numEdges,
+                               const std::string& outfilename) {
+  size_t numRanges =
+      std::min<size_t>(numNodes, galois::getActiveThreads() * 16);
+  size_t rangeSize = (numNodes + numRanges - 1) / numRanges;
+  numRanges        = (numNodes + rangeSize - 1) / rangeSize;
+
+  galois::do_all(
+      galois::iterate(blocks),
+      [&](TextBlock<EdgeTy>& block) {
+        auto& starts = block.rangeStarts;
+        starts.assign(numRanges + 1, 0);
+        for (auto& e : block.edges)
+          ++starts[e.src / rangeSize + 1];
+        std::partial_sum(starts.begin(), starts.end(), starts.begin());
+        std::vector<size_t> cursors(starts.begin(), starts.end() - 1);
+        std::vector<TextEdge<EdgeTy>> sorted(block.edges.size());
+        for (auto& e : block.edges)
+          sorted[cursors[e.src / rangeSize]++] = e;
+        block.edges.swap(sorted);
+      },
+      galois::steal(), galois::chunk_size<1>(),
+      galois::loopname("PartitionEdgelist"));
+
+  auto forEachEdgeInRange = [&](size_t range, auto fn) {
+    for (auto& block : blocks) {
+      for (size_t i = block.rangeStarts[range],
+                  ei = block.rangeStarts[range + 1];
+           i != ei; ++i)
+        fn(block.edges[i]);
     }
+  };
 
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        continue;
-      }
-    }
+  galois::graphs::FileGraphWriter p;
+  p.setNumNodes(numNodes);
+  p.setNumEdges<EdgeTy>(numEdges);
 
-    size_t dst;
-    if (!(iss >> dst)) {
-      continue;
-    }
+  p.phase1();
+  galois::do_all(
+      galois::iterate(size_t{0}, numRanges),
+      [&](size_t range) {
+        forEachEdgeInRange(range, [&](const TextEdge<EdgeTy>& e) {
+          p.incrementDegree(e.src);
+        });
+      },
+      galois::steal(), galois::chunk_size<1>(),
+      galois::loopname("CountDegrees"));
+
+  //! Ranges that still have to add the neighbors of each block
+  std::vector<std::atomic<size_t>> pendingRanges(blocks.size());
+  for (auto& pending : pendingRanges)
+    pending.store(numRanges, std::memory_order_relaxed);
 
-    if constexpr (!std::is_void<EdgeTy>::value) {
-      EdgeTy data{};
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
-          continue;
+  p.phase2();
+  galois::do_all(
+      galois::iterate(size_t{0}, numRanges),
+      [&](size_t range) {
+        for (size_t b = 0; b != blocks.size(); ++b) {
+          auto& block = blocks[b];
+          for (size_t i = block.rangeStarts[range],
+                      ei = block.rangeStarts[range + 1];
+               i != ei; ++i) {
+            auto& e = block.edges[i];
+            if constexpr (!std::is_void<EdgeTy>::value) {
+              p.addNeighbor<EdgeTy>(e.src, e.dst, e.data);
+            } else {
+              p.addNeighbor(e.src, e.dst);
+            }
+          }
+          if (pendingRanges[b].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            std::vector<TextEdge<EdgeTy>>().swap(block.edges);
         }
-      }
+      },
+      galois::steal(), galois::chunk_size<1>(),
+      galois::loopname("AddNeighbors"));
 
-      if (!(iss >> data)) {
-        continue;
-      }
+  p.finish();
+  p.toFile(outfilename);
+}
 
-      if (infile) {
-        p.addNeighbor<EdgeTy>(src, dst, data);
-      }
-    } else {
-      if (infile) {
-        p.addNeighbor(src, dst);
-      }
-    }
+/**
+ * Common parsing for edgelist style text files.
+ *
+ * src dst [weight]
+ * ...
+ *
+ * If delim is set, this function expects that each entry is separated by delim
+ * surrounded by optional whitespace. The input may be gzip or zstd compressed.
+ */
+template <typename EdgeTy>
+void convertEdgelist(const std::string& infilename,
+                     const std::string& outfilename, const bool skipFirstLine,
+                     std::optional<char> delim) {
+  auto blocks = readEdgelistText<EdgeTy>(infilename, skipFirstLine, delim);
+
+  size_t numNodes = 0;
+  size_t numEdges = 0;
+  for (auto& block : blocks) {
+    numEdges += block.edges.size();
+    if (!block.edges.empty())
+      numNodes = std::max<size_t>(numNodes, block.maxNode);
   }
 
-  p.finish();
+  if (auto skippedLine = firstSkippedLine(blocks, skipFirstLine)) {
+    galois::gWarn("ignored at least one line (line ", *skippedLine,
+                  ") because it did not match the expected format\n");
+  }
 
-  p.toFile(outfilename);
+  numNodes++;
+  writeEdgelistGraph(blocks, numNodes, numEdges, outfilename);
   printStatus(numNodes, numEdges);
 }
 
@@ -563,54 +779,32 @@ struct Edgelist2Gr : public Conversion {
 struct Edgelist2Binary : public Conversion {
   template <typename EdgeTy>
   void convert(const std::string& infilename, const std::string& outfilename) {
-    std::ifstream infile(infilename.c_str());
+    auto blocks =
+        readEdgelistText<void>(infilename, false, std::optional<char>());
     std::ofstream outfile(outfilename.c_str());
 
     size_t numNodes = 0;
     size_t numEdges = 0;
 
-    std::vector<uint32_t> buffer(10000);
-    uint32_t counter = 0;
+    std::vector<uint32_t> buffer;
     bool skippedLine = false;
-    while (infile) {
-      uint32_t src;
-      if (!(infile >> src)) {
-        skipLine(infile);
-        skippedLine = true;
-        continue;
-      }
-
-      uint32_t dst;
-      if (!(infile >> dst)) {
-        skipLine(infile);
-        skippedLine = true;
-        continue;
-      }
-
-      buffer[counter++] = src;
-      buffer[counter++] = dst;
-      if (counter == buffer.size()) {
-        // flush it to the output file.
-        outfile.write(reinterpret_cast<char*>(&buffer[0]),
-                      sizeof(uint32_t) * counter);
-        counter = 0;
-      }
-
-      if (infile) {
+    for (auto& block : blocks) {
+      skippedLine |= static_cast<bool>(block.skippedLine);
+      buffer.clear();
+      for (auto& e : block.edges) {
+        if (e.src > std::numeric_limits<uint32_t>::max() ||
+            e.dst > std::numeric_limits<uint32_t>::max()) {
+          skippedLine = true;
+          continue;
+        }
+        buffer.push_back(e.src);
+        buffer.push_back(e.dst);
         ++numEdges;
-        if (src > numNodes)
-          numNodes = src;
-        if (dst > numNodes)
-          numNodes = dst;
-      } else {
-        counter -= 2;
+        numNodes = std::max<size_t>(numNodes, std::max(e.src, e.dst));
       }
-    }
-
-    if (counter) {
       // flush it to the output file.
-      outfile.write(reinterpret_cast<char*>(&buffer[0]),
-                    sizeof(uint32_t) * counter);
+      outfile.write(reinterpret_cast<char*>(buffer.data()),
+                    sizeof(uint32_t) * buffer.size());
     }
 
     if (skippedLine) {
@@ -1991,6 +2185,27 @@ struct Cleanup : public Conversion {
   }
 };
 
+/**
+ * Compresses adjacency lists with gap encoding. Neighbors are sorted by
+ * destination in the output; see LC_Compressed_CSR_Graph for the format.
+ */
+struct Gr2Zgr : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    typedef typename galois::graphs::LC_Compressed_CSR_Graph<
+        void, EdgeTy>::template with_no_lockable<true>::type Graph;
+
+    Graph graph;
+    galois::graphs::readGraph(graph, infilename);
+    graph.writeGraphToZGRFile(outfilename);
+
+    size_t numEdges = std::max<size_t>(graph.sizeEdges(), 1);
+    std::cout << "Compressed edges: " << graph.sizeEdgeBytes() << " bytes ("
+              << (double)graph.sizeEdgeBytes() / numEdges << " bytes/edge)\n";
+    printStatus(graph.size(), graph.sizeEdges());
+  }
+};
+
 template <template <typename, typename> class SortBy, bool NeedsEdgeData>
 struct SortEdges
     : public boost::mpl::if_c<NeedsEdgeData, HasNoVoidSpecialization,
@@ -2890,6 +3105,9 @@ int main(int argc, char** argv) {
   galois::SharedMemSys G;
   llvm::cl::ParseCommandLineOptions(argc, argv);
   std::ios_base::sync_with_stdio(false);
+  galois::setActiveThreads(
+      numThreads ? numThreads
+                 : galois::substrate::getThreadPool().getMaxUsableThreads());
   switch (convertMode) {
   case bipartitegr2bigpetsc:
     convert<Bipartitegr2Petsc<double, false>>();
@@ -3008,6 +3226,9 @@ int main(int argc, char** argv) {
   case gr2neo4j:
     convert<Gr2Neo4j>();
     break;
+  case gr2zgr:
+    convert<Gr2Zgr>();
+    break;
   case mtx2gr:
     convert<Mtx2Gr>();
     break;